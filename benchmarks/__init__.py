@@ -0,0 +1,10 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+"""
+Reproducible benchmarks for the openm3u8 parser and model.
+
+Run ``python -m benchmarks.run --help`` from the repository root, or
+``python -m benchmarks.parallel_scaling`` for multi-threaded throughput.
+"""
@@ -0,0 +1,77 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+"""
+Compare two benchmark result files produced by ``benchmarks.run``.
+
+    python -m benchmarks.compare baseline.json candidate.json --threshold 10
+
+Prints the p50 latency and peak memory change for every measurement present
+in both files and exits with status 1 if any p50 latency regressed by more
+than ``--threshold`` percent.  Measurements whose generated input differs
+(different ``input_sha256``) are reported but never counted as regressions.
+"""
+
+import argparse
+import json
+import sys
+
+
+def _load(path):
+    with open(path) as fileobj:
+        report = json.load(fileobj)
+    return {
+        (r["workload"], r["operation"], r["backend"], r["scale"]): r
+        for r in report["results"]
+    }
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=10.0,
+        help="p50 regression, in percent, that fails the comparison",
+    )
+    args = parser.parse_args(argv)
+
+    baseline = _load(args.baseline)
+    candidate = _load(args.candidate)
+
+    regressions = 0
+    print(
+        f"{'backend':<7} {'workload':<18} {'operation':<9} "
+        f"{'p50 base':>10} {'p50 new':>10} {'change':>8} {'peak change':>12}"
+    )
+    for key in sorted(baseline.keys() & candidate.keys()):
+        old, new = baseline[key], candidate[key]
+        workload, operation, backend, _ = key
+        old_p50 = old["latency_ms"]["p50"]
+        new_p50 = new["latency_ms"]["p50"]
+        change = (new_p50 - old_p50) / old_p50 * 100
+        old_peak = old["peak_memory_bytes"] or 1
+        peak_change = (new["peak_memory_bytes"] - old_peak) / old_peak * 100
+        note = ""
+        if old["input_sha256"] != new["input_sha256"]:
+            note = "  (input differs)"
+        elif change > args.threshold:
+            note = "  REGRESSION"
+            regressions += 1
+        print(
+            f"{backend:<7} {workload:<18} {operation:<9} "
+            f"{old_p50:>9.2f}ms {new_p50:>9.2f}ms {change:>+7.1f}% "
+            f"{peak_change:>+11.1f}%{note}"
+        )
+
+    for key in sorted(baseline.keys() ^ candidate.keys()):
+        print("only in one file: " + " ".join(str(part) for part in key))
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,245 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+"""
+Deterministic synthetic playlist generators.
+
+Every generator takes a size argument and a seed and returns the same
+playlist text for the same arguments on every platform, so results
+collected on different machines or revisions parse identical input.
+"""
+
+import base64
+import random
+from datetime import datetime, timedelta, timezone
+
+EPOCH = datetime(2026, 1, 1, tzinfo=timezone.utc)
+
+
+def _pdt(value):
+    return value.isoformat(timespec="milliseconds").replace("+00:00", "Z")
+
+
+def _scte35(rng, size=32):
+    return base64.b64encode(bytes(rng.randrange(256) for _ in range(size))).decode()
+
+
+def vod(segments=100_000, seed=1):
+    """Long VOD rendition: plain EXTINF + URI pairs and an ENDLIST."""
+    rng = random.Random(seed)
+    out = [
+        "#EXTM3U",
+        "#EXT-X-VERSION:3",
+        "#EXT-X-TARGETDURATION:7",
+        "#EXT-X-MEDIA-SEQUENCE:0",
+        "#EXT-X-PLAYLIST-TYPE:VOD",
+    ]
+    for i in range(segments):
+        out.append(f"#EXTINF:{6 + rng.randrange(-50, 50) / 1000:.3f},")
+        out.append(f"video/1080p/segment_{i:06d}.ts")
+    out.append("#EXT-X-ENDLIST")
+    return "\n".join(out) + "\n"
+
+
+def live_pdt(segments=10_000, seed=2):
+    """Live DVR window with a PROGRAM-DATE-TIME on every segment."""
+    rng = random.Random(seed)
+    media_sequence = 1_000_000
+    now = EPOCH
+    out = [
+        "#EXTM3U",
+        "#EXT-X-VERSION:6",
+        "#EXT-X-TARGETDURATION:6",
+        f"#EXT-X-MEDIA-SEQUENCE:{media_sequence}",
+        "#EXT-X-DISCONTINUITY-SEQUENCE:12",
+        "#EXT-X-INDEPENDENT-SEGMENTS",
+    ]
+    for i in range(segments):
+        if i and i % 500 == 0:
+            out.append("#EXT-X-DISCONTINUITY")
+        duration = 6 - rng.randrange(0, 3) / 100
+        out.append(f"#EXT-X-PROGRAM-DATE-TIME:{_pdt(now)}")
+        out.append(f"#EXTINF:{duration:.3f},")
+        out.append(f"https://cdn.example.com/live/ch1/{media_sequence + i}.ts")
+        now += timedelta(seconds=duration)
+    return "\n".join(out) + "\n"
+
+
+def ll_hls(segments=2_000, parts_per_segment=4, seed=3):
+    """Low-latency HLS with parts, a preload hint and rendition reports."""
+    rng = random.Random(seed)
+    part_target = 1.0
+    media_sequence = 5_000
+    now = EPOCH
+    out = [
+        "#EXTM3U",
+        "#EXT-X-VERSION:9",
+        "#EXT-X-TARGETDURATION:4",
+        (
+            "#EXT-X-SERVER-CONTROL:CAN-BLOCK-RELOAD=YES,PART-HOLD-BACK=3.0,"
+            "CAN-SKIP-UNTIL=24.0"
+        ),
+        f"#EXT-X-PART-INF:PART-TARGET={part_target:.1f}",
+        f"#EXT-X-MEDIA-SEQUENCE:{media_sequence}",
+        '#EXT-X-MAP:URI="init.mp4"',
+    ]
+    for i in range(segments):
+        msn = media_sequence + i
+        out.append(f"#EXT-X-PROGRAM-DATE-TIME:{_pdt(now)}")
+        duration = 0.0
+        for p in range(parts_per_segment):
+            part = part_target - rng.randrange(0, 5) / 1000
+            duration += part
+            independent = ",INDEPENDENT=YES" if p == 0 else ""
+            out.append(
+                f'#EXT-X-PART:DURATION={part:.3f},URI="seg{msn}.part{p}.mp4"'
+                + independent
+            )
+        out.append(f"#EXTINF:{duration:.3f},")
+        out.append(f"seg{msn}.mp4")
+        now += timedelta(seconds=duration)
+    msn = media_sequence + segments
+    for p in range(2):
+        out.append(f'#EXT-X-PART:DURATION={part_target:.3f},URI="seg{msn}.part{p}.mp4"')
+    out.append(f'#EXT-X-PRELOAD-HINT:TYPE=PART,URI="seg{msn}.part2.mp4"')
+    for rendition in ("720p", "480p", "audio"):
+        out.append(
+            f'#EXT-X-RENDITION-REPORT:URI="../{rendition}/index.m3u8",'
+            f"LAST-MSN={msn},LAST-PART=1"
+        )
+    return "\n".join(out) + "\n"
+
+
+def ssai(segments=10_000, break_every=24, break_length=5, seed=4):
+    """Ad-insertion heavy live playlist using CUE and DATERANGE signalling."""
+    rng = random.Random(seed)
+    media_sequence = 250_000
+    now = EPOCH
+    out = [
+        "#EXTM3U",
+        "#EXT-X-VERSION:6",
+        "#EXT-X-TARGETDURATION:6",
+        f"#EXT-X-MEDIA-SEQUENCE:{media_sequence}",
+    ]
+    for i in range(segments):
+        position = i % break_every
+        if position == 0:
+            payload = _scte35(rng)
+            planned = break_length * 6.0
+            out.append(f"#EXT-X-PROGRAM-DATE-TIME:{_pdt(now)}")
+            out.append(
+                f'#EXT-X-DATERANGE:ID="splice-{i}",START-DATE="{_pdt(now)}",'
+                f"PLANNED-DURATION={planned:.1f},SCTE35-OUT=0x{rng.getrandbits(128):032X}"
+            )
+            out.append(f"#EXT-OATCLS-SCTE35:{payload}")
+            out.append(f"#EXT-X-ASSET:CAID=0x{rng.getrandbits(48):012X}")
+            out.append(f"#EXT-X-CUE-OUT:{planned:.1f}")
+        elif position < break_length:
+            out.append(
+                f"#EXT-X-CUE-OUT-CONT:ElapsedTime={position * 6.0:.1f},"
+                f"Duration={break_length * 6.0:.1f},SCTE35={_scte35(rng)}"
+            )
+        elif position == break_length:
+            out.append("#EXT-X-CUE-IN")
+        out.append("#EXTINF:6.000,")
+        out.append(f"https://ads.example.com/ch7/{media_sequence + i}.ts")
+        now += timedelta(seconds=6)
+    return "\n".join(out) + "\n"
+
+
+def drm(segments=20_000, rotate_every=10, seed=5):
+    """Encrypted fMP4 rendition with frequent key rotation and byte ranges."""
+    rng = random.Random(seed)
+    out = [
+        "#EXTM3U",
+        "#EXT-X-VERSION:7",
+        "#EXT-X-TARGETDURATION:4",
+        "#EXT-X-MEDIA-SEQUENCE:0",
+        "#EXT-X-PLAYLIST-TYPE:VOD",
+        '#EXT-X-MAP:URI="main.mp4",BYTERANGE="720@0"',
+    ]
+    offset = 720
+    for i in range(segments):
+        if i % rotate_every == 0:
+            out.append(
+                f'#EXT-X-KEY:METHOD=SAMPLE-AES,URI="skd://keys.example.com/{i // rotate_every}",'
+                f'IV=0x{rng.getrandbits(128):032X},KEYFORMAT="com.apple.streamingkeydelivery",'
+                'KEYFORMATVERSIONS="1"'
+            )
+        length = 400_000 + rng.randrange(100_000)
+        out.append("#EXTINF:4.000,")
+        out.append(f"#EXT-X-BYTERANGE:{length}@{offset}")
+        out.append("main.mp4")
+        offset += length
+    out.append("#EXT-X-ENDLIST")
+    return "\n".join(out) + "\n"
+
+
+def master(variants=500, pathways=4, seed=6):
+    """Multi-pathway master playlist with hundreds of variants."""
+    rng = random.Random(seed)
+    ladder = [
+        (416, 234, 145_000, "avc1.42e00a"),
+        (640, 360, 365_000, "avc1.4d401e"),
+        (768, 432, 730_000, "avc1.4d401e"),
+        (960, 540, 2_000_000, "avc1.4d401f"),
+        (1280, 720, 3_000_000, "avc1.64001f"),
+        (1920, 1080, 6_000_000, "avc1.640028"),
+        (1920, 1080, 7_800_000, "hvc1.2.4.L123.B0"),
+        (3840, 2160, 16_000_000, "hvc1.2.4.L153.B0"),
+    ]
+    out = [
+        "#EXTM3U",
+        "#EXT-X-VERSION:6",
+        "#EXT-X-INDEPENDENT-SEGMENTS",
+        (
+            '#EXT-X-CONTENT-STEERING:SERVER-URI="https://steer.example.com/v1",'
+            'PATHWAY-ID="CDN-A"'
+        ),
+    ]
+    for lang in ("en", "es", "fr", "de"):
+        out.append(
+            f'#EXT-X-MEDIA:TYPE=AUDIO,GROUP-ID="aac",LANGUAGE="{lang}",'
+            f'NAME="{lang}",AUTOSELECT=YES,CHANNELS="2",URI="audio/{lang}/index.m3u8"'
+        )
+        out.append(
+            f'#EXT-X-MEDIA:TYPE=SUBTITLES,GROUP-ID="subs",LANGUAGE="{lang}",'
+            f'NAME="{lang}",URI="subs/{lang}/index.m3u8"'
+        )
+    for i in range(variants):
+        width, height, bandwidth, codec = ladder[i % len(ladder)]
+        bandwidth += rng.randrange(-10_000, 10_000)
+        pathway = f"CDN-{chr(ord('A') + i % pathways)}"
+        video_range = "PQ" if codec.startswith("hvc1") else "SDR"
+        out.append(
+            f"#EXT-X-STREAM-INF:BANDWIDTH={bandwidth},"
+            f"AVERAGE-BANDWIDTH={bandwidth * 9 // 10},RESOLUTION={width}x{height},"
+            f'FRAME-RATE=29.970,CODECS="{codec},mp4a.40.2",VIDEO-RANGE={video_range},'
+            f'HDCP-LEVEL=TYPE-0,AUDIO="aac",SUBTITLES="subs",PATHWAY-ID="{pathway}"'
+        )
+        out.append(f"https://{pathway.lower()}.example.com/v{i}/index.m3u8")
+    for width, height, bandwidth, codec in ladder:
+        out.append(
+            f"#EXT-X-I-FRAME-STREAM-INF:BANDWIDTH={bandwidth // 10},"
+            f'RESOLUTION={width}x{height},CODECS="{codec}",'
+            f'URI="iframes/{height}p.m3u8"'
+        )
+    return "\n".join(out) + "\n"
+
+
+WORKLOADS = {
+    "vod_100k": vod,
+    "live_pdt": live_pdt,
+    "ll_hls": ll_hls,
+    "ssai": ssai,
+    "drm_key_rotation": drm,
+    "master_500": master,
+}
+
+
+def build(name, scale=1.0):
+    """Return the playlist text for workload ``name`` scaled by ``scale``."""
+    generator = WORKLOADS[name]
+    size = generator.__defaults__[0]
+    return generator(max(1, int(size * scale)))
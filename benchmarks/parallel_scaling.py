@@ -0,0 +1,116 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+"""
+Parse throughput across threads.
+
+Every thread parses the same playlist in a loop for ``--duration`` seconds
+after a shared start barrier; the report gives total parses per second and
+the speedup over one thread. On a free-threaded interpreter (3.13t, 3.14t)
+with the GIL disabled the C parser should scale close to linearly; with
+the GIL the speedup stays near 1.0.
+
+    python -m benchmarks.parallel_scaling --threads 1 2 4 8
+    python -X gil=0 -m benchmarks.parallel_scaling --workload live_pdt
+"""
+
+import argparse
+import json
+import os
+import sys
+import threading
+import time
+
+from benchmarks import corpus
+
+
+def _gil_enabled():
+    is_gil_enabled = getattr(sys, "_is_gil_enabled", None)
+    return True if is_gil_enabled is None else is_gil_enabled()
+
+
+def _run(parse, content, threads, duration):
+    barrier = threading.Barrier(threads + 1)
+    counts = [0] * threads
+    deadline = [0.0]
+
+    def worker(index):
+        barrier.wait()
+        count = 0
+        while time.perf_counter() < deadline[0]:
+            parse(content)
+            count += 1
+        counts[index] = count
+
+    workers = [threading.Thread(target=worker, args=(i,)) for i in range(threads)]
+    for thread in workers:
+        thread.start()
+    started = time.perf_counter()
+    deadline[0] = started + duration
+    barrier.wait()
+    for thread in workers:
+        thread.join()
+    elapsed = time.perf_counter() - started
+    return sum(counts) / elapsed
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument(
+        "--workload", choices=sorted(corpus.WORKLOADS), default="live_pdt"
+    )
+    parser.add_argument("--scale", type=float, default=0.1)
+    parser.add_argument(
+        "--threads",
+        nargs="+",
+        type=int,
+        default=sorted({1, 2, 4, os.cpu_count() or 1}),
+    )
+    parser.add_argument("--duration", type=float, default=2.0)
+    parser.add_argument("-o", "--output", help="write JSON results to this file")
+    args = parser.parse_args(argv)
+
+    import openm3u8
+
+    backend = "python" if openm3u8.parse.__module__ == "openm3u8.parser" else "c"
+    content = corpus.build(args.workload, args.scale)
+    openm3u8.parse(content)  # warm-up
+
+    # Imported after the extension so the GIL state reflects its declaration
+    gil = _gil_enabled()
+    print(
+        f"backend={backend} gil={'enabled' if gil else 'disabled'} "
+        f"workload={args.workload} scale={args.scale}",
+        file=sys.stderr,
+    )
+
+    results = []
+    baseline = None
+    for threads in args.threads:
+        rate = _run(openm3u8.parse, content, threads, args.duration)
+        baseline = baseline or rate
+        results.append(
+            {"threads": threads, "parses_per_s": rate, "speedup": rate / baseline}
+        )
+        print(
+            f"threads={threads:<3} {rate:10.1f} parses/s  speedup={rate / baseline:5.2f}x",
+            file=sys.stderr,
+        )
+
+    report = {
+        "python": sys.version,
+        "backend": backend,
+        "gil_enabled": gil,
+        "workload": args.workload,
+        "scale": args.scale,
+        "results": results,
+    }
+    if args.output:
+        with open(args.output, "w") as fileobj:
+            json.dump(report, fileobj, indent=2)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,248 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+"""
+Benchmark runner.
+
+Measures, for every workload in ``benchmarks.corpus``:
+
+  parse    openm3u8.parse(content)
+  model    openm3u8.M3U8(content)
+  dumps    M3U8.dumps() on an already-built object
+
+Each backend runs in its own interpreter, because the parser implementation
+is selected at import time: ``c`` is the default build and ``python`` sets
+``M3U8_NO_C_EXTENSION=1``.  Results are written as JSON and can be compared
+with ``python -m benchmarks.compare old.json new.json``.
+
+Usage:
+
+    python -m benchmarks.run -o results.json
+    python -m benchmarks.run --workload vod_100k --operation parse --scale 0.1
+"""
+
+import argparse
+import hashlib
+import json
+import os
+import platform
+import statistics
+import subprocess
+import sys
+import time
+import tracemalloc
+
+from benchmarks import corpus
+
+OPERATIONS = ("parse", "model", "dumps")
+BACKENDS = ("c", "python")
+FORMAT_VERSION = 1
+
+
+def _percentile(sorted_values, fraction):
+    if len(sorted_values) == 1:
+        return sorted_values[0]
+    position = (len(sorted_values) - 1) * fraction
+    low = int(position)
+    high = min(low + 1, len(sorted_values) - 1)
+    return sorted_values[low] + (sorted_values[high] - sorted_values[low]) * (
+        position - low
+    )
+
+
+def _operation(name, content):
+    import openm3u8
+
+    if name == "parse":
+        return lambda: openm3u8.parse(content)
+    if name == "model":
+        return lambda: openm3u8.M3U8(content)
+    if name == "dumps":
+        playlist = openm3u8.M3U8(content)
+        return playlist.dumps
+    raise ValueError(f"unknown operation {name!r}")
+
+
+def _measure(fn, min_time, min_iterations, max_iterations):
+    fn()  # warm-up: imports, interned strings, lazy caches
+    timings = []
+    started = time.perf_counter()
+    while len(timings) < max_iterations:
+        t0 = time.perf_counter_ns()
+        fn()
+        timings.append(time.perf_counter_ns() - t0)
+        if len(timings) >= min_iterations and time.perf_counter() - started >= min_time:
+            break
+
+    tracemalloc.start()
+    fn()
+    _, peak = tracemalloc.get_traced_memory()
+    tracemalloc.stop()
+    return timings, peak
+
+
+def _summarize(timings_ns, peak, content, segments):
+    ordered = sorted(timings_ns)
+    seconds = [t / 1e9 for t in ordered]
+    mean = statistics.fmean(seconds)
+    return {
+        "iterations": len(ordered),
+        "latency_ms": {
+            "min": seconds[0] * 1e3,
+            "mean": mean * 1e3,
+            "p50": _percentile(seconds, 0.50) * 1e3,
+            "p90": _percentile(seconds, 0.90) * 1e3,
+            "p99": _percentile(seconds, 0.99) * 1e3,
+            "max": seconds[-1] * 1e3,
+            "stdev": (statistics.stdev(seconds) if len(seconds) > 1 else 0.0) * 1e3,
+        },
+        "throughput": {
+            "mb_per_s": len(content.encode()) / 1e6 / _percentile(seconds, 0.50),
+            "lines_per_s": content.count("\n") / _percentile(seconds, 0.50),
+            "segments_per_s": segments / _percentile(seconds, 0.50),
+        },
+        "peak_memory_bytes": peak,
+    }
+
+
+def worker(args):
+    """Run the requested benchmarks in this interpreter and print JSON."""
+    import openm3u8
+    import openm3u8.model
+
+    backend = "python" if openm3u8.model.parse.__module__ == "openm3u8.parser" else "c"
+    results = []
+    for workload in args.workload:
+        content = corpus.build(workload, args.scale)
+        segments = len(openm3u8.parse(content)["segments"]) or 1
+        for operation in args.operation:
+            fn = _operation(operation, content)
+            timings, peak = _measure(
+                fn, args.min_time, args.min_iterations, args.max_iterations
+            )
+            entry = {
+                "workload": workload,
+                "operation": operation,
+                "backend": backend,
+                "scale": args.scale,
+                "input_bytes": len(content.encode()),
+                "input_sha256": hashlib.sha256(content.encode()).hexdigest(),
+            }
+            entry.update(_summarize(timings, peak, content, segments))
+            results.append(entry)
+            print(
+                f"{backend:>6} {workload:<18} {operation:<6} "
+                f"p50={entry['latency_ms']['p50']:9.2f}ms "
+                f"p99={entry['latency_ms']['p99']:9.2f}ms "
+                f"{entry['throughput']['mb_per_s']:8.1f}MB/s "
+                f"peak={peak / 1e6:8.1f}MB",
+                file=sys.stderr,
+            )
+    json.dump(results, sys.stdout)
+
+
+def _run_backend(backend, args):
+    env = dict(os.environ)
+    if backend == "python":
+        env["M3U8_NO_C_EXTENSION"] = "1"
+    else:
+        env.pop("M3U8_NO_C_EXTENSION", None)
+        probe = subprocess.run(
+            [sys.executable, "-c", "import openm3u8._m3u8_parser"],
+            env=env,
+            capture_output=True,
+            check=False,
+        )
+        if probe.returncode != 0:
+            print("C extension not available; skipping c backend", file=sys.stderr)
+            return []
+
+    command = [
+        sys.executable,
+        "-m",
+        "benchmarks.run",
+        "--worker",
+        "--scale",
+        str(args.scale),
+        "--min-time",
+        str(args.min_time),
+        "--min-iterations",
+        str(args.min_iterations),
+        "--max-iterations",
+        str(args.max_iterations),
+        "--workload",
+        *args.workload,
+        "--operation",
+        *args.operation,
+    ]
+    completed = subprocess.run(
+        command, env=env, stdout=subprocess.PIPE, check=True, text=True
+    )
+    return json.loads(completed.stdout)
+
+
+def _git_revision():
+    try:
+        return subprocess.run(
+            ["git", "rev-parse", "HEAD"],
+            capture_output=True,
+            check=True,
+            text=True,
+        ).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument(
+        "--workload", nargs="+", choices=sorted(corpus.WORKLOADS), default=None
+    )
+    parser.add_argument("--operation", nargs="+", choices=OPERATIONS, default=None)
+    parser.add_argument("--backend", nargs="+", choices=BACKENDS, default=None)
+    parser.add_argument(
+        "--scale",
+        type=float,
+        default=1.0,
+        help="multiply every workload size by this factor (default: 1.0)",
+    )
+    parser.add_argument("--min-time", type=float, default=1.0)
+    parser.add_argument("--min-iterations", type=int, default=5)
+    parser.add_argument("--max-iterations", type=int, default=200)
+    parser.add_argument("-o", "--output", help="write JSON results to this file")
+    parser.add_argument("--worker", action="store_true", help=argparse.SUPPRESS)
+    args = parser.parse_args(argv)
+
+    args.workload = args.workload or sorted(corpus.WORKLOADS)
+    args.operation = args.operation or list(OPERATIONS)
+
+    if args.worker:
+        worker(args)
+        return 0
+
+    results = []
+    for backend in args.backend or BACKENDS:
+        results.extend(_run_backend(backend, args))
+
+    report = {
+        "format_version": FORMAT_VERSION,
+        "created": time.strftime("%Y-%m-%dT%H:%M:%SZ", time.gmtime()),
+        "git_revision": _git_revision(),
+        "python": sys.version,
+        "implementation": platform.python_implementation(),
+        "platform": platform.platform(),
+        "machine": platform.machine(),
+        "results": results,
+    }
+    if args.output:
+        with open(args.output, "w") as fileobj:
+            json.dump(report, fileobj, indent=2)
+    else:
+        json.dump(report, sys.stdout, indent=2)
+        print()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
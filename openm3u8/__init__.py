@@ -4,11 +4,19 @@
 # license that can be found in the LICENSE file.
 
 import os
+import warnings
 from urllib.parse import urljoin, urlsplit
 
-from openm3u8.httpclient import DefaultHTTPClient
+from openm3u8.alignment import AlignmentReport, check_alignment
+from openm3u8.byterange import ByteRange, plan_range_requests, resolve_byteranges
+from openm3u8.codecinfo import Codec, parse_channels, parse_codecs
+from openm3u8.daterangeindex import DateRangeIndex
+from openm3u8.delta import diff
+from openm3u8.httpclient import CHUNK_SIZE, DefaultHTTPClient
 from openm3u8.model import (
+    DEFAULT_PATHWAY_ID,
     M3U8,
+    AdBreak,
     ContentSteering,
     DateRange,
     DateRangeList,
@@ -32,12 +40,29 @@ from openm3u8.model import (
     Start,
     Tiles,
 )
-from openm3u8.parser import parse, ParseError
+from openm3u8.parser import (
+    ATTR_BANDWIDTH,
+    ATTR_FLOAT,
+    ATTR_INT,
+    ATTR_QUOTED_STRING,
+    ATTR_STRING,
+    CustomTagSchema,
+    ParseError,
+    PlaylistParser,
+    fingerprint,
+    parse,
+)
+from openm3u8.scte35 import SpliceInfoSection
+from openm3u8.scte35 import decode as decode_scte35
+from openm3u8.scte35 import encode as encode_scte35
+from openm3u8.sharedcache import PlaylistView, SharedPlaylistCache
+from openm3u8.snapshot import SnapshotError, dumpb, loadb
+from openm3u8.tail import parse_tail
 
 # Try to import the C extension for faster parsing, fall back to Python
 if os.environ.get("M3U8_NO_C_EXTENSION", "") != "1":
     try:
-        from openm3u8._m3u8_parser import parse
+        from openm3u8._m3u8_parser import fingerprint, parse
     except ImportError:
         pass
 
@@ -53,6 +78,7 @@ __all__ = (
     "Media",
     "MediaList",
     "PlaylistList",
+    "DEFAULT_PATHWAY_ID",
     "Start",
     "RenditionReport",
     "RenditionReportList",
@@ -62,28 +88,139 @@ __all__ = (
     "PreloadHint",
     "DateRange",
     "DateRangeList",
+    "DateRangeIndex",
     "ContentSteering",
     "ImagePlaylist",
     "Tiles",
+    "AdBreak",
     "loads",
     "load",
     "parse",
+    "PlaylistParser",
+    "parse_header",
+    "parse_tail",
+    "parse_if_changed",
+    "fingerprint",
+    "diff",
+    "check_alignment",
+    "AlignmentReport",
+    "ByteRange",
+    "resolve_byteranges",
+    "plan_range_requests",
+    "Codec",
+    "parse_codecs",
+    "parse_channels",
+    "dumpb",
+    "loadb",
+    "SnapshotError",
+    "SharedPlaylistCache",
+    "PlaylistView",
+    "SpliceInfoSection",
+    "decode_scte35",
+    "encode_scte35",
     "ParseError",
+    "CustomTagSchema",
+    "ATTR_STRING",
+    "ATTR_INT",
+    "ATTR_FLOAT",
+    "ATTR_QUOTED_STRING",
+    "ATTR_BANDWIDTH",
 )
 
 
-def loads(content, uri=None, custom_tags_parser=None):
+def parse_header(content, strict=False):
+    """
+    Parse only the playlist header: every tag before the first media segment
+    URI line, so `targetduration`, `media_sequence`, `server_control`,
+    `is_variant` etc. are available without reading the body. Returns the
+    same dict as `parse` with no segments.
+    """
+    return parse(content, strict, until="header")
+
+
+def parse_if_changed(content, previous=None, ignore=None, **kwargs):
+    """
+    Parse `content` unless it is unchanged since an earlier call.
+
+    `previous` is the (fingerprint, data) pair returned by that call. When
+    `content` has the same fingerprint, ignoring lines that start with one
+    of the `ignore` prefixes, `previous` is returned as is and nothing is
+    parsed. Other keyword arguments are passed to `parse`. Returns a
+    (fingerprint, data) pair.
+    """
+    digest = fingerprint(content, ignore)
+    if previous is not None and previous[0] == digest:
+        return previous
+    return digest, parse(content, **kwargs)
+
+
+def _build_model(
+    content,
+    base_uri,
+    previous,
+    custom_tags_parser=None,
+    custom_tag_handlers=None,
+    fields=None,
+):
+    # The fingerprint and parse options are always stored, so any result can
+    # be a later previous=, which skips parsing when content, base URI and
+    # options are unchanged
+    digest = fingerprint(content)
+    if fields is not None and not isinstance(fields, str):
+        fields = frozenset(fields)
+    if isinstance(custom_tag_handlers, dict):
+        custom_tag_handlers = dict(custom_tag_handlers)
+    options = (custom_tags_parser, custom_tag_handlers, fields)
+    if previous is not None:
+        if base_uri and not base_uri.endswith("/"):
+            expected_base_uri = base_uri + "/"
+        else:
+            expected_base_uri = base_uri
+        if (
+            previous.fingerprint == digest
+            and previous.base_uri == expected_base_uri
+            and previous._parse_options == options
+        ):
+            return previous
+    playlist = M3U8(
+        content,
+        base_uri=base_uri,
+        custom_tags_parser=custom_tags_parser,
+        custom_tag_handlers=custom_tag_handlers,
+        fields=fields,
+    )
+    playlist.fingerprint = digest
+    playlist._parse_options = options
+    return playlist
+
+
+def loads(
+    content,
+    uri=None,
+    custom_tags_parser=None,
+    custom_tag_handlers=None,
+    fields=None,
+    previous=None,
+):
     """
     Given a string with a m3u8 content, returns a M3U8 object.
     Optionally parses a uri to set a correct base_uri on the M3U8 object.
+    `fields` restricts parsing to the named outputs (see `parse`).
+    If `previous` is a M3U8 returned by an earlier call with the same
+    arguments and the content has not changed, that same instance is
+    returned unparsed, so every caller passing it shares one object;
+    different `uri`, `fields` or custom tag parsers parse again.
     Raises ValueError if invalid content
     """
-
-    if uri is None:
-        return M3U8(content, custom_tags_parser=custom_tags_parser)
-    else:
-        base_uri = urljoin(uri, ".")
-        return M3U8(content, base_uri=base_uri, custom_tags_parser=custom_tags_parser)
+    base_uri = None if uri is None else urljoin(uri, ".")
+    return _build_model(
+        content,
+        base_uri,
+        previous,
+        custom_tags_parser=custom_tags_parser,
+        custom_tag_handlers=custom_tag_handlers,
+        fields=fields,
+    )
 
 
 def load(
@@ -93,21 +230,89 @@ def load(
     custom_tags_parser=None,
     http_client=DefaultHTTPClient(),
     verify_ssl=True,
+    custom_tag_handlers=None,
+    fields=None,
+    previous=None,
+    stream=False,
 ):
     """
     Retrieves the content from a given URI and returns a M3U8 object.
+    `previous` works as in `loads`: the same instance comes back when the
+    content and arguments are unchanged.
+    With ``stream=True`` a playlist served over HTTP is parsed with
+    `PlaylistParser` while it downloads, as the client's `stream` method
+    reads, gunzips and decodes it, instead of being held whole first; a
+    file is parsed as it is read. A client without a `stream` method
+    downloads the whole playlist instead, with a RuntimeWarning. Streaming
+    always uses the pure-Python parser and cannot be combined with
+    `previous`.
     Raises ValueError if invalid content or IOError if request fails.
     """
+    if stream and previous is not None:
+        raise ValueError("previous cannot be used with stream=True")
     base_uri_parts = urlsplit(uri)
     if base_uri_parts.scheme and base_uri_parts.netloc:
+        if stream and hasattr(http_client, "stream"):
+            chunks, base_uri = http_client.stream(uri, timeout, headers, verify_ssl)
+            return _build_streamed_model(
+                chunks, base_uri, custom_tags_parser, custom_tag_handlers, fields
+            )
+        if stream:
+            warnings.warn(
+                f"{type(http_client).__name__} has no stream method, so the "
+                "whole playlist is downloaded before parsing",
+                RuntimeWarning,
+                stacklevel=2,
+            )
         content, base_uri = http_client.download(uri, timeout, headers, verify_ssl)
-        return M3U8(content, base_uri=base_uri, custom_tags_parser=custom_tags_parser)
+        return _build_model(
+            content,
+            base_uri,
+            previous,
+            custom_tags_parser=custom_tags_parser,
+            custom_tag_handlers=custom_tag_handlers,
+            fields=fields,
+        )
+    elif stream:
+        with open(uri, encoding="utf8") as fileobj:
+            chunks = iter(lambda: fileobj.read(CHUNK_SIZE), "")
+            return _build_streamed_model(
+                chunks,
+                os.path.dirname(uri),
+                custom_tags_parser,
+                custom_tag_handlers,
+                fields,
+            )
     else:
-        return _load_from_file(uri, custom_tags_parser)
+        return _load_from_file(
+            uri, custom_tags_parser, custom_tag_handlers, fields, previous
+        )
+
 
+def _build_streamed_model(
+    chunks, base_uri, custom_tags_parser, custom_tag_handlers, fields
+):
+    parser = PlaylistParser(
+        custom_tags_parser=custom_tags_parser,
+        custom_tag_handlers=custom_tag_handlers,
+        fields=fields,
+    )
+    for chunk in chunks:
+        parser.feed(chunk)
+    return M3U8.from_data(parser.close(), base_uri=base_uri)
 
-def _load_from_file(uri, custom_tags_parser=None):
+
+def _load_from_file(
+    uri, custom_tags_parser=None, custom_tag_handlers=None, fields=None, previous=None
+):
     with open(uri, encoding="utf8") as fileobj:
         raw_content = fileobj.read().strip()
     base_uri = os.path.dirname(uri)
-    return M3U8(raw_content, base_uri=base_uri, custom_tags_parser=custom_tags_parser)
+    return _build_model(
+        raw_content,
+        base_uri,
+        previous,
+        custom_tags_parser=custom_tags_parser,
+        custom_tag_handlers=custom_tag_handlers,
+        fields=fields,
+    )
@@ -31,7 +31,16 @@
  *
  * Thread Safety:
  * - No mutable static state; all state is per-module
- * - GIL is held throughout parsing (no release/acquire)
+ * - Module state is immutable after init, except the profiling counters,
+ *   which each call accumulates locally and merges under a lock
+ * - The data/state dicts are private to one parse() call; callbacks run on
+ *   the parsing thread. Values read from dicts a callback may hand to user
+ *   code use strong references (dict_get_ref)
+ * - Declared Py_MOD_GIL_NOT_USED on free-threaded builds
+ *
+ * Profiling:
+ * - Opt-in per-tag counters (set_stats_enabled/get_stats/reset_stats)
+ * - Zero cost when disabled beyond a NULL check per dispatched line
  */
 
 #define PY_SSIZE_T_CLEAN
@@ -40,6 +49,8 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <math.h>
+#include <stdint.h>
+#include <time.h>
 
 /*
  * Whitespace/Case handling for protocol parsing.
@@ -215,6 +226,21 @@ static inline PyObject *dict_get_interned(PyObject *dict, PyObject *interned_key
     X(str_blackout, "blackout") \
     X(str_byterange, "byterange") \
     X(str_bitrate, "bitrate") \
+    X(str_custom_parser_values, "custom_parser_values") \
+    /* Ad break keys and values */ \
+    X(str_ad_breaks, "ad_breaks") \
+    X(str_open_ad_breaks, "open_ad_breaks") \
+    X(str_source, "source") \
+    X(str_id, "id") \
+    X(str_start_segment, "start_segment") \
+    X(str_end_segment, "end_segment") \
+    X(str_planned_duration, "planned_duration") \
+    X(str_elapsed_time, "elapsed_time") \
+    X(str_scte35_in, "scte35_in") \
+    X(str_scte35_out, "scte35_out") \
+    X(str_complete, "complete") \
+    X(str_cue, "cue") \
+    X(str_daterange, "daterange") \
     /* Data dict keys */ \
     X(str_playlists, "playlists") \
     X(str_iframe_playlists, "iframe_playlists") \
@@ -247,6 +273,63 @@ static inline PyObject *dict_get_interned(PyObject *dict, PyObject *interned_key
     X(str_iframe_stream_info, "iframe_stream_info") \
     X(str_image_stream_info, "image_stream_info")
 
+/*
+ * Opt-in profiling counters.
+ *
+ * Per-tag slots are indexed by position in TAG_DISPATCH (checked against
+ * MAX_TAG_STATS at compile time). Categories cover the work done outside
+ * tag handlers. Counters are only touched while the GIL is held.
+ */
+#define MAX_TAG_STATS 64
+
+typedef enum {
+    STAT_PARSE,              /* Completed parse() calls, end to end */
+    STAT_STRICT_VALIDATION,  /* version_matching.validate() in strict mode */
+    STAT_SETUP,              /* Allocating the result and state dicts */
+    STAT_CUSTOM_TAGS_PARSER, /* custom_tags_parser callbacks, incl. state sync */
+    STAT_CUSTOM_TAG_HANDLERS, /* Matched custom_tag_handlers, incl. state sync */
+    STAT_URI_LINES,          /* Segment and variant URI lines */
+    STAT_UNKNOWN_TAGS,       /* '#' lines no handler claimed */
+    NUM_STAT_CATEGORIES
+} StatCategory;
+
+static const char *const STAT_CATEGORY_NAMES[NUM_STAT_CATEGORIES] = {
+    "parse",
+    "strict_validation",
+    "setup",
+    "custom_tags_parser",
+    "custom_tag_handlers",
+    "uri_lines",
+    "unknown_tags",
+};
+
+typedef struct {
+    uint64_t calls;
+    uint64_t ns;
+} StatCounter;
+
+typedef struct {
+    int enabled;
+    StatCounter categories[NUM_STAT_CATEGORIES];
+    StatCounter tags[MAX_TAG_STATS];
+} ParseStats;
+
+static inline uint64_t
+monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* Record one call that started at t0 (a monotonic_ns() timestamp). */
+static inline void
+stat_record(StatCounter *counter, uint64_t t0)
+{
+    counter->calls++;
+    counter->ns += monotonic_ns() - t0;
+}
+
 /*
  * Module state - holds all per-module data.
  *
@@ -260,12 +343,106 @@ typedef struct {
     PyObject *datetime_cls;
     PyObject *timedelta_cls;
     PyObject *fromisoformat_meth;
+    PyObject *CustomTagSchema;  /* openm3u8.parser.CustomTagSchema, may be NULL */
+    ParseStats stats;        /* Profiling counters (zeroed with the state) */
+#ifdef Py_GIL_DISABLED
+    PyMutex lock;            /* Guards stats and lazy fields; zero == unlocked */
+#endif
     /* Interned strings - generated from X-macro */
     #define DECLARE_INTERNED(name, str) PyObject *name;
     INTERNED_STRINGS(DECLARE_INTERNED)
     #undef DECLARE_INTERNED
 } m3u8_state;
 
+/*
+ * Profiling counters are shared by every thread using the module. Without
+ * the GIL, parse() accumulates into a local ParseStats and merges it under
+ * the state lock; with the GIL the lock is a no-op.
+ */
+#ifdef Py_GIL_DISABLED
+#define STATS_LOCK(ms) PyMutex_Lock(&(ms)->lock)
+#define STATS_UNLOCK(ms) PyMutex_Unlock(&(ms)->lock)
+#define STATS_ENABLED(ms) __atomic_load_n(&(ms)->stats.enabled, __ATOMIC_RELAXED)
+#define STATS_SET_ENABLED(ms, v) \
+    __atomic_store_n(&(ms)->stats.enabled, (v), __ATOMIC_RELAXED)
+#else
+#define STATS_LOCK(ms) ((void)0)
+#define STATS_UNLOCK(ms) ((void)0)
+#define STATS_ENABLED(ms) ((ms)->stats.enabled)
+#define STATS_SET_ENABLED(ms, v) ((ms)->stats.enabled = (v))
+#endif
+
+/* Lazily resolved pointers are published with release/acquire ordering */
+#ifdef Py_GIL_DISABLED
+#define LOAD_PTR(p) __atomic_load_n(&(p), __ATOMIC_ACQUIRE)
+#define STORE_PTR(p, v) __atomic_store_n(&(p), (v), __ATOMIC_RELEASE)
+#else
+#define LOAD_PTR(p) (p)
+#define STORE_PTR(p, v) ((p) = (v))
+#endif
+
+/*
+ * Resolve ParseError and CustomTagSchema from openm3u8.parser on first use.
+ *
+ * Sharing openm3u8.parser.ParseError keeps "except ParseError" working for
+ * either backend. If the Python module cannot be imported, a local
+ * ParseError is created and CustomTagSchema stays NULL (schemas then run
+ * through their Python __call__). Returns 0 on success, -1 on error.
+ */
+static int
+resolve_parser_objects(m3u8_state *state)
+{
+    if (LOAD_PTR(state->ParseError) != NULL) {
+        return 0;
+    }
+
+    PyObject *parse_error = NULL;
+    PyObject *schema = NULL;
+    PyObject *parser_module = PyImport_ImportModule("openm3u8.parser");
+    if (parser_module != NULL) {
+        parse_error = PyObject_GetAttrString(parser_module, "ParseError");
+        schema = PyObject_GetAttrString(parser_module, "CustomTagSchema");
+        Py_DECREF(parser_module);
+    }
+    PyErr_Clear();
+    if (parse_error == NULL) {
+        parse_error = PyErr_NewException(
+            "openm3u8._m3u8_parser.ParseError", PyExc_Exception, NULL);
+        if (parse_error == NULL) {
+            Py_XDECREF(schema);
+            return -1;
+        }
+    }
+
+    /* Another thread may have won the race while we were importing */
+    STATS_LOCK(state);
+    if (state->ParseError == NULL) {
+        state->CustomTagSchema = schema;
+        STORE_PTR(state->ParseError, parse_error);
+        schema = parse_error = NULL;
+    }
+    STATS_UNLOCK(state);
+    Py_XDECREF(parse_error);
+    Py_XDECREF(schema);
+    return 0;
+}
+
+/* Add one call's counters to the module totals. */
+static void
+stats_merge(m3u8_state *mod_state, const ParseStats *local)
+{
+    STATS_LOCK(mod_state);
+    for (int i = 0; i < NUM_STAT_CATEGORIES; i++) {
+        mod_state->stats.categories[i].calls += local->categories[i].calls;
+        mod_state->stats.categories[i].ns += local->categories[i].ns;
+    }
+    for (int i = 0; i < MAX_TAG_STATS; i++) {
+        mod_state->stats.tags[i].calls += local->tags[i].calls;
+        mod_state->stats.tags[i].ns += local->tags[i].ns;
+    }
+    STATS_UNLOCK(mod_state);
+}
+
 /*
  * Parse context - holds all state needed during a single parse() call.
  *
@@ -290,6 +467,8 @@ typedef struct {
     /* Shadow state for hot flags - avoids dict lookups in main loop */
     int expect_segment;      /* Shadow of state["expect_segment"] */
     int expect_playlist;     /* Shadow of state["expect_playlist"] */
+    ParseStats *stats;       /* Profiling counters, NULL unless enabled */
+    uint64_t tag_mask;       /* Bit i set: TAG_DISPATCH[i] is parsed */
 } ParseContext;
 
 /*
@@ -356,6 +535,49 @@ sync_shadow_from_dict(ParseContext *ctx)
     ctx->expect_playlist = (val == Py_True);
 }
 
+/*
+ * Invoke a user callback as callback(line, lineno, data, state).
+ *
+ * Shadow state is synced to the state dict before the call and read back
+ * afterwards, so callbacks see and may change expect_segment/expect_playlist.
+ *
+ * Returns 1 if the callback's result is truthy (line handled), 0 if not,
+ * -1 on error.
+ */
+static int
+call_tag_callback(ParseContext *ctx, PyObject *callback, const char *line)
+{
+    if (sync_shadow_to_dict(ctx) < 0) {
+        return -1;
+    }
+    PyObject *py_line = PyUnicode_FromString(line);
+    if (py_line == NULL) {
+        return -1;
+    }
+    PyObject *py_lineno = PyLong_FromLong(ctx->lineno);
+    if (py_lineno == NULL) {
+        Py_DECREF(py_line);
+        return -1;
+    }
+#if !defined(Py_LIMITED_API) || Py_LIMITED_API+0 >= 0x030C0000
+    PyObject *call_args[4] = {py_line, py_lineno, ctx->data, ctx->state};
+    PyObject *result = PyObject_Vectorcall(callback, call_args, 4, NULL);
+#else
+    PyObject *result = PyObject_CallFunctionObjArgs(
+        callback, py_line, py_lineno, ctx->data, ctx->state, NULL);
+#endif
+    Py_DECREF(py_line);
+    Py_DECREF(py_lineno);
+    if (result == NULL) {
+        return -1;
+    }
+    /* Callback may have modified state */
+    sync_shadow_from_dict(ctx);
+    int truth = PyObject_IsTrue(result);
+    Py_DECREF(result);
+    return truth;
+}
+
 /* Forward declaration for module definition */
 static struct PyModuleDef m3u8_parser_module;
 
@@ -532,13 +754,42 @@ dict_set_interned(PyObject *dict, PyObject *interned_key, PyObject *value)
     return PyDict_SetItem(dict, interned_key, value);
 }
 
-/* Get dict[key] using interned key. Returns borrowed ref or NULL. */
+/*
+ * Get dict[key] using interned key. Returns borrowed ref or NULL.
+ *
+ * Only for the per-call data/state dicts and the dicts nested in them,
+ * which no other thread mutates while parse() runs. Interned str keys
+ * cannot fail to hash or compare, so NULL always means "missing".
+ */
 static inline PyObject *
 dict_get_interned(PyObject *dict, PyObject *interned_key)
 {
     return PyDict_GetItem(dict, interned_key);
 }
 
+/*
+ * Get dict[key] as a strong reference in *result (NULL if missing).
+ * Returns 0 on success, -1 with an exception set.
+ *
+ * Uses PyDict_GetItemRef where available, so the value cannot be freed
+ * underneath us if user code mutates the dict from another thread.
+ */
+static inline int
+dict_get_ref(PyObject *dict, PyObject *key, PyObject **result)
+{
+#if (!defined(Py_LIMITED_API) && PY_VERSION_HEX >= 0x030D0000) || \
+    (defined(Py_LIMITED_API) && Py_LIMITED_API+0 >= 0x030D0000)
+    return PyDict_GetItemRef(dict, key, result) < 0 ? -1 : 0;
+#else
+    *result = PyDict_GetItemWithError(dict, key);
+    if (*result == NULL) {
+        return PyErr_Occurred() ? -1 : 0;
+    }
+    Py_INCREF(*result);
+    return 0;
+#endif
+}
+
 /*
  * Get or create segment dict in state using interned string.
  * Returns borrowed reference on success, NULL with exception on failure.
@@ -705,6 +956,7 @@ init_parse_data(m3u8_state *ms)
         ms->str_session_data,
         ms->str_session_keys,
         ms->str_segment_map,
+        ms->str_ad_breaks,
     };
     if (init_list_fields(data, list_keys, sizeof(list_keys) / sizeof(list_keys[0])) < 0) {
         goto fail;
@@ -864,10 +1116,12 @@ del_item_interned_ignore_keyerror(PyObject *dict, PyObject *interned_key)
 static int
 transfer_state_bool(PyObject *state, PyObject *segment, PyObject *key)
 {
-    PyObject *val = PyDict_GetItem(state, key);  /* borrowed ref, no error */
-    if (PyDict_SetItem(segment, key, val ? Py_True : Py_False) < 0) return -1;
-    if (val && del_item_interned_ignore_keyerror(state, key) < 0) return -1;
-    return 0;
+    PyObject *val;
+    if (dict_get_ref(state, key, &val) < 0) return -1;
+    int rc = PyDict_SetItem(segment, key, val ? Py_True : Py_False);
+    if (rc == 0 && val) rc = del_item_interned_ignore_keyerror(state, key);
+    Py_XDECREF(val);
+    return rc;
 }
 
 /*
@@ -880,10 +1134,12 @@ transfer_state_bool(PyObject *state, PyObject *segment, PyObject *key)
 static int
 transfer_state_value(PyObject *state, PyObject *segment, PyObject *key)
 {
-    PyObject *val = PyDict_GetItem(state, key);  /* borrowed ref */
-    if (PyDict_SetItem(segment, key, val ? val : Py_None) < 0) return -1;
-    if (val && del_item_interned_ignore_keyerror(state, key) < 0) return -1;
-    return 0;
+    PyObject *val;
+    if (dict_get_ref(state, key, &val) < 0) return -1;
+    int rc = PyDict_SetItem(segment, key, val ? val : Py_None);
+    if (rc == 0 && val) rc = del_item_interned_ignore_keyerror(state, key);
+    Py_XDECREF(val);
+    return rc;
 }
 
 /*
@@ -1043,6 +1299,78 @@ typedef struct {
     AttrType type;
 } AttrParser;
 
+/*
+ * Convert an INT, FLOAT or BANDWIDTH attribute value with the lenient rule
+ * parser._lenient applies: surrounding whitespace is ignored, and a value
+ * that is not a number, or not a finite one, is kept as the raw string.
+ * Short ASCII values are converted in place; anything else goes through
+ * int()/float() so both parsers accept exactly the same spellings.
+ * Returns a new reference, NULL only on memory errors.
+ */
+static PyObject *
+lenient_number(const char *value, Py_ssize_t len, AttrType type)
+{
+    const char *a = value;
+    const char *b = value + len;
+    while (a < b && ascii_isspace((unsigned char)*a)) {
+        a++;
+    }
+    while (b > a && ascii_isspace((unsigned char)*(b - 1))) {
+        b--;
+    }
+
+    double v = 0.0;
+    char num_buf[64];
+    if (b > a && b - a < (Py_ssize_t)sizeof(num_buf)) {
+        memcpy(num_buf, a, b - a);
+        num_buf[b - a] = '\0';
+        if (type == ATTR_INT) {
+            PyObject *number = PyLong_FromString(num_buf, NULL, 10);
+            if (number != NULL) {
+                return number;
+            }
+        } else {
+            v = PyOS_string_to_double(num_buf, NULL, NULL);
+            if (!(v == -1.0 && PyErr_Occurred())) {
+                goto convert;
+            }
+        }
+        PyErr_Clear();
+    }
+
+    /* Slow path: the exact int()/float() rules, or the raw string */
+    PyObject *raw = PyUnicode_FromStringAndSize(value, len);
+    if (raw == NULL) {
+        return NULL;
+    }
+    PyObject *number = type == ATTR_INT ? PyNumber_Long(raw) : PyNumber_Float(raw);
+    if (number == NULL) {
+        if (!PyErr_ExceptionMatches(PyExc_ValueError)) {
+            Py_DECREF(raw);
+            return NULL;
+        }
+        PyErr_Clear();
+        return raw;
+    }
+    if (type == ATTR_INT) {
+        Py_DECREF(raw);
+        return number;
+    }
+    v = PyFloat_AsDouble(number);
+    Py_DECREF(number);
+    if (!isfinite(v)) {
+        return raw;
+    }
+    Py_DECREF(raw);
+    return type == ATTR_FLOAT ? PyFloat_FromDouble(v) : PyLong_FromDouble(v);
+
+convert:
+    if (!isfinite(v)) {
+        return PyUnicode_FromStringAndSize(value, len);
+    }
+    return type == ATTR_FLOAT ? PyFloat_FromDouble(v) : PyLong_FromDouble(v);
+}
+
 /*
  * Schema-aware attribute parser.
  *
@@ -1138,47 +1466,9 @@ parse_attributes_with_schema(const char *start, const char *end,
                         ? (Py_ssize_t)((val_end - full_start) + 1)
                         : (Py_ssize_t)(val_end - full_start);
                     py_val = PyUnicode_FromStringAndSize(full_start, full_len);
-                } else if (type == ATTR_INT || type == ATTR_BANDWIDTH) {
-                    /* Numeric inside quotes - parse directly */
-                    char num_buf[64];
-                    if (val_len < (Py_ssize_t)sizeof(num_buf)) {
-                        memcpy(num_buf, val_start, val_len);
-                        num_buf[val_len] = '\0';
-                        if (type == ATTR_BANDWIDTH) {
-                            double v = PyOS_string_to_double(num_buf, NULL, NULL);
-                            if (v == -1.0 && PyErr_Occurred()) {
-                                PyErr_Clear();
-                            } else {
-                                py_val = PyLong_FromDouble(v);
-                            }
-                        } else {
-                            py_val = PyLong_FromString(num_buf, NULL, 10);
-                            if (py_val == NULL) {
-                                PyErr_Clear();
-                            }
-                        }
-                    }
-                    /* Fallback to string if conversion fails */
-                    if (py_val == NULL) {
-                        py_val = PyUnicode_FromStringAndSize(val_start, val_len);
-                    }
-                } else if (type == ATTR_FLOAT) {
-                    char num_buf[64];
-                    if (val_len < (Py_ssize_t)sizeof(num_buf)) {
-                        memcpy(num_buf, val_start, val_len);
-                        num_buf[val_len] = '\0';
-                        double v = PyOS_string_to_double(num_buf, NULL, NULL);
-                        if (v == -1.0 && PyErr_Occurred()) {
-                            PyErr_Clear();
-                            py_val = PyUnicode_FromStringAndSize(val_start, val_len);
-                        } else {
-                            py_val = PyFloat_FromDouble(v);
-                        }
-                    } else {
-                        py_val = PyUnicode_FromStringAndSize(val_start, val_len);
-                    }
                 } else {
-                    py_val = PyUnicode_FromStringAndSize(val_start, val_len);
+                    /* Numeric inside quotes - parse directly */
+                    py_val = lenient_number(val_start, val_len, type);
                 }
             } else {
                 /* Unquoted value */
@@ -1194,49 +1484,9 @@ parse_attributes_with_schema(const char *start, const char *end,
                 Py_ssize_t val_len = val_end - val_start;
 
                 /* Direct type conversion - no intermediate Python string! */
-                if (type == ATTR_INT) {
-                    char num_buf[64];
-                    if (val_len < (Py_ssize_t)sizeof(num_buf)) {
-                        memcpy(num_buf, val_start, val_len);
-                        num_buf[val_len] = '\0';
-                        py_val = PyLong_FromString(num_buf, NULL, 10);
-                        if (py_val == NULL) {
-                            PyErr_Clear();
-                        }
-                    }
-                    if (py_val == NULL) {
-                        py_val = PyUnicode_FromStringAndSize(val_start, val_len);
-                    }
-                } else if (type == ATTR_BANDWIDTH) {
-                    char num_buf[64];
-                    if (val_len < (Py_ssize_t)sizeof(num_buf)) {
-                        memcpy(num_buf, val_start, val_len);
-                        num_buf[val_len] = '\0';
-                        double v = PyOS_string_to_double(num_buf, NULL, NULL);
-                        if (v == -1.0 && PyErr_Occurred()) {
-                            PyErr_Clear();
-                        } else {
-                            py_val = PyLong_FromDouble(v);
-                        }
-                    }
-                    if (py_val == NULL) {
-                        py_val = PyUnicode_FromStringAndSize(val_start, val_len);
-                    }
-                } else if (type == ATTR_FLOAT) {
-                    char num_buf[64];
-                    if (val_len < (Py_ssize_t)sizeof(num_buf)) {
-                        memcpy(num_buf, val_start, val_len);
-                        num_buf[val_len] = '\0';
-                        double v = PyOS_string_to_double(num_buf, NULL, NULL);
-                        if (v == -1.0 && PyErr_Occurred()) {
-                            PyErr_Clear();
-                            py_val = PyUnicode_FromStringAndSize(val_start, val_len);
-                        } else {
-                            py_val = PyFloat_FromDouble(v);
-                        }
-                    } else {
-                        py_val = PyUnicode_FromStringAndSize(val_start, val_len);
-                    }
+                if (type == ATTR_INT || type == ATTR_FLOAT || type == ATTR_BANDWIDTH) {
+                    /* Unstripped, so a value kept as a string reads as written */
+                    py_val = lenient_number(val_start, p - val_start, type);
                 } else {
                     /* ATTR_STRING or ATTR_QUOTED_STRING (unquoted case) */
                     py_val = PyUnicode_FromStringAndSize(val_start, val_len);
@@ -1619,6 +1869,322 @@ parse_extinf(m3u8_state *mod_state, const char *line, PyObject *state,
     return 0;
 }
 
+/* float(value), or None when value is None or not a number */
+static PyObject *
+float_or_none(PyObject *value)
+{
+    if (value == NULL || value == Py_None) {
+        Py_RETURN_NONE;
+    }
+    PyObject *result = PyNumber_Float(value);
+    if (result == NULL && (PyErr_ExceptionMatches(PyExc_ValueError) ||
+                           PyErr_ExceptionMatches(PyExc_TypeError))) {
+        PyErr_Clear();
+        Py_RETURN_NONE;
+    }
+    return result;
+}
+
+/* New ad break dict starting at segment `index`; steals planned_duration. */
+static PyObject *
+new_ad_break(m3u8_state *ms, PyObject *source, Py_ssize_t index,
+             PyObject *segment, PyObject *scte35, PyObject *planned_duration)
+{
+    if (planned_duration == NULL) {
+        return NULL;
+    }
+    PyObject *ad_break = PyDict_New();
+    PyObject *start = PyLong_FromSsize_t(index);
+    PyObject *zero = PyFloat_FromDouble(0.0);
+    PyObject *pdt = dict_get_interned(segment, ms->str_current_program_date_time);
+    if (ad_break == NULL || start == NULL || zero == NULL ||
+        dict_set_interned(ad_break, ms->str_source, source) < 0 ||
+        dict_set_interned(ad_break, ms->str_id, Py_None) < 0 ||
+        dict_set_interned(ad_break, ms->str_start_segment, start) < 0 ||
+        dict_set_interned(ad_break, ms->str_end_segment, start) < 0 ||
+        dict_set_interned(ad_break, ms->str_planned_duration, planned_duration) < 0 ||
+        dict_set_interned(ad_break, ms->str_duration, zero) < 0 ||
+        dict_set_interned(ad_break, ms->str_elapsed_time, Py_None) < 0 ||
+        dict_set_interned(ad_break, ms->str_program_date_time, pdt ? pdt : Py_None) < 0 ||
+        dict_set_interned(ad_break, ms->str_scte35, scte35 ? scte35 : Py_None) < 0 ||
+        dict_set_interned(ad_break, ms->str_oatcls_scte35, Py_None) < 0 ||
+        dict_set_interned(ad_break, ms->str_asset_metadata, Py_None) < 0 ||
+        dict_set_interned(ad_break, ms->str_scte35_in, Py_None) < 0 ||
+        dict_set_interned(ad_break, ms->str_complete, Py_False) < 0) {
+        Py_CLEAR(ad_break);
+    }
+    Py_XDECREF(start);
+    Py_XDECREF(zero);
+    Py_DECREF(planned_duration);
+    return ad_break;
+}
+
+/*
+ * Append a new break to data["ad_breaks"] and, unless open_breaks is NULL,
+ * to the open list; steals it.
+ */
+static int
+open_ad_break(m3u8_state *ms, PyObject *data, PyObject *open_breaks,
+              PyObject *ad_break)
+{
+    if (ad_break == NULL) {
+        return -1;
+    }
+    PyObject *ad_breaks = dict_get_interned(data, ms->str_ad_breaks);
+    int rc = (ad_breaks != NULL ? PyList_Append(ad_breaks, ad_break) : 0);
+    if (rc == 0 && open_breaks != NULL) {
+        rc = PyList_Append(open_breaks, ad_break);
+    }
+    Py_DECREF(ad_break);
+    return rc;
+}
+
+/* Whether data["ad_breaks"] has a DATERANGE break with this ID; -1 on error. */
+static int
+daterange_break_seen(m3u8_state *ms, PyObject *data, PyObject *daterange_id)
+{
+    PyObject *ad_breaks = dict_get_interned(data, ms->str_ad_breaks);
+    Py_ssize_t count = ad_breaks ? PyList_Size(ad_breaks) : 0;
+    for (Py_ssize_t i = 0; i < count; i++) {
+        PyObject *ad_break = PyList_GetItem(ad_breaks, i);
+        PyObject *source = PyDict_GetItem(ad_break, ms->str_source);
+        PyObject *id = PyDict_GetItem(ad_break, ms->str_id);
+        int match = source ? PyObject_RichCompareBool(source, ms->str_daterange, Py_EQ) : 0;
+        if (match > 0) {
+            match = PyObject_RichCompareBool(id ? id : Py_None, daterange_id, Py_EQ);
+        }
+        if (match != 0) {
+            return match;
+        }
+    }
+    return 0;
+}
+
+/* Whether dict[key] is truthy; -1 on error. */
+static int
+dict_item_true(PyObject *dict, PyObject *key)
+{
+    PyObject *value = dict_get_interned(dict, key);
+    return value == NULL ? 0 : PyObject_IsTrue(value);
+}
+
+/*
+ * Extend data["ad_breaks"] with the segment just appended, as
+ * parser._track_ad_breaks does: CUE-OUT/CONT open a "cue" break and CUE-IN
+ * closes it, DATERANGE SCTE35-OUT/IN open and close "daterange" breaks by
+ * ID. Open breaks live in state["open_ad_breaks"] so that handlers which
+ * reset the state reset them too.
+ * Returns 0 on success, -1 with an exception set.
+ */
+static int
+track_ad_breaks(m3u8_state *ms, PyObject *data, PyObject *state,
+                PyObject *segment, int cue_out)
+{
+    PyObject *segments = dict_get_interned(data, ms->str_segments);
+    Py_ssize_t index = segments ? PyList_Size(segments) - 1 : 0;
+    PyObject *open_breaks = dict_get_interned(state, ms->str_open_ad_breaks);
+    if (open_breaks != NULL && PyList_Check(open_breaks)) {
+        Py_INCREF(open_breaks);
+    } else if ((open_breaks = PyList_New(0)) == NULL) {
+        return -1;
+    }
+
+    Py_ssize_t cue = -1;
+    for (Py_ssize_t i = 0; i < PyList_Size(open_breaks); i++) {
+        PyObject *source = PyDict_GetItem(PyList_GetItem(open_breaks, i), ms->str_source);
+        int is_cue = source ? PyObject_RichCompareBool(source, ms->str_cue, Py_EQ) : 0;
+        if (is_cue < 0) {
+            goto fail;
+        }
+        if (is_cue) {
+            cue = i;
+            break;
+        }
+    }
+
+    int cue_in = dict_item_true(segment, ms->str_cue_in);
+    int cue_out_start = dict_item_true(segment, ms->str_cue_out_start);
+    if (cue_in < 0 || cue_out_start < 0) {
+        goto fail;
+    }
+    if (cue_in && cue >= 0) {
+        if (PyDict_SetItem(PyList_GetItem(open_breaks, cue), ms->str_complete, Py_True) < 0 ||
+            PyList_SetSlice(open_breaks, cue, cue + 1, NULL) < 0) {
+            goto fail;
+        }
+        cue = -1;
+    }
+    if (cue_out_start || (cue_out && cue < 0)) {
+        /* A new CUE-OUT without CUE-IN leaves the previous break open-ended */
+        if (cue >= 0 && PyList_SetSlice(open_breaks, cue, cue + 1, NULL) < 0) {
+            goto fail;
+        }
+        PyObject *ad_break = new_ad_break(
+            ms, ms->str_cue, index, segment,
+            dict_get_interned(segment, ms->str_scte35),
+            float_or_none(dict_get_interned(segment, ms->str_scte35_duration)));
+        if (ad_break == NULL) {
+            goto fail;
+        }
+        PyObject *oatcls = dict_get_interned(segment, ms->str_oatcls_scte35);
+        PyObject *asset = dict_get_interned(segment, ms->str_asset_metadata);
+        if (dict_set_interned(ad_break, ms->str_oatcls_scte35, oatcls ? oatcls : Py_None) < 0 ||
+            dict_set_interned(ad_break, ms->str_asset_metadata, asset ? asset : Py_None) < 0) {
+            Py_DECREF(ad_break);
+            goto fail;
+        }
+        if (!cue_out_start) {
+            PyObject *elapsed = float_or_none(
+                dict_get_interned(segment, ms->str_scte35_elapsedtime));
+            if (elapsed == NULL ||
+                dict_set_interned(ad_break, ms->str_elapsed_time, elapsed) < 0) {
+                Py_XDECREF(elapsed);
+                Py_DECREF(ad_break);
+                goto fail;
+            }
+            Py_DECREF(elapsed);
+        }
+        if (open_ad_break(ms, data, open_breaks, ad_break) < 0) {
+            goto fail;
+        }
+    }
+
+    PyObject *dateranges = dict_get_interned(segment, ms->str_dateranges);
+    int has_dateranges = dateranges ? PyObject_IsTrue(dateranges) : 0;
+    if (has_dateranges < 0) {
+        goto fail;
+    }
+    if (has_dateranges) {
+        PyObject *iter = PyObject_GetIter(dateranges);
+        if (iter == NULL) {
+            goto fail;
+        }
+        PyObject *daterange;
+        while ((daterange = PyIter_Next(iter)) != NULL) {
+            if (!PyDict_Check(daterange)) {
+                Py_DECREF(daterange);
+                continue;
+            }
+            PyObject *daterange_id = PyDict_GetItem(daterange, ms->str_id);
+            if (daterange_id == NULL) {
+                daterange_id = Py_None;
+            }
+            PyObject *scte35_in = PyDict_GetItem(daterange, ms->str_scte35_in);
+            if (scte35_in != NULL && scte35_in != Py_None) {
+                for (Py_ssize_t i = 0; i < PyList_Size(open_breaks); i++) {
+                    PyObject *ad_break = PyList_GetItem(open_breaks, i);
+                    PyObject *source = PyDict_GetItem(ad_break, ms->str_source);
+                    PyObject *id = PyDict_GetItem(ad_break, ms->str_id);
+                    int match = source ? PyObject_RichCompareBool(source, ms->str_daterange, Py_EQ) : 0;
+                    if (match > 0) {
+                        match = PyObject_RichCompareBool(id ? id : Py_None, daterange_id, Py_EQ);
+                    }
+                    if (match < 0 ||
+                        (match && (PyDict_SetItem(ad_break, ms->str_complete, Py_True) < 0 ||
+                                   PyDict_SetItem(ad_break, ms->str_scte35_in, scte35_in) < 0 ||
+                                   PyList_SetSlice(open_breaks, i, i + 1, NULL) < 0))) {
+                        Py_DECREF(daterange);
+                        Py_DECREF(iter);
+                        goto fail;
+                    }
+                    if (match) {
+                        break;
+                    }
+                }
+            }
+            PyObject *scte35_out = PyDict_GetItem(daterange, ms->str_scte35_out);
+            int seen = 0;
+            if (scte35_out != NULL && scte35_out != Py_None &&
+                (seen = daterange_break_seen(ms, data, daterange_id)) < 0) {
+                Py_DECREF(daterange);
+                Py_DECREF(iter);
+                goto fail;
+            }
+            if (scte35_out != NULL && scte35_out != Py_None && !seen) {
+                /* OUT and IN on one tag: a break over this segment alone */
+                int closed = scte35_in != NULL && scte35_in != Py_None;
+                PyObject *planned = PyDict_GetItem(daterange, ms->str_planned_duration);
+                if (planned == NULL || planned == Py_None) {
+                    planned = PyDict_GetItem(daterange, ms->str_duration);
+                }
+                planned = planned ? planned : Py_None;
+                Py_INCREF(planned);
+                PyObject *ad_break = new_ad_break(ms, ms->str_daterange, index,
+                                                  segment, scte35_out, planned);
+                PyObject *segment_duration = dict_get_interned(segment, ms->str_duration);
+                PyObject *zero = NULL;
+                if (closed && segment_duration == NULL) {
+                    segment_duration = zero = PyFloat_FromDouble(0.0);
+                }
+                int rc = (ad_break == NULL ||
+                          dict_set_interned(ad_break, ms->str_id, daterange_id) < 0 ||
+                          (closed &&
+                           (segment_duration == NULL ||
+                            dict_set_interned(ad_break, ms->str_duration, segment_duration) < 0 ||
+                            dict_set_interned(ad_break, ms->str_scte35_in, scte35_in) < 0 ||
+                            dict_set_interned(ad_break, ms->str_complete, Py_True) < 0)))
+                             ? -1 : 0;
+                Py_XDECREF(zero);
+                if (rc < 0 ||
+                    open_ad_break(ms, data, closed ? NULL : open_breaks,
+                                  (Py_INCREF(ad_break), ad_break)) < 0) {
+                    Py_XDECREF(ad_break);
+                    Py_DECREF(daterange);
+                    Py_DECREF(iter);
+                    goto fail;
+                }
+                Py_DECREF(ad_break);
+            }
+            Py_DECREF(daterange);
+        }
+        Py_DECREF(iter);
+        if (PyErr_Occurred()) {
+            goto fail;
+        }
+    }
+
+    PyObject *duration = dict_get_interned(segment, ms->str_duration);
+    PyObject *zero = NULL;
+    if (duration == NULL) {
+        duration = zero = PyFloat_FromDouble(0.0);
+        if (zero == NULL) {
+            goto fail;
+        }
+    }
+    PyObject *end = PyLong_FromSsize_t(index);
+    if (end == NULL) {
+        Py_XDECREF(zero);
+        goto fail;
+    }
+    int rc = 0;
+    for (Py_ssize_t i = 0; rc == 0 && i < PyList_Size(open_breaks); i++) {
+        PyObject *ad_break = PyList_GetItem(open_breaks, i);
+        PyObject *total = PyDict_GetItem(ad_break, ms->str_duration);
+        PyObject *sum = total ? PyNumber_Add(total, duration) : NULL;
+        if (sum == NULL && !PyErr_Occurred()) {
+            PyErr_SetObject(PyExc_KeyError, ms->str_duration);
+        }
+        rc = (sum == NULL ||
+              PyDict_SetItem(ad_break, ms->str_end_segment, end) < 0 ||
+              PyDict_SetItem(ad_break, ms->str_duration, sum) < 0) ? -1 : 0;
+        Py_XDECREF(sum);
+    }
+    Py_DECREF(end);
+    Py_XDECREF(zero);
+    if (rc < 0) {
+        goto fail;
+    }
+    rc = PyList_Size(open_breaks) > 0
+             ? dict_set_interned(state, ms->str_open_ad_breaks, open_breaks)
+             : del_item_interned_ignore_keyerror(state, ms->str_open_ad_breaks);
+    Py_DECREF(open_breaks);
+    return rc;
+
+fail:
+    Py_DECREF(open_breaks);
+    return -1;
+}
+
 /*
  * Parse a segment URI line.
  * Returns 0 on success, -1 on failure with exception set.
@@ -1836,6 +2402,16 @@ parse_ts_chunk(m3u8_state *mod_state, const char *line,
         }
     }
 
+    /* Ad breaks only need work around cue tags, dateranges and open breaks */
+    if (cue_out_truth || dict_get_interned(state, mod_state->str_open_ad_breaks) ||
+        dict_get_interned(segment, mod_state->str_cue_in) == Py_True ||
+        dict_get_interned(segment, mod_state->str_dateranges) != Py_None) {
+        if (track_ad_breaks(mod_state, data, state, segment, cue_out_truth) < 0) {
+            Py_DECREF(segment);
+            return -1;
+        }
+    }
+
     /* Clear expect_segment flag using interned key */
     if (dict_set_interned(state, mod_state->str_expect_segment, Py_False) < 0) {
         Py_DECREF(segment);
@@ -2613,6 +3189,12 @@ static const TagDispatch TAG_DISPATCH[] = {
     {NULL, 0, NULL}
 };
 
+#define NUM_TAG_DISPATCH (sizeof(TAG_DISPATCH) / sizeof(TAG_DISPATCH[0]) - 1)
+_Static_assert(NUM_TAG_DISPATCH <= MAX_TAG_STATS,
+               "MAX_TAG_STATS must cover every TAG_DISPATCH entry");
+_Static_assert(NUM_TAG_DISPATCH <= 64,
+               "ParseContext.tag_mask must cover every TAG_DISPATCH entry");
+
 /*
  * Dispatch a tag to its handler using the dispatch table.
  *
@@ -2637,9 +3219,23 @@ dispatch_tag(ParseContext *ctx, const char *line, size_t line_len)
             /* Verify tag boundary: must end with ':' or be complete line */
             char next = line[d->tag_len];
             if (next == ':' || next == '\0') {
+                if (!(ctx->tag_mask & ((uint64_t)1 << (d - TAG_DISPATCH)))) {
+                    /* Projected out: recognized, not parsed. EXT-X-PART and
+                     * EXT-X-BITRATE still open their segment, so a trailing
+                     * partial segment is kept whatever the fields. */
+                    if ((d->handler == handle_part || d->handler == handle_bitrate)
+                        && get_or_create_segment(ctx->mod_state, ctx->state) == NULL) {
+                        return -1;
+                    }
+                    return 1;
+                }
+                uint64_t t0 = ctx->stats ? monotonic_ns() : 0;
                 if (d->handler(ctx, line) < 0) {
                     return -1;
                 }
+                if (ctx->stats) {
+                    stat_record(&ctx->stats->tags[d - TAG_DISPATCH], t0);
+                }
                 return 1;  /* Handled */
             }
         }
@@ -2648,32 +3244,565 @@ dispatch_tag(ParseContext *ctx, const char *line, size_t line_len)
 }
 
 /*
- * Main parse function.
- *
- * Parse M3U8 playlist content and return a dictionary with all data found.
- *
- * Args:
- *     content: The M3U8 playlist content as a string.
- *     strict: If True, raise exceptions for syntax errors (default: False).
- *     custom_tags_parser: Optional callable for parsing custom tags.
+ * Field projection (mirrors PROJECTION_FIELDS in parser.py).
  *
- * Returns:
- *     A dictionary containing the parsed playlist data.
+ * Each output field lists the tags whose handlers can change it; a name
+ * also selects every field it is a dotted prefix of ("segments"). Fields
+ * with no tags are always produced, and STRUCTURAL_TAGS always run since
+ * they decide which URI lines become segments or variants.
  */
-static PyObject *
-m3u8_parse(PyObject *module, PyObject *args, PyObject *kwargs)
-{
-    const char *content;
-    Py_ssize_t content_len;  /* Get size directly - enables zero-copy parsing */
-    int strict = 0;
-    PyObject *custom_tags_parser = Py_None;
+typedef struct {
+    const char *name;
+    const char *tags[10];  /* NULL-terminated */
+} ProjectionField;
+
+#define CUE_TAGS EXT_X_CUE_OUT, EXT_X_CUE_OUT_CONT, EXT_X_CUE_IN, \
+                 EXT_X_CUE_SPAN, EXT_OATCLS_SCTE35, EXT_X_ASSET
+
+static const ProjectionField PROJECTION_FIELDS[] = {
+    {"media_sequence",             {EXT_X_MEDIA_SEQUENCE}},
+    {"is_variant",                 {NULL}},
+    {"is_endlist",                 {EXT_X_ENDLIST}},
+    {"is_i_frames_only",           {EXT_I_FRAMES_ONLY}},
+    {"is_independent_segments",    {EXT_IS_INDEPENDENT_SEGMENTS}},
+    {"is_images_only",             {EXT_X_IMAGES_ONLY}},
+    {"playlist_type",              {EXT_X_PLAYLIST_TYPE}},
+    {"targetduration",             {EXT_X_TARGETDURATION}},
+    {"discontinuity_sequence",     {EXT_X_DISCONTINUITY_SEQUENCE}},
+    {"version",                    {EXT_X_VERSION}},
+    {"allow_cache",                {EXT_X_ALLOW_CACHE}},
+    {"program_date_time",          {EXT_X_PROGRAM_DATE_TIME}},
+    {"bitrate",                    {EXT_X_BITRATE}},
+    {"playlists",                  {NULL}},
+    {"iframe_playlists",           {EXT_X_I_FRAME_STREAM_INF}},
+    {"image_playlists",            {EXT_X_IMAGE_STREAM_INF}},
+    {"tiles",                      {EXT_X_TILES}},
+    {"media",                      {EXT_X_MEDIA}},
+    {"keys",                       {EXT_X_KEY}},
+    {"rendition_reports",          {EXT_X_RENDITION_REPORT}},
+    {"skip",                       {EXT_X_SKIP}},
+    {"part_inf",                   {EXT_X_PART_INF}},
+    {"session_data",               {EXT_X_SESSION_DATA}},
+    {"session_keys",               {EXT_X_SESSION_KEY}},
+    {"segment_map",                {EXT_X_MAP}},
+    {"start",                      {EXT_X_START}},
+    {"server_control",             {EXT_X_SERVER_CONTROL}},
+    {"preload_hint",               {EXT_X_PRELOAD_HINT}},
+    {"content_steering",           {EXT_X_CONTENT_STEERING}},
+    {"segments.uri",               {NULL}},
+    {"segments.duration",          {NULL}},
+    {"segments.title",             {NULL}},
+    {"segments.byterange",         {NULL}},
+    {"segments.bitrate",           {EXT_X_BITRATE}},
+    {"segments.program_date_time", {EXT_X_PROGRAM_DATE_TIME}},
+    {"segments.current_program_date_time", {EXT_X_PROGRAM_DATE_TIME, EXT_X_PART}},
+    {"segments.discontinuity",     {EXT_X_DISCONTINUITY}},
+    {"segments.cue_in",            {CUE_TAGS}},
+    {"segments.cue_out",           {CUE_TAGS}},
+    {"segments.cue_out_start",     {CUE_TAGS}},
+    {"segments.cue_out_explicitly_duration", {CUE_TAGS}},
+    {"segments.scte35",            {CUE_TAGS}},
+    {"segments.oatcls_scte35",     {CUE_TAGS}},
+    {"segments.scte35_duration",   {CUE_TAGS}},
+    {"segments.scte35_elapsedtime", {CUE_TAGS}},
+    {"segments.asset_metadata",    {CUE_TAGS}},
+    {"segments.key",               {EXT_X_KEY}},
+    {"segments.init_section",      {EXT_X_MAP}},
+    {"segments.dateranges",        {EXT_X_DATERANGE, EXT_X_PART}},
+    {"segments.gap_tag",           {EXT_X_GAP, EXT_X_PART}},
+    {"segments.blackout",          {EXT_X_BLACKOUT}},
+    {"segments.parts",             {EXT_X_PART, EXT_X_PROGRAM_DATE_TIME,
+                                    EXT_X_DATERANGE, EXT_X_GAP}},
+    {"ad_breaks",                  {CUE_TAGS, EXT_X_DATERANGE, EXT_X_PART,
+                                    EXT_X_PROGRAM_DATE_TIME}},
+    {NULL, {NULL}}
+};
 
-    static char *kwlist[] = {"content", "strict", "custom_tags_parser", NULL};
+#undef CUE_TAGS
 
-    /* Use s# to get pointer AND size directly from Python string object */
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s#|pO", kwlist,
-                                     &content, &content_len, &strict, &custom_tags_parser)) {
-        return NULL;
+static const char *const STRUCTURAL_TAGS[] = {
+    EXTINF, EXT_X_BYTERANGE, EXT_X_STREAM_INF, NULL
+};
+
+static uint64_t
+tag_dispatch_bit(const char *tag)
+{
+    for (const TagDispatch *d = TAG_DISPATCH; d->tag != NULL; d++) {
+        if (strcmp(d->tag, tag) == 0) {
+            return (uint64_t)1 << (d - TAG_DISPATCH);
+        }
+    }
+    return 0;
+}
+
+/*
+ * Compute ParseContext.tag_mask for the `fields` argument of parse().
+ * None parses every tag. Returns 0 on success, -1 with an exception set.
+ */
+static int
+projection_tag_mask(PyObject *fields, uint64_t *mask)
+{
+    if (fields == Py_None) {
+        *mask = ~(uint64_t)0;
+        return 0;
+    }
+    if (PyUnicode_Check(fields)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "fields must be an iterable of field names, not str");
+        return -1;
+    }
+    PyObject *iter = PyObject_GetIter(fields);
+    if (iter == NULL) {
+        return -1;
+    }
+    uint64_t result = 0;
+    for (const char *const *t = STRUCTURAL_TAGS; *t != NULL; t++) {
+        result |= tag_dispatch_bit(*t);
+    }
+    PyObject *item;
+    while ((item = PyIter_Next(iter)) != NULL) {
+        if (!PyUnicode_Check(item)) {
+            PyErr_SetString(PyExc_TypeError, "fields must be str");
+            Py_DECREF(item);
+            Py_DECREF(iter);
+            return -1;
+        }
+        Py_ssize_t len;
+        const char *name = PyUnicode_AsUTF8AndSize(item, &len);
+        if (name == NULL) {
+            Py_DECREF(item);
+            Py_DECREF(iter);
+            return -1;
+        }
+        int matched = 0;
+        for (const ProjectionField *f = PROJECTION_FIELDS; f->name != NULL; f++) {
+            size_t name_len = strlen(f->name);
+            if (name_len < (size_t)len || memcmp(f->name, name, (size_t)len) != 0 ||
+                (f->name[len] != '\0' && f->name[len] != '.')) {
+                continue;
+            }
+            for (const char *const *t = f->tags; *t != NULL; t++) {
+                result |= tag_dispatch_bit(*t);
+            }
+            matched = 1;
+        }
+        if (!matched) {
+            PyErr_Format(PyExc_ValueError, "unknown field %R", item);
+            Py_DECREF(item);
+            Py_DECREF(iter);
+            return -1;
+        }
+        Py_DECREF(item);
+    }
+    Py_DECREF(iter);
+    if (PyErr_Occurred()) {
+        return -1;
+    }
+    *mask = result;
+    return 0;
+}
+
+/*
+ * Registered custom tag handlers: {tag: callable or CustomTagSchema}.
+ *
+ * Built once per parse() call from the mapping's items(). Callables are
+ * invoked like custom_tags_parser; CustomTagSchema instances are applied
+ * here without calling back into Python. Entries borrow from objects kept
+ * alive by the owned items and refs lists.
+ */
+typedef struct {
+    const char *tag;         /* UTF-8, borrowed from the key str */
+    Py_ssize_t tag_len;
+    PyObject *handler;       /* Callable, or NULL for a schema */
+    /* Schema fields (handler == NULL) */
+    AttrParser *attrs;       /* Owned array, names borrowed from refs */
+    size_t num_attrs;
+    PyObject *name;          /* Destination key, NULL for the tag name */
+    int to_segment;          /* 1: segment custom_parser_values, 0: data */
+    int multiple;            /* Append to a list instead of replacing */
+} CustomTagHandler;
+
+typedef struct {
+    PyObject *items;         /* Owned list of (tag, handler) tuples */
+    PyObject *refs;          /* Owned list keeping schema fields alive */
+    CustomTagHandler *entries;
+    Py_ssize_t count;
+} CustomTagHandlers;
+
+static void
+custom_tag_handlers_clear(CustomTagHandlers *handlers)
+{
+    for (Py_ssize_t i = 0; i < handlers->count; i++) {
+        PyMem_Free(handlers->entries[i].attrs);
+    }
+    PyMem_Free(handlers->entries);
+    Py_CLEAR(handlers->items);
+    Py_CLEAR(handlers->refs);
+    handlers->entries = NULL;
+    handlers->count = 0;
+}
+
+/*
+ * Fill the schema fields of entry from a CustomTagSchema instance.
+ * Returns 0 on success, -1 with an exception set.
+ */
+static int
+load_custom_tag_schema(CustomTagHandler *entry, PyObject *schema, PyObject *refs)
+{
+    PyObject *types = PyObject_GetAttrString(schema, "attribute_types");
+    if (types == NULL) {
+        return -1;
+    }
+    int rc = PyList_Append(refs, types);
+    Py_DECREF(types);
+    if (rc < 0) {
+        return -1;
+    }
+    if (!PyTuple_Check(types)) {
+        PyErr_SetString(PyExc_TypeError, "attribute_types must be a tuple");
+        return -1;
+    }
+
+    Py_ssize_t n = PyTuple_Size(types);
+    entry->attrs = PyMem_New(AttrParser, n > 0 ? n : 1);
+    if (entry->attrs == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *pair = PyTuple_GetItem(types, i);
+        PyObject *attr_name = NULL;
+        PyObject *attr_type = NULL;
+        if (pair != NULL && PyTuple_Check(pair) && PyTuple_Size(pair) == 2) {
+            attr_name = PyTuple_GetItem(pair, 0);
+            attr_type = PyTuple_GetItem(pair, 1);
+        }
+        if (attr_name == NULL || !PyUnicode_Check(attr_name) ||
+            attr_type == NULL || !PyLong_Check(attr_type)) {
+            PyErr_SetString(PyExc_TypeError,
+                            "attribute_types must contain (str, int) pairs");
+            return -1;
+        }
+        long type = PyLong_AsLong(attr_type);
+        if (type < ATTR_STRING || type > ATTR_BANDWIDTH) {
+            if (!PyErr_Occurred()) {
+                PyErr_Format(PyExc_ValueError,
+                             "unknown attribute type %ld for %R", type, attr_name);
+            }
+            return -1;
+        }
+        entry->attrs[i].name = PyUnicode_AsUTF8AndSize(attr_name, NULL);
+        if (entry->attrs[i].name == NULL) {
+            return -1;
+        }
+        entry->attrs[i].type = (AttrType)type;
+    }
+    entry->num_attrs = (size_t)n;
+
+    PyObject *destination = PyObject_GetAttrString(schema, "destination");
+    if (destination == NULL) {
+        return -1;
+    }
+    entry->to_segment = PyUnicode_Check(destination) &&
+        PyUnicode_CompareWithASCIIString(destination, "segment") == 0;
+    Py_DECREF(destination);
+
+    PyObject *multiple = PyObject_GetAttrString(schema, "multiple");
+    if (multiple == NULL) {
+        return -1;
+    }
+    entry->multiple = PyObject_IsTrue(multiple);
+    Py_DECREF(multiple);
+    if (entry->multiple < 0) {
+        return -1;
+    }
+
+    PyObject *name = PyObject_GetAttrString(schema, "name");
+    if (name == NULL) {
+        return -1;
+    }
+    rc = PyList_Append(refs, name);
+    Py_DECREF(name);
+    if (rc < 0) {
+        return -1;
+    }
+    entry->name = (name == Py_None) ? NULL : name;
+    return 0;
+}
+
+/*
+ * Populate handlers from a {tag: handler} mapping (None for no handlers).
+ * Returns 0 on success, -1 with an exception set.
+ */
+static int
+custom_tag_handlers_init(CustomTagHandlers *handlers, m3u8_state *mod_state,
+                         PyObject *mapping)
+{
+    handlers->items = NULL;
+    handlers->refs = NULL;
+    handlers->entries = NULL;
+    handlers->count = 0;
+    if (mapping == Py_None) {
+        return 0;
+    }
+
+    PyObject *items = PyMapping_Items(mapping);
+    if (items == NULL) {
+        return -1;
+    }
+    handlers->items = items;
+    Py_ssize_t n = PyList_Size(items);
+    if (n <= 0) {
+        return n < 0 ? -1 : 0;
+    }
+    handlers->refs = PyList_New(0);
+    handlers->entries = PyMem_New(CustomTagHandler, n);
+    if (handlers->refs == NULL || handlers->entries == NULL) {
+        if (!PyErr_Occurred()) {
+            PyErr_NoMemory();
+        }
+        goto fail;
+    }
+    for (Py_ssize_t i = 0; i < n; i++) {
+        CustomTagHandler *entry = &handlers->entries[i];
+        memset(entry, 0, sizeof(*entry));
+        handlers->count = i + 1;  /* clear() frees entries up to here */
+
+        PyObject *item = PyList_GetItem(items, i);
+        PyObject *tag = item ? PyTuple_GetItem(item, 0) : NULL;
+        PyObject *handler = item ? PyTuple_GetItem(item, 1) : NULL;
+        if (tag == NULL || handler == NULL) {
+            goto fail;
+        }
+        if (!PyUnicode_Check(tag)) {
+            PyErr_SetString(PyExc_TypeError,
+                            "custom_tag_handlers keys must be str");
+            goto fail;
+        }
+        entry->tag = PyUnicode_AsUTF8AndSize(tag, &entry->tag_len);
+        if (entry->tag == NULL) {
+            goto fail;
+        }
+
+        int is_schema = 0;
+        /* Resolved by resolve_parser_objects() before any parse */
+        if (mod_state->CustomTagSchema != NULL) {
+            is_schema = PyObject_IsInstance(handler, mod_state->CustomTagSchema);
+            if (is_schema < 0) {
+                goto fail;
+            }
+        }
+        if (is_schema) {
+            if (load_custom_tag_schema(entry, handler, handlers->refs) < 0) {
+                goto fail;
+            }
+        } else if (PyCallable_Check(handler)) {
+            entry->handler = handler;
+        } else {
+            PyErr_Format(PyExc_TypeError,
+                         "custom_tag_handlers[%R] is not callable", tag);
+            goto fail;
+        }
+    }
+    return 0;
+
+fail:
+    custom_tag_handlers_clear(handlers);
+    return -1;
+}
+
+/*
+ * Handler registered for the tag of line, or NULL. As in dispatch_tag, the
+ * tag runs up to the first ':' or the end of the line, so a handler for
+ * #EXT-X-AD does not claim #EXT-X-AD-MARKER.
+ */
+static inline const CustomTagHandler *
+custom_tag_handlers_match(const CustomTagHandlers *handlers,
+                          const char *line, Py_ssize_t line_len)
+{
+    for (Py_ssize_t i = 0; i < handlers->count; i++) {
+        const CustomTagHandler *entry = &handlers->entries[i];
+        Py_ssize_t len = entry->tag_len;
+        if (len <= line_len &&
+            (len == line_len || line[len] == ':') &&
+            memcmp(line, entry->tag, (size_t)len) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Apply a CustomTagSchema to a matched line.
+ *
+ * The attribute list after the first ':' is parsed with the schema's types
+ * (unlisted attributes stay raw strings) and stored under the schema name,
+ * or the normalized tag name, in either the pending segment's
+ * custom_parser_values or the top-level data dict.
+ *
+ * Returns 0 on success, -1 on error.
+ */
+static int
+apply_custom_tag_schema(ParseContext *ctx, const CustomTagHandler *entry,
+                        const char *line, Py_ssize_t line_len)
+{
+    m3u8_state *mod_state = ctx->mod_state;
+    const char *end = line + line_len;
+    const char *colon = memchr(line, ':', (size_t)line_len);
+
+    PyObject *attrs = colon
+        ? parse_attributes_with_schema(colon + 1, end, entry->attrs, entry->num_attrs)
+        : PyDict_New();
+    if (attrs == NULL) {
+        return -1;
+    }
+
+    PyObject *name = entry->name
+        ? Py_NewRef(entry->name)
+        : create_normalized_key(line + 1, (colon ? colon : end) - (line + 1));
+    if (name == NULL) {
+        Py_DECREF(attrs);
+        return -1;
+    }
+
+    /* Resolve the target dict (borrowed) */
+    PyObject *target = ctx->data;
+    if (entry->to_segment) {
+        PyObject *segment = get_or_create_segment(mod_state, ctx->state);
+        if (segment == NULL) {
+            goto fail;
+        }
+        target = dict_get_interned(segment, mod_state->str_custom_parser_values);
+        if (target == NULL) {
+            PyObject *values = PyDict_New();
+            if (values == NULL) {
+                goto fail;
+            }
+            int rc = dict_set_interned(segment, mod_state->str_custom_parser_values, values);
+            Py_DECREF(values);
+            if (rc < 0) {
+                goto fail;
+            }
+            target = values;
+        }
+    }
+
+    int rc;
+    if (entry->multiple) {
+        PyObject *list;
+        if (dict_get_ref(target, name, &list) < 0) {
+            goto fail;
+        }
+        if (list == NULL || !PyList_Check(list)) {
+            Py_XDECREF(list);
+            list = PyList_New(0);
+            if (list == NULL) {
+                goto fail;
+            }
+            if (PyDict_SetItem(target, name, list) < 0) {
+                Py_DECREF(list);
+                goto fail;
+            }
+        }
+        rc = PyList_Append(list, attrs);
+        Py_DECREF(list);
+    } else {
+        rc = PyDict_SetItem(target, name, attrs);
+    }
+    if (rc < 0) {
+        goto fail;
+    }
+    Py_DECREF(name);
+    Py_DECREF(attrs);
+    return 0;
+
+fail:
+    Py_DECREF(name);
+    Py_DECREF(attrs);
+    return -1;
+}
+
+/*
+ * Early-exit modes for parse(until=...). Both stop at the first media
+ * segment URI line; variant URIs never stop the parse, so a master
+ * playlist is always read to the end.
+ */
+typedef enum {
+    UNTIL_END,            /* None: parse everything */
+    UNTIL_HEADER,         /* "header": stop before the first segment */
+    UNTIL_FIRST_SEGMENT,  /* "first_segment": stop after it */
+} ParseUntil;
+
+static int
+parse_until_mode(PyObject *until, ParseUntil *mode)
+{
+    if (until == Py_None) {
+        *mode = UNTIL_END;
+    } else if (PyUnicode_Check(until) &&
+               PyUnicode_CompareWithASCIIString(until, "header") == 0) {
+        *mode = UNTIL_HEADER;
+    } else if (PyUnicode_Check(until) &&
+               PyUnicode_CompareWithASCIIString(until, "first_segment") == 0) {
+        *mode = UNTIL_FIRST_SEGMENT;
+    } else {
+        PyErr_Format(PyExc_ValueError,
+                     "until must be None, 'header' or 'first_segment', not %R",
+                     until);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Main parse function.
+ *
+ * Parse M3U8 playlist content and return a dictionary with all data found.
+ *
+ * Args:
+ *     content: The M3U8 playlist content as a string.
+ *     strict: If True, raise exceptions for syntax errors (default: False).
+ *     custom_tags_parser: Optional callable for parsing custom tags.
+ *     custom_tag_handlers: Optional {prefix: callable} mapping. A handler is
+ *         only called for lines starting with its prefix; other lines pay
+ *         no callback or state-sync cost.
+ *     fields: Optional iterable of output field names (see
+ *         PROJECTION_FIELDS); tags that cannot affect them are skipped.
+ *     until: None, "header" or "first_segment"; see ParseUntil.
+ *
+ * Returns:
+ *     A dictionary containing the parsed playlist data.
+ */
+static PyObject *
+m3u8_parse(PyObject *module, PyObject *args, PyObject *kwargs)
+{
+    const char *content;
+    Py_ssize_t content_len;  /* Get size directly - enables zero-copy parsing */
+    int strict = 0;
+    PyObject *custom_tags_parser = Py_None;
+    PyObject *custom_tag_handlers = Py_None;
+    PyObject *fields = Py_None;
+    PyObject *until_arg = Py_None;
+    uint64_t tag_mask;
+    ParseUntil until;
+
+    static char *kwlist[] = {"content", "strict", "custom_tags_parser",
+                             "custom_tag_handlers", "fields", "until", NULL};
+
+    /* Use s# to get pointer AND size directly from Python string object */
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s#|pOOOO", kwlist,
+                                     &content, &content_len, &strict,
+                                     &custom_tags_parser, &custom_tag_handlers,
+                                     &fields, &until_arg)) {
+        return NULL;
+    }
+    if (parse_until_mode(until_arg, &until) < 0) {
+        return NULL;
+    }
+    if (projection_tag_mask(fields, &tag_mask) < 0) {
+        return NULL;
+    }
+    if (custom_tags_parser != Py_None && !PyCallable_Check(custom_tags_parser)) {
+        custom_tags_parser = Py_None;  /* parser.py ignores non-callables */
     }
 
     /*
@@ -2695,9 +3824,21 @@ m3u8_parse(PyObject *module, PyObject *args, PyObject *kwargs)
 
     /* Get module state for cached objects */
     m3u8_state *mod_state = get_m3u8_state(module);
+    if (resolve_parser_objects(mod_state) < 0) {
+        return NULL;
+    }
+    ParseStats local_stats;  /* Merged into mod_state->stats on exit */
+    ParseStats *stats = NULL;
+    if (STATS_ENABLED(mod_state)) {
+        memset(&local_stats, 0, sizeof(local_stats));
+        stats = &local_stats;
+    }
+    uint64_t parse_t0 = stats ? monotonic_ns() : 0;
+    uint64_t t0;
 
     /* Check strict mode validation */
     if (strict) {
+        t0 = stats ? monotonic_ns() : 0;
         /* Import and call version_matching.validate */
         PyObject *version_matching = PyImport_ImportModule("openm3u8.version_matching");
         if (version_matching == NULL) {
@@ -2730,9 +3871,13 @@ m3u8_parse(PyObject *module, PyObject *args, PyObject *kwargs)
             return NULL;
         }
         Py_DECREF(errors);
+        if (stats) {
+            stat_record(&stats->categories[STAT_STRICT_VALIDATION], t0);
+        }
     }
 
     /* Initialize result data dict using interned strings */
+    t0 = stats ? monotonic_ns() : 0;
     PyObject *data = init_parse_data(mod_state);
     if (data == NULL) {
         return NULL;
@@ -2744,6 +3889,9 @@ m3u8_parse(PyObject *module, PyObject *args, PyObject *kwargs)
         Py_DECREF(data);
         return NULL;
     }
+    if (stats) {
+        stat_record(&stats->categories[STAT_SETUP], t0);
+    }
 
     /*
      * Set up parse context with shadow state.
@@ -2757,6 +3905,8 @@ m3u8_parse(PyObject *module, PyObject *args, PyObject *kwargs)
         .lineno = 0,
         .expect_segment = 0,   /* Matches init_parse_state */
         .expect_playlist = 0,  /* Matches init_parse_state */
+        .stats = stats,
+        .tag_mask = tag_mask,
     };
 
     /*
@@ -2767,10 +3917,18 @@ m3u8_parse(PyObject *module, PyObject *args, PyObject *kwargs)
     const char *p = trimmed;
     const char *end = trimmed + trimmed_len;
 
+    CustomTagHandlers handlers;
+    if (custom_tag_handlers_init(&handlers, mod_state, custom_tag_handlers) < 0) {
+        Py_DECREF(data);
+        Py_DECREF(state);
+        return NULL;
+    }
+
     /* Reusable line buffer - starts small, grows as needed */
     size_t line_buf_size = 256;
     char *line_buf = PyMem_Malloc(line_buf_size);
     if (line_buf == NULL) {
+        custom_tag_handlers_clear(&handlers);
         Py_DECREF(data);
         Py_DECREF(state);
         return PyErr_NoMemory();
@@ -2818,10 +3976,8 @@ m3u8_parse(PyObject *module, PyObject *args, PyObject *kwargs)
             line_buf_size = (size_t)line_len + 1;
             char *new_buf = PyMem_Realloc(line_buf, line_buf_size);
             if (new_buf == NULL) {
-                PyMem_Free(line_buf);
-                Py_DECREF(data);
-                Py_DECREF(state);
-                return PyErr_NoMemory();
+                PyErr_NoMemory();
+                goto error;
             }
             line_buf = new_buf;
         }
@@ -2832,57 +3988,45 @@ m3u8_parse(PyObject *module, PyObject *args, PyObject *kwargs)
         char *stripped = line_buf;
 
         /* Call custom tags parser if provided */
-        if (stripped[0] == '#' && custom_tags_parser != Py_None && PyCallable_Check(custom_tags_parser)) {
-            /* Sync shadow state to dict before callback (so it sees current state) */
-            if (sync_shadow_to_dict(&ctx) < 0) {
-                PyMem_Free(line_buf);
-                Py_DECREF(data);
-                Py_DECREF(state);
-                return NULL;
-            }
-            PyObject *py_line = PyUnicode_FromString(stripped);
-            PyObject *py_lineno = PyLong_FromLong(ctx.lineno);
-            if (py_line == NULL || py_lineno == NULL) {
-                Py_XDECREF(py_line);
-                Py_XDECREF(py_lineno);
-                PyMem_Free(line_buf);
-                Py_DECREF(data);
-                Py_DECREF(state);
-                return NULL;
-            }
-            PyObject *call_args = PyTuple_Pack(4, py_line, py_lineno, data, state);
-            Py_DECREF(py_line);
-            Py_DECREF(py_lineno);
-            if (call_args == NULL) {
-                PyMem_Free(line_buf);
-                Py_DECREF(data);
-                Py_DECREF(state);
-                return NULL;
-            }
-            PyObject *result = PyObject_Call(custom_tags_parser, call_args, NULL);
-            Py_DECREF(call_args);
-            if (!result) {
-                PyMem_Free(line_buf);
-                Py_DECREF(data);
-                Py_DECREF(state);
-                return NULL;
+        if (stripped[0] == '#' && custom_tags_parser != Py_None) {
+            t0 = stats ? monotonic_ns() : 0;
+            int handled = call_tag_callback(&ctx, custom_tags_parser, stripped);
+            if (handled < 0) {
+                goto error;
             }
-            /* Sync shadow state from dict (callback may have modified it) */
-            sync_shadow_from_dict(&ctx);
-            int truth = PyObject_IsTrue(result);
-            Py_DECREF(result);
-            if (truth < 0) {
-                PyMem_Free(line_buf);
-                Py_DECREF(data);
-                Py_DECREF(state);
-                return NULL;
+            if (stats) {
+                stat_record(&stats->categories[STAT_CUSTOM_TAGS_PARSER], t0);
             }
-            if (truth) {
+            if (handled) {
                 /* p has already been advanced to the next line at the top of the loop */
                 continue;
             }
         }
 
+        /* Registered handlers only see (and sync state for) lines they claim */
+        if (stripped[0] == '#' && handlers.count > 0) {
+            const CustomTagHandler *entry =
+                custom_tag_handlers_match(&handlers, stripped, line_len);
+            if (entry != NULL) {
+                t0 = stats ? monotonic_ns() : 0;
+                int handled = 1;  /* Schemas always claim the line */
+                if (entry->handler != NULL) {
+                    handled = call_tag_callback(&ctx, entry->handler, stripped);
+                } else if (apply_custom_tag_schema(&ctx, entry, stripped, line_len) < 0) {
+                    handled = -1;
+                }
+                if (handled < 0) {
+                    goto error;
+                }
+                if (stats) {
+                    stat_record(&stats->categories[STAT_CUSTOM_TAG_HANDLERS], t0);
+                }
+                if (handled) {
+                    continue;
+                }
+            }
+        }
+
         if (stripped[0] == '#') {
             /*
              * Tag dispatch using data-driven table lookup.
@@ -2896,55 +4040,59 @@ m3u8_parse(PyObject *module, PyObject *args, PyObject *kwargs)
             }
 
             /* Dispatch to handler via table lookup */
+            t0 = stats ? monotonic_ns() : 0;
             int dispatch_result = dispatch_tag(&ctx, stripped, line_len);
             if (dispatch_result < 0) {
                 /* Handler returned error */
-                PyMem_Free(line_buf);
-                Py_DECREF(data);
-                Py_DECREF(state);
-                return NULL;
+                goto error;
             }
             if (dispatch_result == 0) {
+                if (stats) {
+                    stat_record(&stats->categories[STAT_UNKNOWN_TAGS], t0);
+                }
                 /* Unknown tag - error in strict mode */
                 if (ctx.strict) {
                     raise_parse_error(mod_state, ctx.lineno, stripped);
-                    PyMem_Free(line_buf);
-                    Py_DECREF(data);
-                    Py_DECREF(state);
-                    return NULL;
+                    goto error;
                 }
             }
         } else {
             /* Non-comment line - segment or playlist URI */
             /* Use shadow state for hot path checks (no dict lookups) */
+            t0 = stats ? monotonic_ns() : 0;
             if (ctx.expect_segment) {
+                if (until == UNTIL_HEADER) {
+                    /* Drop the pending first segment and stop */
+                    if (PyDict_DelItem(state, mod_state->str_segment) < 0) {
+                        PyErr_Clear();
+                    }
+                    break;
+                }
                 if (parse_ts_chunk(mod_state, stripped, data, state) < 0) {
-                    PyMem_Free(line_buf);
-                    Py_DECREF(data);
-                    Py_DECREF(state);
-                    return NULL;
+                    goto error;
                 }
                 ctx.expect_segment = 0;  /* parse_ts_chunk clears this */
+                if (until == UNTIL_FIRST_SEGMENT) {
+                    break;
+                }
             } else if (ctx.expect_playlist) {
                 if (parse_variant_playlist(mod_state, stripped, data, state) < 0) {
-                    PyMem_Free(line_buf);
-                    Py_DECREF(data);
-                    Py_DECREF(state);
-                    return NULL;
+                    goto error;
                 }
                 ctx.expect_playlist = 0;  /* parse_variant_playlist clears this */
             } else if (strict) {
                 raise_parse_error(mod_state, ctx.lineno, stripped);
-                PyMem_Free(line_buf);
-                Py_DECREF(data);
-                Py_DECREF(state);
-                return NULL;
+                goto error;
+            }
+            if (stats) {
+                stat_record(&stats->categories[STAT_URI_LINES], t0);
             }
         }
         /* Loop continues with pointer already advanced */
     }
 
     PyMem_Free(line_buf);
+    custom_tag_handlers_clear(&handlers);
 
     /* Handle remaining partial segment - use interned strings */
     PyObject *segment = dict_get_interned(state, mod_state->str_segment);
@@ -2958,19 +4106,904 @@ m3u8_parse(PyObject *module, PyObject *args, PyObject *kwargs)
     }
 
     Py_DECREF(state);
+    if (stats) {
+        stat_record(&stats->categories[STAT_PARSE], parse_t0);
+        stats_merge(mod_state, stats);
+    }
     return data;
+
+error:
+    PyMem_Free(line_buf);
+    custom_tag_handlers_clear(&handlers);
+    Py_DECREF(data);
+    Py_DECREF(state);
+    if (stats) {
+        stats_merge(mod_state, stats);
+    }
+    return NULL;
 }
 
-/* Module methods */
-static PyMethodDef m3u8_parser_methods[] = {
-    {"parse", (PyCFunction)m3u8_parse, METH_VARARGS | METH_KEYWORDS,
-     PyDoc_STR(
-     "parse(content, strict=False, custom_tags_parser=None)\n"
-     "--\n\n"
-     "Parse M3U8 playlist content and return a dictionary with all data found.\n\n"
-     "This is an optimized C implementation that produces output identical to\n"
-     "the pure Python parser in openm3u8.parser.parse().\n\n"
-     "Parameters\n"
+/*
+ * Module __getattr__ (PEP 562): ParseError is resolved lazily.
+ */
+static PyObject *
+m3u8_getattr(PyObject *module, PyObject *name)
+{
+    if (PyUnicode_Check(name) &&
+        PyUnicode_CompareWithASCIIString(name, "ParseError") == 0) {
+        m3u8_state *mod_state = get_m3u8_state(module);
+        if (resolve_parser_objects(mod_state) < 0) {
+            return NULL;
+        }
+        return Py_NewRef(mod_state->ParseError);
+    }
+    PyErr_Format(PyExc_AttributeError,
+                 "module '_m3u8_parser' has no attribute %R", name);
+    return NULL;
+}
+
+/*
+ * Profiling API: set_stats_enabled(), reset_stats(), get_stats().
+ */
+static PyObject *
+m3u8_set_stats_enabled(PyObject *module, PyObject *arg)
+{
+    int enabled = PyObject_IsTrue(arg);
+    if (enabled < 0) {
+        return NULL;
+    }
+    m3u8_state *mod_state = get_m3u8_state(module);
+    int previous = STATS_ENABLED(mod_state);
+    STATS_SET_ENABLED(mod_state, enabled);
+    return PyBool_FromLong(previous);
+}
+
+static PyObject *
+m3u8_reset_stats(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    m3u8_state *mod_state = get_m3u8_state(module);
+    STATS_LOCK(mod_state);
+    memset(mod_state->stats.categories, 0, sizeof(mod_state->stats.categories));
+    memset(mod_state->stats.tags, 0, sizeof(mod_state->stats.tags));
+    STATS_UNLOCK(mod_state);
+    Py_RETURN_NONE;
+}
+
+/* Returns {"calls": ..., "ns": ...} as a new reference. */
+static PyObject *
+stat_counter_to_dict(const StatCounter *counter)
+{
+    return Py_BuildValue("{s:K,s:K}",
+                         "calls", (unsigned long long)counter->calls,
+                         "ns", (unsigned long long)counter->ns);
+}
+
+static PyObject *
+m3u8_get_stats(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    m3u8_state *mod_state = get_m3u8_state(module);
+
+    /* Snapshot under the lock; build Python objects after releasing it */
+    ParseStats snapshot;
+    STATS_LOCK(mod_state);
+    memcpy(&snapshot, &mod_state->stats, sizeof(snapshot));
+    STATS_UNLOCK(mod_state);
+    snapshot.enabled = STATS_ENABLED(mod_state);
+    const ParseStats *stats = &snapshot;
+
+    PyObject *result = PyDict_New();
+    if (result == NULL) {
+        return NULL;
+    }
+    if (PyDict_SetItemString(result, "enabled",
+                             stats->enabled ? Py_True : Py_False) < 0) {
+        goto fail;
+    }
+    for (int i = 0; i < NUM_STAT_CATEGORIES; i++) {
+        PyObject *counter = stat_counter_to_dict(&stats->categories[i]);
+        if (counter == NULL) goto fail;
+        DICT_SET_AND_DECREF(result, STAT_CATEGORY_NAMES[i], counter, fail);
+    }
+
+    PyObject *tags = PyDict_New();
+    if (tags == NULL) goto fail;
+    DICT_SET_AND_DECREF(result, "tags", tags, fail);
+    for (size_t i = 0; i < NUM_TAG_DISPATCH; i++) {
+        PyObject *counter = stat_counter_to_dict(&stats->tags[i]);
+        if (counter == NULL) goto fail;
+        DICT_SET_AND_DECREF(tags, TAG_DISPATCH[i].tag, counter, fail);
+    }
+    return result;
+
+fail:
+    Py_DECREF(result);
+    return NULL;
+}
+
+/*
+ * Content fingerprint: fingerprint(content, ignore=None).
+ *
+ * A 64-bit non-cryptographic hash over the stripped, non-blank lines of the
+ * playlist, so line-ending and indentation changes do not alter it. Lines
+ * starting with one of the `ignore` prefixes are left out. Each line is
+ * consumed eight bytes at a time with an xxHash64-style round and followed
+ * by its length, which also separates lines; the result gets a murmur3
+ * finalizer. Values depend on byte order and are only comparable with
+ * fingerprints from this extension on the same platform.
+ */
+#define FP_PRIME1 0x9E3779B185EBCA87ULL
+#define FP_PRIME2 0xC2B2AE3D27D4EB4FULL
+#define FP_PRIME3 0x165667B19E3779F9ULL
+
+static inline uint64_t
+fp_rotl(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t
+fp_round(uint64_t h, uint64_t word)
+{
+    h ^= fp_rotl(word * FP_PRIME2, 31) * FP_PRIME1;
+    return fp_rotl(h, 27) * FP_PRIME1 + FP_PRIME3;
+}
+
+static uint64_t
+fp_line(uint64_t h, const char *line, size_t len)
+{
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t word;
+        memcpy(&word, line + i, 8);
+        h = fp_round(h, word);
+    }
+    if (i < len) {
+        uint64_t word = 0;
+        memcpy(&word, line + i, len - i);
+        h = fp_round(h, word);
+    }
+    return fp_round(h, (uint64_t)len);
+}
+
+typedef struct {
+    const char *prefix;
+    size_t len;
+} IgnoredPrefix;
+
+static uint64_t
+fp_content(const char *p, const char *end,
+           const IgnoredPrefix *ignored, Py_ssize_t num_ignored)
+{
+    uint64_t h = FP_PRIME3;
+    while (p < end) {
+        const char *eol = p;
+        while (eol < end && *eol != '\n' && *eol != '\r') {
+            eol++;
+        }
+        const char *line = p;
+        size_t len = (size_t)(eol - p);
+        p = eol + 1;
+
+        while (len > 0 && ascii_isspace((unsigned char)*line)) {
+            line++;
+            len--;
+        }
+        while (len > 0 && ascii_isspace((unsigned char)line[len - 1])) {
+            len--;
+        }
+        if (len == 0) {
+            continue;
+        }
+        int skip = 0;
+        for (Py_ssize_t i = 0; i < num_ignored; i++) {
+            if (len >= ignored[i].len &&
+                memcmp(line, ignored[i].prefix, ignored[i].len) == 0) {
+                skip = 1;
+                break;
+            }
+        }
+        if (!skip) {
+            h = fp_line(h, line, len);
+        }
+    }
+    /* murmur3 fmix64 */
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static PyObject *
+m3u8_fingerprint(PyObject *module, PyObject *args, PyObject *kwargs)
+{
+    const char *content;
+    Py_ssize_t content_len;
+    PyObject *ignore = Py_None;
+
+    static char *kwlist[] = {"content", "ignore", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s#|O", kwlist,
+                                     &content, &content_len, &ignore)) {
+        return NULL;
+    }
+    if (PyUnicode_Check(ignore)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "ignore must be an iterable of line prefixes, not str");
+        return NULL;
+    }
+
+    /* The list keeps the prefix strings, and so their UTF-8 buffers, alive */
+    PyObject *prefixes = ignore == Py_None ? PyList_New(0) : PySequence_List(ignore);
+    if (prefixes == NULL) {
+        return NULL;
+    }
+    Py_ssize_t num_ignored = PyList_Size(prefixes);
+    IgnoredPrefix *ignored = PyMem_Calloc(num_ignored ? (size_t)num_ignored : 1,
+                                          sizeof(IgnoredPrefix));
+    if (ignored == NULL) {
+        Py_DECREF(prefixes);
+        return PyErr_NoMemory();
+    }
+    for (Py_ssize_t i = 0; i < num_ignored; i++) {
+        PyObject *prefix = PyList_GetItem(prefixes, i);  /* borrowed */
+        Py_ssize_t len;
+        if (!PyUnicode_Check(prefix)) {
+            PyErr_SetString(PyExc_TypeError, "ignore entries must be str");
+            goto fail;
+        }
+        ignored[i].prefix = PyUnicode_AsUTF8AndSize(prefix, &len);
+        if (ignored[i].prefix == NULL) {
+            goto fail;
+        }
+        ignored[i].len = (size_t)len;
+    }
+
+    uint64_t h;
+    Py_BEGIN_ALLOW_THREADS
+    h = fp_content(content, content + content_len, ignored, num_ignored);
+    Py_END_ALLOW_THREADS
+
+    PyMem_Free(ignored);
+    Py_DECREF(prefixes);
+    return PyLong_FromUnsignedLongLong((unsigned long long)h);
+
+fail:
+    PyMem_Free(ignored);
+    Py_DECREF(prefixes);
+    return NULL;
+}
+
+/*
+ * Segment diff: diff_segments(old, new, old_media_sequence, new_media_sequence).
+ *
+ * Aligns the two segment lists by media sequence number instead of by
+ * content, so the comparison is a single pass: old segments outside the new
+ * window are removed, new segments outside the old window are added, and
+ * each overlapping pair is compared once with ==. Returns a tuple
+ * (removed, added, changed) where changed holds (media_sequence, old, new)
+ * tuples. openm3u8.diff works out which fields differ.
+ */
+static PyObject *
+m3u8_diff_segments(PyObject *module, PyObject *args)
+{
+    PyObject *old_arg, *new_arg;
+    long long old_msn, new_msn;
+
+    if (!PyArg_ParseTuple(args, "OOLL", &old_arg, &new_arg, &old_msn, &new_msn)) {
+        return NULL;
+    }
+
+    /* Tuples are immutable snapshots, so borrowed items stay valid */
+    PyObject *old_segments = PySequence_Tuple(old_arg);
+    if (old_segments == NULL) {
+        return NULL;
+    }
+    PyObject *new_segments = PySequence_Tuple(new_arg);
+    if (new_segments == NULL) {
+        Py_DECREF(old_segments);
+        return NULL;
+    }
+    PyObject *removed = PyList_New(0);
+    PyObject *added = PyList_New(0);
+    PyObject *changed = PyList_New(0);
+    if (removed == NULL || added == NULL || changed == NULL) {
+        goto fail;
+    }
+
+    Py_ssize_t old_len = PyTuple_Size(old_segments);
+    Py_ssize_t new_len = PyTuple_Size(new_segments);
+    long long old_end = old_msn + old_len;
+    long long new_end = new_msn + new_len;
+
+    for (Py_ssize_t i = 0; i < old_len; i++) {
+        long long msn = old_msn + i;
+        if (msn < new_msn || msn >= new_end) {
+            if (PyList_Append(removed, PyTuple_GetItem(old_segments, i)) < 0) {
+                goto fail;
+            }
+        }
+    }
+    for (Py_ssize_t j = 0; j < new_len; j++) {
+        long long msn = new_msn + j;
+        PyObject *segment = PyTuple_GetItem(new_segments, j);
+        if (msn < old_msn || msn >= old_end) {
+            if (PyList_Append(added, segment) < 0) {
+                goto fail;
+            }
+            continue;
+        }
+        PyObject *previous = PyTuple_GetItem(old_segments, (Py_ssize_t)(msn - old_msn));
+        int equal = PyObject_RichCompareBool(previous, segment, Py_EQ);
+        if (equal < 0) {
+            goto fail;
+        }
+        if (!equal) {
+            PyObject *entry = Py_BuildValue("(LOO)", msn, previous, segment);
+            if (entry == NULL) {
+                goto fail;
+            }
+            int rc = PyList_Append(changed, entry);
+            Py_DECREF(entry);
+            if (rc < 0) {
+                goto fail;
+            }
+        }
+    }
+
+    Py_DECREF(old_segments);
+    Py_DECREF(new_segments);
+    return Py_BuildValue("(NNN)", removed, added, changed);
+
+fail:
+    Py_DECREF(old_segments);
+    Py_DECREF(new_segments);
+    Py_XDECREF(removed);
+    Py_XDECREF(added);
+    Py_XDECREF(changed);
+    return NULL;
+}
+
+/*
+ * SCTE-35: decode_scte35(data).
+ *
+ * Decodes a splice_info_section into the dict openm3u8.scte35 builds its
+ * records from, field for field the same as the Python decoder there:
+ * splice_insert, time_signal, splice_null, bandwidth_reservation and
+ * private commands, the avail, DTMF, segmentation, time and audio
+ * descriptors, and the CRC-32 check. Other commands and descriptors keep
+ * their payload as bytes. Raises ValueError for malformed sections.
+ */
+#define SCTE35_TABLE_ID 0xFC
+#define SCTE35_TRUNCATED "SCTE-35 section is truncated"
+
+typedef struct {
+    const unsigned char *data;
+    Py_ssize_t pos;       /* in bits */
+    Py_ssize_t size;      /* in bits */
+    int truncated;
+} ScteBits;
+
+static void
+scte_bits_init(ScteBits *bits, const unsigned char *data, Py_ssize_t start,
+               Py_ssize_t end)
+{
+    bits->data = data + start;
+    bits->pos = 0;
+    bits->size = (end - start) * 8;
+    bits->truncated = 0;
+}
+
+/* Read n <= 64 bits; past the end, set `truncated` and return 0. */
+static uint64_t
+scte_read(ScteBits *bits, int n)
+{
+    if (bits->pos + n > bits->size) {
+        bits->truncated = 1;
+        bits->pos = bits->size;
+        return 0;
+    }
+    uint64_t value = 0;
+    while (n > 0) {
+        int offset = (int)(bits->pos & 7);
+        int take = 8 - offset < n ? 8 - offset : n;
+        unsigned int byte = bits->data[bits->pos >> 3];
+        value = (value << take) |
+                ((byte >> (8 - offset - take)) & ((1u << take) - 1));
+        bits->pos += take;
+        n -= take;
+    }
+    return value;
+}
+
+static PyObject *
+scte_bytes(ScteBits *bits, Py_ssize_t n)
+{
+    if (n < 0 || bits->pos + n * 8 > bits->size) {
+        bits->truncated = 1;
+        bits->pos = bits->size;
+        return PyBytes_FromStringAndSize(NULL, 0);
+    }
+    PyObject *result = PyBytes_FromStringAndSize(NULL, n);
+    if (result == NULL) {
+        return NULL;
+    }
+    char *out = PyBytes_AsString(result);
+    for (Py_ssize_t i = 0; i < n; i++) {
+        out[i] = (char)scte_read(bits, 8);
+    }
+    return result;
+}
+
+static PyObject *
+scte_ascii(ScteBits *bits, Py_ssize_t n)
+{
+    PyObject *raw = scte_bytes(bits, n);
+    if (raw == NULL) {
+        return NULL;
+    }
+    PyObject *text = PyUnicode_DecodeASCII(PyBytes_AsString(raw),
+                                           PyBytes_Size(raw), "replace");
+    Py_DECREF(raw);
+    return text;
+}
+
+/* splice_time(): a 33-bit pts_time, or None when not specified. */
+static PyObject *
+scte_splice_time(ScteBits *bits)
+{
+    if (scte_read(bits, 1)) {
+        scte_read(bits, 6);
+        return PyLong_FromUnsignedLongLong(scte_read(bits, 33));
+    }
+    scte_read(bits, 7);
+    Py_RETURN_NONE;
+}
+
+/* Steals `value`; fails when it is NULL. */
+static int
+scte_set(PyObject *dict, const char *key, PyObject *value)
+{
+    if (value == NULL) {
+        return -1;
+    }
+    int rc = PyDict_SetItemString(dict, key, value);
+    Py_DECREF(value);
+    return rc;
+}
+
+#define SCTE_SET(dict, key, value) \
+    do { \
+        if (scte_set((dict), (key), (value)) < 0) { \
+            goto fail; \
+        } \
+    } while (0)
+#define SCTE_UINT(bits, n) PyLong_FromUnsignedLongLong(scte_read((bits), (n)))
+#define SCTE_FLAG(bits) PyBool_FromLong((long)scte_read((bits), 1))
+
+static uint32_t
+scte_crc32(const unsigned char *data, Py_ssize_t len)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    for (Py_ssize_t i = 0; i < len; i++) {
+        crc ^= (uint32_t)data[i] << 24;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = crc & 0x80000000u ? (crc << 1) ^ 0x04C11DB7u : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static int
+scte_splice_insert(ScteBits *bits, PyObject *command)
+{
+    PyObject *components = NULL;
+    SCTE_SET(command, "splice_event_id", SCTE_UINT(bits, 32));
+    int cancel = (int)scte_read(bits, 1);
+    SCTE_SET(command, "splice_event_cancel_indicator", PyBool_FromLong(cancel));
+    scte_read(bits, 7);
+    if (cancel) {
+        return 0;
+    }
+    SCTE_SET(command, "out_of_network_indicator", SCTE_FLAG(bits));
+    int program = (int)scte_read(bits, 1);
+    int duration = (int)scte_read(bits, 1);
+    int immediate = (int)scte_read(bits, 1);
+    SCTE_SET(command, "program_splice_flag", PyBool_FromLong(program));
+    SCTE_SET(command, "duration_flag", PyBool_FromLong(duration));
+    SCTE_SET(command, "splice_immediate_flag", PyBool_FromLong(immediate));
+    SCTE_SET(command, "event_id_compliance_flag", SCTE_FLAG(bits));
+    scte_read(bits, 3);
+    if (program && !immediate) {
+        SCTE_SET(command, "pts_time", scte_splice_time(bits));
+    }
+    if (!program) {
+        int count = (int)scte_read(bits, 8);
+        components = PyList_New(0);
+        if (components == NULL) {
+            goto fail;
+        }
+        for (int i = 0; i < count; i++) {
+            unsigned long tag = (unsigned long)scte_read(bits, 8);
+            PyObject *pts_time;
+            if (immediate) {
+                pts_time = Py_None;
+                Py_INCREF(pts_time);
+            } else if ((pts_time = scte_splice_time(bits)) == NULL) {
+                goto fail;
+            }
+            PyObject *component = Py_BuildValue("(kN)", tag, pts_time);
+            if (component == NULL || PyList_Append(components, component) < 0) {
+                Py_XDECREF(component);
+                goto fail;
+            }
+            Py_DECREF(component);
+        }
+        SCTE_SET(command, "components", components);
+        components = NULL;
+    }
+    if (duration) {
+        SCTE_SET(command, "auto_return", SCTE_FLAG(bits));
+        scte_read(bits, 6);
+        SCTE_SET(command, "break_duration", SCTE_UINT(bits, 33));
+    }
+    SCTE_SET(command, "unique_program_id", SCTE_UINT(bits, 16));
+    SCTE_SET(command, "avail_num", SCTE_UINT(bits, 8));
+    SCTE_SET(command, "avails_expected", SCTE_UINT(bits, 8));
+    return 0;
+
+fail:
+    Py_XDECREF(components);
+    return -1;
+}
+
+/* `length` is -1 when the section leaves splice_command_length unset. */
+static PyObject *
+scte_command(int command_type, ScteBits *bits, Py_ssize_t length)
+{
+    PyObject *command = PyDict_New();
+    if (command == NULL) {
+        return NULL;
+    }
+    switch (command_type) {
+    case 0x05:
+        if (scte_splice_insert(bits, command) < 0) {
+            goto fail;
+        }
+        break;
+    case 0x06:
+        SCTE_SET(command, "pts_time", scte_splice_time(bits));
+        break;
+    case 0x00:
+    case 0x07:
+        break;
+    default:
+        if (length < 0) {
+            char message[64];
+            PyOS_snprintf(message, sizeof(message),
+                          "splice command 0x%02X needs a splice_command_length",
+                          command_type);
+            PyErr_SetString(PyExc_ValueError, message);
+            goto fail;
+        }
+        if (command_type == 0xFF) {
+            SCTE_SET(command, "identifier", SCTE_UINT(bits, 32));
+            length -= 4;
+        }
+        SCTE_SET(command, "data", scte_bytes(bits, length));
+    }
+    return command;
+
+fail:
+    Py_DECREF(command);
+    return NULL;
+}
+
+static int
+scte_segmentation(ScteBits *bits, PyObject *descriptor)
+{
+    PyObject *components = NULL;
+    SCTE_SET(descriptor, "segmentation_event_id", SCTE_UINT(bits, 32));
+    int cancel = (int)scte_read(bits, 1);
+    SCTE_SET(descriptor, "segmentation_event_cancel_indicator",
+             PyBool_FromLong(cancel));
+    SCTE_SET(descriptor, "segmentation_event_id_compliance_indicator",
+             SCTE_FLAG(bits));
+    scte_read(bits, 6);
+    if (cancel) {
+        return 0;
+    }
+    int program = (int)scte_read(bits, 1);
+    int duration = (int)scte_read(bits, 1);
+    int unrestricted = (int)scte_read(bits, 1);
+    SCTE_SET(descriptor, "program_segmentation_flag", PyBool_FromLong(program));
+    SCTE_SET(descriptor, "segmentation_duration_flag", PyBool_FromLong(duration));
+    SCTE_SET(descriptor, "delivery_not_restricted_flag",
+             PyBool_FromLong(unrestricted));
+    if (unrestricted) {
+        scte_read(bits, 5);
+    } else {
+        SCTE_SET(descriptor, "web_delivery_allowed_flag", SCTE_FLAG(bits));
+        SCTE_SET(descriptor, "no_regional_blackout_flag", SCTE_FLAG(bits));
+        SCTE_SET(descriptor, "archive_allowed_flag", SCTE_FLAG(bits));
+        SCTE_SET(descriptor, "device_restrictions", SCTE_UINT(bits, 2));
+    }
+    if (!program) {
+        int count = (int)scte_read(bits, 8);
+        components = PyList_New(0);
+        if (components == NULL) {
+            goto fail;
+        }
+        for (int i = 0; i < count; i++) {
+            unsigned long tag = (unsigned long)scte_read(bits, 8);
+            scte_read(bits, 7);
+            unsigned long long offset = scte_read(bits, 33);
+            PyObject *component = Py_BuildValue("(kK)", tag, offset);
+            if (component == NULL || PyList_Append(components, component) < 0) {
+                Py_XDECREF(component);
+                goto fail;
+            }
+            Py_DECREF(component);
+        }
+        SCTE_SET(descriptor, "components", components);
+        components = NULL;
+    }
+    if (duration) {
+        SCTE_SET(descriptor, "segmentation_duration", SCTE_UINT(bits, 40));
+    }
+    SCTE_SET(descriptor, "segmentation_upid_type", SCTE_UINT(bits, 8));
+    Py_ssize_t upid_length = (Py_ssize_t)scte_read(bits, 8);
+    SCTE_SET(descriptor, "segmentation_upid", scte_bytes(bits, upid_length));
+    int type_id = (int)scte_read(bits, 8);
+    SCTE_SET(descriptor, "segmentation_type_id", PyLong_FromLong(type_id));
+    SCTE_SET(descriptor, "segment_num", SCTE_UINT(bits, 8));
+    SCTE_SET(descriptor, "segments_expected", SCTE_UINT(bits, 8));
+    /* Placement opportunity and ad block starts may carry sub-segments */
+    if ((type_id == 0x34 || type_id == 0x36 || type_id == 0x38 ||
+         type_id == 0x3A || type_id == 0x44 || type_id == 0x46) &&
+        bits->size - bits->pos >= 16) {
+        SCTE_SET(descriptor, "sub_segment_num", SCTE_UINT(bits, 8));
+        SCTE_SET(descriptor, "sub_segments_expected", SCTE_UINT(bits, 8));
+    }
+    return 0;
+
+fail:
+    Py_XDECREF(components);
+    return -1;
+}
+
+static PyObject *
+scte_descriptor(int tag, ScteBits *bits, Py_ssize_t length)
+{
+    PyObject *components = NULL;
+    PyObject *descriptor = PyDict_New();
+    if (descriptor == NULL) {
+        return NULL;
+    }
+    SCTE_SET(descriptor, "tag", PyLong_FromLong(tag));
+    SCTE_SET(descriptor, "identifier", SCTE_UINT(bits, 32));
+    switch (tag) {
+    case 0x00:
+        SCTE_SET(descriptor, "provider_avail_id", SCTE_UINT(bits, 32));
+        break;
+    case 0x01: {
+        SCTE_SET(descriptor, "preroll", SCTE_UINT(bits, 8));
+        Py_ssize_t count = (Py_ssize_t)scte_read(bits, 3);
+        scte_read(bits, 5);
+        SCTE_SET(descriptor, "dtmf_chars", scte_ascii(bits, count));
+        break;
+    }
+    case 0x02:
+        if (scte_segmentation(bits, descriptor) < 0) {
+            goto fail;
+        }
+        break;
+    case 0x03:
+        SCTE_SET(descriptor, "tai_seconds", SCTE_UINT(bits, 48));
+        SCTE_SET(descriptor, "tai_ns", SCTE_UINT(bits, 32));
+        SCTE_SET(descriptor, "utc_offset", SCTE_UINT(bits, 16));
+        break;
+    case 0x04: {
+        int count = (int)scte_read(bits, 4);
+        scte_read(bits, 4);
+        components = PyList_New(0);
+        if (components == NULL) {
+            goto fail;
+        }
+        for (int i = 0; i < count; i++) {
+            unsigned long component_tag = (unsigned long)scte_read(bits, 8);
+            PyObject *iso_code = scte_ascii(bits, 3);
+            if (iso_code == NULL) {
+                goto fail;
+            }
+            unsigned long bit_stream_mode = (unsigned long)scte_read(bits, 3);
+            unsigned long num_channels = (unsigned long)scte_read(bits, 4);
+            PyObject *full_srvc_audio = SCTE_FLAG(bits);
+            PyObject *component = Py_BuildValue(
+                "(kNkkN)", component_tag, iso_code, bit_stream_mode,
+                num_channels, full_srvc_audio);
+            if (component == NULL || PyList_Append(components, component) < 0) {
+                Py_XDECREF(component);
+                goto fail;
+            }
+            Py_DECREF(component);
+        }
+        SCTE_SET(descriptor, "components", components);
+        components = NULL;
+        break;
+    }
+    default:
+        SCTE_SET(descriptor, "data", scte_bytes(bits, length - 4));
+    }
+    return descriptor;
+
+fail:
+    Py_XDECREF(components);
+    Py_DECREF(descriptor);
+    return NULL;
+}
+
+static PyObject *
+scte_truncated(PyObject *section)
+{
+    Py_XDECREF(section);
+    PyErr_SetString(PyExc_ValueError, SCTE35_TRUNCATED);
+    return NULL;
+}
+
+static PyObject *
+scte_section(const unsigned char *data, Py_ssize_t size)
+{
+    if (size < 3) {
+        return scte_truncated(NULL);
+    }
+    if (data[0] != SCTE35_TABLE_ID) {
+        char message[64];
+        PyOS_snprintf(message, sizeof(message),
+                      "not a SCTE-35 splice_info_section (table_id 0x%02X)",
+                      (int)data[0]);
+        PyErr_SetString(PyExc_ValueError, message);
+        return NULL;
+    }
+    Py_ssize_t end = 3 + (((data[1] & 0x0F) << 8) | data[2]);
+    if (end > size || end < 18) {
+        return scte_truncated(NULL);
+    }
+
+    PyObject *descriptors = NULL;
+    PyObject *section = PyDict_New();
+    if (section == NULL) {
+        return NULL;
+    }
+    ScteBits bits;
+    scte_bits_init(&bits, data, 0, end - 4);
+    scte_read(&bits, 10);
+    SCTE_SET(section, "table_id", PyLong_FromLong(SCTE35_TABLE_ID));
+    SCTE_SET(section, "sap_type", SCTE_UINT(&bits, 2));
+    scte_read(&bits, 12);
+    SCTE_SET(section, "protocol_version", SCTE_UINT(&bits, 8));
+    int encrypted = (int)scte_read(&bits, 1);
+    SCTE_SET(section, "encrypted_packet", PyBool_FromLong(encrypted));
+    SCTE_SET(section, "encryption_algorithm", SCTE_UINT(&bits, 6));
+    SCTE_SET(section, "pts_adjustment", SCTE_UINT(&bits, 33));
+    SCTE_SET(section, "cw_index", SCTE_UINT(&bits, 8));
+    SCTE_SET(section, "tier", SCTE_UINT(&bits, 12));
+    Py_ssize_t length = (Py_ssize_t)scte_read(&bits, 12);
+    int command_type = (int)scte_read(&bits, 8);
+    SCTE_SET(section, "splice_command_type", PyLong_FromLong(command_type));
+    const unsigned char *crc_bytes = data + end - 4;
+    uint32_t crc = ((uint32_t)crc_bytes[0] << 24) | ((uint32_t)crc_bytes[1] << 16) |
+                   ((uint32_t)crc_bytes[2] << 8) | (uint32_t)crc_bytes[3];
+    SCTE_SET(section, "crc_32", PyLong_FromUnsignedLong(crc));
+    SCTE_SET(section, "crc_valid",
+             PyBool_FromLong(scte_crc32(data, end - 4) == crc));
+    if (encrypted) {
+        /* Command and descriptors are only readable after decryption */
+        Py_INCREF(Py_None);
+        SCTE_SET(section, "splice_command", Py_None);
+        SCTE_SET(section, "descriptors", PyList_New(0));
+        return section;
+    }
+
+    Py_ssize_t start = bits.pos / 8;
+    if (length == 0xFFF) {
+        /* Legacy encoders leave the length unset; the command then ends
+         * where its own syntax ends */
+        SCTE_SET(section, "splice_command", scte_command(command_type, &bits, -1));
+        if (bits.truncated) {
+            return scte_truncated(section);
+        }
+    } else {
+        if (start + length > end - 4) {
+            return scte_truncated(section);
+        }
+        ScteBits command_bits;
+        scte_bits_init(&command_bits, data, start, start + length);
+        SCTE_SET(section, "splice_command",
+                 scte_command(command_type, &command_bits, length));
+        if (command_bits.truncated) {
+            return scte_truncated(section);
+        }
+        bits.pos = (start + length) * 8;
+    }
+
+    Py_ssize_t loop_end = bits.pos / 8 + 2;
+    loop_end += (Py_ssize_t)scte_read(&bits, 16);
+    if (bits.truncated || loop_end > end - 4) {
+        return scte_truncated(section);
+    }
+    descriptors = PyList_New(0);
+    if (descriptors == NULL) {
+        goto fail;
+    }
+    Py_ssize_t position = bits.pos / 8;
+    while (position < loop_end) {
+        if (position + 2 > loop_end) {
+            Py_DECREF(descriptors);
+            return scte_truncated(section);
+        }
+        int tag = data[position];
+        Py_ssize_t descriptor_length = data[position + 1];
+        position += 2;
+        if (descriptor_length < 4 || position + descriptor_length > loop_end) {
+            Py_DECREF(descriptors);
+            return scte_truncated(section);
+        }
+        ScteBits descriptor_bits;
+        scte_bits_init(&descriptor_bits, data, position, position + descriptor_length);
+        PyObject *descriptor = scte_descriptor(tag, &descriptor_bits,
+                                               descriptor_length);
+        if (descriptor == NULL) {
+            goto fail;
+        }
+        int rc = PyList_Append(descriptors, descriptor);
+        Py_DECREF(descriptor);
+        if (rc < 0) {
+            goto fail;
+        }
+        if (descriptor_bits.truncated) {
+            Py_DECREF(descriptors);
+            return scte_truncated(section);
+        }
+        position += descriptor_length;
+    }
+    SCTE_SET(section, "descriptors", descriptors);
+    return section;
+
+fail:
+    Py_XDECREF(descriptors);
+    Py_DECREF(section);
+    return NULL;
+}
+
+static PyObject *
+m3u8_decode_scte35(PyObject *module, PyObject *arg)
+{
+    PyObject *data = PyBytes_FromObject(arg);
+    if (data == NULL) {
+        return NULL;
+    }
+    char *buffer;
+    Py_ssize_t size;
+    PyObject *result = NULL;
+    if (PyBytes_AsStringAndSize(data, &buffer, &size) == 0) {
+        result = scte_section((const unsigned char *)buffer, size);
+    }
+    Py_DECREF(data);
+    return result;
+}
+
+/* Module methods */
+static PyMethodDef m3u8_parser_methods[] = {
+    {"parse", (PyCFunction)m3u8_parse, METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR(
+     "parse(content, strict=False, custom_tags_parser=None,\n"
+     "      custom_tag_handlers=None, fields=None, until=None)\n"
+     "--\n\n"
+     "Parse M3U8 playlist content and return a dictionary with all data found.\n\n"
+     "This is an optimized C implementation that produces output identical to\n"
+     "the pure Python parser in openm3u8.parser.parse().\n\n"
+     "Parameters\n"
      "----------\n"
      "content : str\n"
      "    The M3U8 playlist content as a string.\n"
@@ -2978,7 +5011,21 @@ static PyMethodDef m3u8_parser_methods[] = {
      "    If True, raise exceptions for syntax errors. Default is False.\n"
      "custom_tags_parser : callable, optional\n"
      "    A function that receives (line, lineno, data, state) for custom tag\n"
-     "    handling. Return True to skip default parsing for that line.\n\n"
+     "    handling. Return True to skip default parsing for that line.\n"
+     "custom_tag_handlers : dict, optional\n"
+     "    Maps a tag prefix (e.g. '#EXT-X-VENDOR') to a callable with the same\n"
+     "    signature as custom_tags_parser, or to an openm3u8.CustomTagSchema,\n"
+     "    which is applied in C without a Python call. Only lines starting with\n"
+     "    a registered prefix invoke a handler; the first matching prefix wins.\n"
+     "    Runs after custom_tags_parser.\n"
+     "fields : iterable of str, optional\n"
+     "    Output fields to produce, e.g. {'segments.uri', 'media_sequence'};\n"
+     "    'segments' selects every segment field. Tags that cannot affect\n"
+     "    them are recognized but not parsed. Default parses everything.\n"
+     "until : {None, 'header', 'first_segment'}, optional\n"
+     "    Stop at the first media segment URI line: 'header' returns no\n"
+     "    segments, 'first_segment' includes that one segment. Variant URIs\n"
+     "    do not stop the parse.\n\n"
      "Returns\n"
      "-------\n"
      "dict\n"
@@ -2997,6 +5044,64 @@ static PyMethodDef m3u8_parser_methods[] = {
      ">>> len(result['segments'])\n"
      "1\n"
      )},
+    {"__getattr__", (PyCFunction)m3u8_getattr, METH_O, NULL},
+    {"diff_segments", (PyCFunction)m3u8_diff_segments, METH_VARARGS,
+     PyDoc_STR(
+     "diff_segments(old, new, old_media_sequence, new_media_sequence)\n"
+     "--\n\n"
+     "Align two segment lists by media sequence number and compare them.\n\n"
+     "Returns (removed, added, changed): old segments outside the new window,\n"
+     "new segments outside the old window, and (media_sequence, old, new)\n"
+     "tuples for overlapping segments that are not equal."
+     )},
+    {"fingerprint", (PyCFunction)m3u8_fingerprint, METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR(
+     "fingerprint(content, ignore=None)\n"
+     "--\n\n"
+     "Return a 64-bit hash of the playlist's stripped, non-blank lines.\n\n"
+     "Lines starting with one of the `ignore` prefixes (e.g.\n"
+     "'#EXT-X-PROGRAM-DATE-TIME') are left out, so playlists differing only\n"
+     "in those lines fingerprint the same. Not cryptographic; only comparable\n"
+     "with fingerprints from this extension on the same platform."
+     )},
+    {"decode_scte35", (PyCFunction)m3u8_decode_scte35, METH_O,
+     PyDoc_STR(
+     "decode_scte35(data)\n"
+     "--\n\n"
+     "Decode the SCTE-35 splice_info_section at the start of `data` (bytes).\n\n"
+     "Returns a dict of the section's fields, its splice command and its\n"
+     "descriptors as openm3u8.scte35.decode_section does, with 'crc_valid'\n"
+     "telling whether the CRC-32 matched. Raises ValueError for malformed or\n"
+     "truncated sections."
+     )},
+    {"set_stats_enabled", (PyCFunction)m3u8_set_stats_enabled, METH_O,
+     PyDoc_STR(
+     "set_stats_enabled(enabled)\n"
+     "--\n\n"
+     "Turn the per-tag profiling counters on or off for this module.\n\n"
+     "While enabled, every parse() call records call counts and cumulative\n"
+     "monotonic nanoseconds per dispatched tag and for custom_tags_parser\n"
+     "callbacks, URI lines, unknown tags, strict validation and result setup.\n"
+     "Counters accumulate across calls until reset_stats().\n\n"
+     "Returns the previous setting."
+     )},
+    {"reset_stats", (PyCFunction)m3u8_reset_stats, METH_NOARGS,
+     PyDoc_STR(
+     "reset_stats()\n"
+     "--\n\n"
+     "Zero all profiling counters. Does not change whether they are enabled."
+     )},
+    {"get_stats", (PyCFunction)m3u8_get_stats, METH_NOARGS,
+     PyDoc_STR(
+     "get_stats()\n"
+     "--\n\n"
+     "Return a snapshot of the profiling counters as a dict.\n\n"
+     "Top-level keys 'parse', 'strict_validation', 'setup',\n"
+     "'custom_tags_parser', 'custom_tag_handlers', 'uri_lines' and\n"
+     "'unknown_tags' map to\n"
+     "{'calls': int, 'ns': int}. 'tags' maps every tag in the dispatch table\n"
+     "to the same shape; a tag's time includes building its attribute dict."
+     )},
     {NULL, NULL, 0, NULL}
 };
 
@@ -3011,6 +5116,7 @@ m3u8_parser_traverse(PyObject *module, visitproc visit, void *arg)
     Py_VISIT(state->datetime_cls);
     Py_VISIT(state->timedelta_cls);
     Py_VISIT(state->fromisoformat_meth);
+    Py_VISIT(state->CustomTagSchema);
     #define VISIT_INTERNED(name, str) Py_VISIT(state->name);
     INTERNED_STRINGS(VISIT_INTERNED)
     #undef VISIT_INTERNED
@@ -3028,6 +5134,7 @@ m3u8_parser_clear(PyObject *module)
     Py_CLEAR(state->datetime_cls);
     Py_CLEAR(state->timedelta_cls);
     Py_CLEAR(state->fromisoformat_meth);
+    Py_CLEAR(state->CustomTagSchema);
     #define CLEAR_INTERNED(name, str) Py_CLEAR(state->name);
     INTERNED_STRINGS(CLEAR_INTERNED)
     #undef CLEAR_INTERNED
@@ -3043,31 +5150,17 @@ m3u8_parser_free(void *module)
     m3u8_parser_clear((PyObject *)module);
 }
 
-/* Module definition */
-static struct PyModuleDef m3u8_parser_module = {
-    PyModuleDef_HEAD_INIT,
-    .m_name = "_m3u8_parser",
-    .m_doc = "C extension for fast M3U8 playlist parsing.",
-    .m_size = sizeof(m3u8_state),
-    .m_methods = m3u8_parser_methods,
-    .m_traverse = m3u8_parser_traverse,
-    .m_clear = m3u8_parser_clear,
-    .m_free = m3u8_parser_free,
-};
-
 /*
- * Module initialization.
+ * Module exec slot (multi-phase init, PEP 489).
  *
- * Creates the module, initializes module state, and sets up cached objects.
+ * Runs once per interpreter that imports the module. Nothing here imports
+ * openm3u8.parser; ParseError and CustomTagSchema are resolved on first use
+ * (see resolve_parser_objects), so the module can be imported on its own,
+ * including in isolated sub-interpreters.
  */
-PyMODINIT_FUNC
-PyInit__m3u8_parser(void)
+static int
+m3u8_parser_exec(PyObject *m)
 {
-    PyObject *m = PyModule_Create(&m3u8_parser_module);
-    if (m == NULL) {
-        return NULL;
-    }
-
     m3u8_state *state = get_m3u8_state(m);
 
     /* Initialize module state to NULL for safe cleanup on error */
@@ -3075,48 +5168,61 @@ PyInit__m3u8_parser(void)
     state->datetime_cls = NULL;
     state->timedelta_cls = NULL;
     state->fromisoformat_meth = NULL;
+    state->CustomTagSchema = NULL;
     #define NULL_INTERNED(name, str) state->name = NULL;
     INTERNED_STRINGS(NULL_INTERNED)
     #undef NULL_INTERNED
 
-    /* Import ParseError from openm3u8.parser to use the same exception class */
-    PyObject *parser_module = PyImport_ImportModule("openm3u8.parser");
-    if (parser_module != NULL) {
-        state->ParseError = PyObject_GetAttrString(parser_module, "ParseError");
-        Py_DECREF(parser_module);
-    }
-
-    /* Fallback: create our own ParseError if import fails */
-    if (state->ParseError == NULL) {
-        PyErr_Clear();
-        state->ParseError = PyErr_NewException(
-            "openm3u8._m3u8_parser.ParseError", PyExc_Exception, NULL);
-        if (state->ParseError == NULL) {
-            goto error;
-        }
-    }
-
-    /* Add ParseError to module (PyModule_AddObject steals a reference on success) */
-    Py_INCREF(state->ParseError);
-    if (PyModule_AddObject(m, "ParseError", state->ParseError) < 0) {
-        Py_DECREF(state->ParseError);
-        goto error;
+    /* Attribute types for CustomTagSchema, mirrored in openm3u8.parser */
+    if (PyModule_AddIntConstant(m, "ATTR_STRING", ATTR_STRING) < 0 ||
+        PyModule_AddIntConstant(m, "ATTR_INT", ATTR_INT) < 0 ||
+        PyModule_AddIntConstant(m, "ATTR_FLOAT", ATTR_FLOAT) < 0 ||
+        PyModule_AddIntConstant(m, "ATTR_QUOTED_STRING", ATTR_QUOTED_STRING) < 0 ||
+        PyModule_AddIntConstant(m, "ATTR_BANDWIDTH", ATTR_BANDWIDTH) < 0) {
+        return -1;
     }
 
     /* Initialize datetime cache */
     if (init_datetime_cache(state) < 0) {
-        goto error;
+        return -1;
     }
 
     /* Initialize interned strings for common dict keys */
     if (init_interned_strings(state) < 0) {
-        goto error;
+        return -1;
     }
 
-    return m;
-
-error:
-    Py_DECREF(m);
-    return NULL;
+    return 0;
 }
 
+static PyModuleDef_Slot m3u8_parser_slots[] = {
+    {Py_mod_exec, m3u8_parser_exec},
+#ifdef Py_mod_multiple_interpreters
+    /* All state is per-module; no static mutable state or static types */
+    {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+#endif
+#ifdef Py_mod_gil
+    /* Shared mutable state (profiling counters) is guarded by state->lock */
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
+    {0, NULL}
+};
+
+/* Module definition */
+static struct PyModuleDef m3u8_parser_module = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "_m3u8_parser",
+    .m_doc = "C extension for fast M3U8 playlist parsing.",
+    .m_size = sizeof(m3u8_state),
+    .m_methods = m3u8_parser_methods,
+    .m_slots = m3u8_parser_slots,
+    .m_traverse = m3u8_parser_traverse,
+    .m_clear = m3u8_parser_clear,
+    .m_free = m3u8_parser_free,
+};
+
+PyMODINIT_FUNC
+PyInit__m3u8_parser(void)
+{
+    return PyModuleDef_Init(&m3u8_parser_module);
+}
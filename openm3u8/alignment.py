@@ -0,0 +1,297 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+"""
+Cross-rendition alignment checks for a master playlist.
+
+`check_alignment` takes a master playlist and the media playlists of its
+variants and EXT-X-MEDIA renditions and compares every rendition with a
+reference rendition (the first variant), segment by segment, matching
+segments by media sequence number:
+
+- "boundary": segment start times, measured from the first segment both
+  playlists share, differ by more than `tolerance` seconds;
+- "discontinuity_sequence": a segment has a different discontinuity
+  sequence number (EXT-X-DISCONTINUITY-SEQUENCE plus the discontinuities
+  before it);
+- "program_date_time": the segments' EXT-X-PROGRAM-DATE-TIME drift apart
+  by more than `tolerance` seconds;
+- "media_sequence": the playlists share no media sequence number at all.
+
+Each playlist's EXT-X-RENDITION-REPORT tags are also checked against the
+LAST-MSN and LAST-PART of the rendition they report on
+("rendition_report"), and renditions that could not be loaded or parsed
+are reported as "error".
+
+Renditions are fetched and parsed on a thread pool, with the parse
+restricted to the fields the checks read. On free-threaded builds the C
+parser runs without the GIL, so parsing scales with the workers too.
+"""
+
+import os
+from collections import namedtuple
+from concurrent.futures import ThreadPoolExecutor
+from urllib.parse import urljoin
+
+from openm3u8.httpclient import DefaultHTTPClient
+from openm3u8.parser import parse
+
+if os.environ.get("M3U8_NO_C_EXTENSION", "") != "1":
+    try:
+        from openm3u8._m3u8_parser import parse
+    except ImportError:
+        pass
+
+# Parser outputs the checks read
+FIELDS = frozenset(
+    (
+        "media_sequence",
+        "discontinuity_sequence",
+        "segments.uri",
+        "segments.duration",
+        "segments.discontinuity",
+        "segments.current_program_date_time",
+        "segments.parts",
+        "rendition_reports",
+        "skip",
+    )
+)
+
+
+Deviation = namedtuple(
+    "Deviation", ["uri", "check", "media_sequence", "expected", "actual", "reference"]
+)
+Deviation.__doc__ = """
+One failed check of rendition `uri` against rendition `reference`: the
+reference rendition, or for "rendition_report" the rendition the report
+is about. `media_sequence` is the segment where the largest deviation
+was found (the first one for "discontinuity_sequence"), `expected` the
+reference value and `actual` this rendition's.
+"""
+
+RenditionAlignment = namedtuple(
+    "RenditionAlignment",
+    ["uri", "media_sequence", "last_msn", "last_part", "deviations"],
+)
+RenditionAlignment.__doc__ = """
+The checked state of one rendition: its first and last media sequence
+numbers, the part index of its last partial segment (None without
+parts) and the list of its `Deviation`s.
+"""
+
+
+class AlignmentReport:
+    """
+    The result of `check_alignment`: `renditions` lists a
+    `RenditionAlignment` per media playlist in master playlist order, and
+    `reference` is the URI the others were compared with.
+    """
+
+    def __init__(self, reference, renditions):
+        self.reference = reference
+        self.renditions = renditions
+
+    @property
+    def deviations(self):
+        return [
+            deviation
+            for rendition in self.renditions
+            for deviation in rendition.deviations
+        ]
+
+    @property
+    def ok(self):
+        return not any(rendition.deviations for rendition in self.renditions)
+
+    def __repr__(self):
+        return (
+            f"AlignmentReport(reference={self.reference!r},"
+            f" renditions={len(self.renditions)},"
+            f" deviations={len(self.deviations)})"
+        )
+
+
+class _Timeline:
+    """
+    The segments of one media playlist by media sequence number, as
+    (offset from the first segment, program date-time, discontinuity
+    sequence number), plus what its rendition reports say.
+    """
+
+    def __init__(self, data):
+        # Delta updates list segments from after those EXT-X-SKIP omits
+        skip = data.get("skip") or {}
+        msn = (data.get("media_sequence") or 0) + (skip.get("skipped_segments") or 0)
+        discontinuity_sequence = data.get("discontinuity_sequence") or 0
+        offset = 0.0
+        self.first_msn = msn
+        self.last_msn = self.last_part = None
+        self.segments = {}
+        for segment in data.get("segments", ()):
+            parts = segment.get("parts") or ()
+            if "uri" not in segment:
+                # Trailing partial segment
+                if parts:
+                    self.last_msn, self.last_part = msn, len(parts) - 1
+                break
+            if segment.get("discontinuity"):
+                discontinuity_sequence += 1
+            self.segments[msn] = (
+                offset,
+                segment.get("current_program_date_time"),
+                discontinuity_sequence,
+            )
+            self.last_msn = msn
+            self.last_part = len(parts) - 1 if parts else None
+            offset += segment.get("duration") or 0
+            msn += 1
+        self.rendition_reports = data.get("rendition_reports", [])
+
+
+def _rendition_uris(master):
+    uris = []
+    for item in (*master.playlists, *master.media):
+        if item.uri and item.uri not in uris:
+            uris.append(item.uri)
+    return uris
+
+
+def check_alignment(
+    master,
+    renditions=None,
+    tolerance=0.1,
+    max_workers=None,
+    http_client=None,
+    timeout=None,
+    headers={},
+    verify_ssl=True,
+):
+    """
+    Check the media playlists of `master`, a variant `M3U8`, against each
+    other and return an `AlignmentReport`.
+
+    `renditions` maps rendition URIs, as written in the master playlist or
+    resolved against its base URI, to the media playlist text, its `parse`
+    dict or its `M3U8`. Renditions missing from it are downloaded with
+    `http_client` (by default a `DefaultHTTPClient`). `max_workers` sizes
+    the thread pool as `ThreadPoolExecutor` does.
+    """
+    renditions = renditions or {}
+    base_uri = master.base_uri or ""
+    uris = _rendition_uris(master)
+
+    def load(uri):
+        absolute_uri = urljoin(base_uri, uri)
+        source = renditions.get(uri, renditions.get(absolute_uri))
+        try:
+            if source is None:
+                client = http_client or DefaultHTTPClient()
+                source, _ = client.download(absolute_uri, timeout, headers, verify_ssl)
+            if isinstance(source, str):
+                source = parse(source, fields=FIELDS)
+            elif not isinstance(source, dict):
+                source = source.data
+            return _Timeline(source)
+        except Exception as error:
+            return error
+
+    with ThreadPoolExecutor(max_workers) as pool:
+        timelines = dict(zip(uris, pool.map(load, uris)))
+        loaded = {
+            urljoin(base_uri, uri): timeline
+            for uri, timeline in timelines.items()
+            if isinstance(timeline, _Timeline)
+        }
+        reference = next(
+            (uri for uri in uris if isinstance(timelines[uri], _Timeline)), None
+        )
+
+        def check(uri):
+            timeline = timelines[uri]
+            if not isinstance(timeline, _Timeline):
+                error = Deviation(uri, "error", None, None, str(timeline), None)
+                return RenditionAlignment(uri, None, None, None, [error])
+            deviations = []
+            if uri != reference:
+                deviations += _compare(
+                    uri, timeline, reference, timelines[reference], tolerance
+                )
+            deviations += _check_reports(uri, timeline, urljoin(base_uri, uri), loaded)
+            return RenditionAlignment(
+                uri,
+                timeline.first_msn,
+                timeline.last_msn,
+                timeline.last_part,
+                deviations,
+            )
+
+        return AlignmentReport(reference, list(pool.map(check, uris)))
+
+
+def _compare(uri, timeline, reference_uri, reference, tolerance):
+    common = sorted(timeline.segments.keys() & reference.segments.keys())
+    if not common:
+        return [
+            Deviation(
+                uri,
+                "media_sequence",
+                None,
+                (reference.first_msn, reference.last_msn),
+                (timeline.first_msn, timeline.last_msn),
+                reference_uri,
+            )
+        ]
+
+    deviations = []
+    anchor = timeline.segments[common[0]][0]
+    reference_anchor = reference.segments[common[0]][0]
+    boundary = drift = None
+    discontinuity = None
+    for msn in common:
+        offset, date_time, discontinuity_sequence = timeline.segments[msn]
+        expected_offset, expected_date_time, expected_sequence = reference.segments[msn]
+        error = abs((offset - anchor) - (expected_offset - reference_anchor))
+        if error > tolerance and (boundary is None or error > boundary[0]):
+            boundary = (error, msn, expected_offset - reference_anchor, offset - anchor)
+        if date_time is not None and expected_date_time is not None:
+            error = abs((date_time - expected_date_time).total_seconds())
+            if error > tolerance and (drift is None or error > drift[0]):
+                drift = (error, msn, expected_date_time, date_time)
+        if discontinuity is None and discontinuity_sequence != expected_sequence:
+            discontinuity = (msn, expected_sequence, discontinuity_sequence)
+
+    if boundary is not None:
+        deviations.append(Deviation(uri, "boundary", *boundary[1:], reference_uri))
+    if discontinuity is not None:
+        deviations.append(
+            Deviation(uri, "discontinuity_sequence", *discontinuity, reference_uri)
+        )
+    if drift is not None:
+        deviations.append(
+            Deviation(uri, "program_date_time", *drift[1:], reference_uri)
+        )
+    return deviations
+
+
+def _check_reports(uri, timeline, absolute_uri, loaded):
+    deviations = []
+    for report in timeline.rendition_reports:
+        if not report.get("uri"):
+            continue
+        target_uri = urljoin(absolute_uri, report["uri"])
+        target = loaded.get(target_uri)
+        if target is None:
+            continue
+        reported = (report.get("last_msn"), report.get("last_part"))
+        actual = (target.last_msn, target.last_part)
+        if any(
+            value is not None and value != expected
+            for value, expected in zip(reported, actual)
+        ):
+            deviations.append(
+                Deviation(
+                    uri, "rendition_report", reported[0], actual, reported, target_uri
+                )
+            )
+    return deviations
@@ -0,0 +1,185 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+"""
+Resolved byte ranges and range request planning.
+
+The parser keeps EXT-X-BYTERANGE values as the raw ``length[@offset]``
+text. `resolve_byteranges` turns the byte ranges of a media playlist's
+segments, partial segments, EXT-X-MAP sections and preload hint into
+absolute `ByteRange` triples, filling in implicit offsets the way the HLS
+specification does: a sub-range without an offset starts right after the
+previous sub-range of the same resource.
+
+`plan_range_requests` then merges neighbouring ranges of the same resource
+into fewer HTTP range requests, each no larger than a size cap.
+"""
+
+from collections import namedtuple
+from urllib.parse import urljoin
+
+
+class ByteRange(namedtuple("ByteRange", ["uri", "start", "end"])):
+    """
+    A resolved sub-range of `uri`. `end` is exclusive, or None when the
+    range runs to the end of the resource (a preload hint without
+    BYTERANGE-LENGTH).
+    """
+
+    __slots__ = ()
+
+    @property
+    def length(self):
+        return None if self.end is None else self.end - self.start
+
+    @property
+    def header(self):
+        """The value of the HTTP Range header requesting this range."""
+        last = "" if self.end is None else self.end - 1
+        return f"bytes={self.start}-{last}"
+
+
+class RangeRequest(namedtuple("RangeRequest", ["uri", "start", "end", "ranges"])):
+    """
+    One planned HTTP range request covering `ranges`, the `ByteRange`
+    entries it was merged from, in their original order.
+    """
+
+    __slots__ = ()
+
+    length = ByteRange.length
+    header = ByteRange.header
+
+    def slices(self):
+        """Yield (byterange, slice) locating each range in the response body."""
+        for byterange in self.ranges:
+            start = byterange.start - self.start
+            end = None if byterange.end is None else byterange.end - self.start
+            yield byterange, slice(start, end)
+
+
+def parse_byterange(value):
+    """
+    Split an EXT-X-BYTERANGE (or quoted BYTERANGE attribute) value into
+    (length, offset), offset being None when it is implicit.
+    """
+    length, sep, offset = value.strip().strip('"').partition("@")
+    try:
+        return int(length), int(offset) if sep else None
+    except ValueError:
+        raise ValueError(f"invalid byte range {value!r}") from None
+
+
+def _uri(item, joined):
+    key = (item.base_uri, item.uri)
+    uri = joined.get(key)
+    if uri is None:
+        uri = joined[key] = urljoin(item.base_uri or "", item.uri)
+    return uri
+
+
+def _resolve(item, ends, joined):
+    """Resolve `item.byterange`, updating the last end seen for its URI."""
+    uri = _uri(item, joined)
+    length, offset = parse_byterange(item.byterange)
+    if offset is None:
+        offset = ends.get(uri)
+        if offset is None:
+            raise ValueError(
+                f"byte range {item.byterange!r} of {item.uri!r} has no offset "
+                "and no previous sub-range of the same resource"
+            )
+    ends[uri] = offset + length
+    return ByteRange(uri, offset, offset + length)
+
+
+def resolve_byteranges(playlist):
+    """
+    Return (item, ByteRange) pairs for every byte range in `playlist`, in
+    playlist order: each EXT-X-MAP the first time a segment uses it, then a
+    segment's parts, the segment itself and finally the preload hint. Items
+    without a byte range are left out.
+
+    Segments and partial segments continue implicit offsets separately,
+    since the parts of a segment cover the same bytes as the segment. An
+    EXT-X-MAP without an offset starts at 0. URIs are joined with the
+    playlist `base_uri` when it is set, so ranges of the same resource
+    compare equal. Raises ValueError for a malformed byte range or an
+    implicit offset with no earlier sub-range of the same resource.
+    """
+    resolved = []
+    # Single-file assets repeat one URI for every segment; join it once
+    joined = {}
+    segment_ends = {}
+    part_ends = {}
+    init_section = None
+    for segment in playlist.segments:
+        if segment.init_section is not init_section and (
+            segment.init_section is not None and segment.init_section != init_section
+        ):
+            init_section = segment.init_section
+            if init_section.byterange:
+                length, offset = parse_byterange(init_section.byterange)
+                offset = offset or 0
+                resolved.append(
+                    (
+                        init_section,
+                        ByteRange(_uri(init_section, joined), offset, offset + length),
+                    )
+                )
+        for part in segment.parts:
+            if part.byterange:
+                resolved.append((part, _resolve(part, part_ends, joined)))
+        if segment.byterange and segment.uri is not None:
+            resolved.append((segment, _resolve(segment, segment_ends, joined)))
+
+    hint = playlist.preload_hint
+    if hint is not None and (
+        hint.byterange_start is not None or hint.byterange_length is not None
+    ):
+        start = hint.byterange_start or 0
+        end = None if hint.byterange_length is None else start + hint.byterange_length
+        resolved.append((hint, ByteRange(_uri(hint, joined), start, end)))
+    return resolved
+
+
+def plan_range_requests(ranges, max_bytes, max_gap=0):
+    """
+    Merge `ranges` (ByteRange entries, usually from `resolve_byteranges`)
+    into a list of `RangeRequest`.
+
+    Ranges are merged in the order given: a range joins the current
+    request when it has the same URI, starts no earlier than the request
+    and at most `max_gap` bytes past its end, and the merged request stays
+    within `max_bytes`. Gap bytes are fetched and discarded, so a small
+    `max_gap` trades bandwidth for fewer round trips. Ranges larger than
+    `max_bytes` and open-ended ranges get a request of their own.
+    """
+    if max_bytes < 1:
+        raise ValueError("max_bytes must be at least 1")
+    if max_gap < 0:
+        raise ValueError("max_gap must not be negative")
+
+    requests = []
+    uri = start = end = None
+    merged = []
+    for byterange in ranges:
+        if (
+            merged
+            and byterange.uri == uri
+            and end is not None
+            and byterange.end is not None
+            and start <= byterange.start <= end + max_gap
+            and max(end, byterange.end) - start <= max_bytes
+        ):
+            end = max(end, byterange.end)
+            merged.append(byterange)
+            continue
+        if merged:
+            requests.append(RangeRequest(uri, start, end, merged))
+        uri, start, end = byterange
+        merged = [byterange]
+    if merged:
+        requests.append(RangeRequest(uri, start, end, merged))
+    return requests
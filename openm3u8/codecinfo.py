@@ -0,0 +1,284 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+"""
+Structured CODECS and CHANNELS attribute values.
+
+`parse_codecs` splits a CODECS attribute into `Codec` records, decoding
+the RFC 6381 parameters of the common video and audio formats: profile,
+level, tier and bit depth of AVC, HEVC, Dolby Vision, AV1 and VP9, and the
+audio object type of MPEG-4 audio. The same few dozen strings recur in
+every playlist, so results are memoized for the life of the process;
+records are immutable and safe to share.
+
+`parse_channels` splits an EXT-X-MEDIA CHANNELS attribute ("2", "16/JOC",
+"6/-/BINAURAL") into its parameters.
+"""
+
+from collections import namedtuple
+from functools import lru_cache
+
+
+class Codec(
+    namedtuple(
+        "Codec",
+        [
+            "codec",
+            "sample_entry",
+            "family",
+            "kind",
+            "profile",
+            "profile_name",
+            "level",
+            "tier",
+            "bit_depth",
+            "channels",
+        ],
+    )
+):
+    """
+    One entry of a CODECS attribute.
+
+    `codec` is the entry as written and `sample_entry` its first element
+    ("avc1", "hvc1", "mp4a"...). `family` names the format whatever sample
+    entry carries it ("avc", "hevc", "dolby-vision", "av1", "vp9", "aac",
+    "mp3", "ac-3", "ec-3"...) and `kind` is "video", "audio", "subtitles"
+    or "image", or None for unknown formats. `profile` is the numeric
+    profile as the format's codec string encodes it (the audio object type
+    for MPEG-4 audio), `profile_name` its usual name, `level` a number
+    such as 4.1, `tier` "Main" or "High". `channels` is only set when the
+    codec implies it (HE-AAC v2 is always stereo). Fields a codec string
+    does not carry are None.
+    """
+
+    __slots__ = ()
+
+
+Channels = namedtuple("Channels", ["count", "coding", "rendering"])
+Channels.__doc__ = """
+A CHANNELS attribute: the audio channel `count`, then tuples of the
+`coding` identifiers ("JOC") and `rendering` identifiers ("BINAURAL",
+"IMMERSIVE", "DOWNMIX"), empty when absent or "-".
+"""
+
+_FAMILIES = {
+    "avc1": ("avc", "video"),
+    "avc3": ("avc", "video"),
+    "hvc1": ("hevc", "video"),
+    "hev1": ("hevc", "video"),
+    "dvh1": ("dolby-vision", "video"),
+    "dvhe": ("dolby-vision", "video"),
+    "dva1": ("dolby-vision", "video"),
+    "dvav": ("dolby-vision", "video"),
+    "dav1": ("dolby-vision", "video"),
+    "av01": ("av1", "video"),
+    "vp09": ("vp9", "video"),
+    "vp08": ("vp8", "video"),
+    "vp8": ("vp8", "video"),
+    "vp9": ("vp9", "video"),
+    "mp4v": ("mpeg4-visual", "video"),
+    "mp4a": ("aac", "audio"),
+    "ac-3": ("ac-3", "audio"),
+    "ec-3": ("ec-3", "audio"),
+    "ac-4": ("ac-4", "audio"),
+    "mhm1": ("mpeg-h", "audio"),
+    "mha1": ("mpeg-h", "audio"),
+    "opus": ("opus", "audio"),
+    "Opus": ("opus", "audio"),
+    "fLaC": ("flac", "audio"),
+    "alac": ("alac", "audio"),
+    "mp3": ("mp3", "audio"),
+    "wvtt": ("webvtt", "subtitles"),
+    "stpp": ("ttml", "subtitles"),
+    "jpeg": ("jpeg", "image"),
+}
+
+_AVC_PROFILES = {
+    66: "Baseline",
+    77: "Main",
+    88: "Extended",
+    100: "High",
+    110: "High 10",
+    122: "High 4:2:2",
+    244: "High 4:4:4 Predictive",
+}
+_HEVC_PROFILES = {
+    1: "Main",
+    2: "Main 10",
+    3: "Main Still Picture",
+    4: "Format Range Extensions",
+}
+_AV1_PROFILES = {0: "Main", 1: "High", 2: "Professional"}
+_AAC_OBJECT_TYPES = {
+    1: "AAC Main",
+    2: "AAC-LC",
+    5: "HE-AAC",
+    29: "HE-AAC v2",
+    34: "MP3",
+    42: "xHE-AAC",
+}
+# mp4a object type indications that are not MPEG-4 audio
+_MP4A_FAMILIES = {0x69: "mp3", 0x6B: "mp3", 0xA5: "ac-3", 0xA6: "ec-3"}
+
+
+def _avc(fields):
+    # avc1.PPCCLL in hex, or the legacy avc1.PP.LL in decimal
+    if len(fields) == 1 and len(fields[0]) == 6:
+        profile = int(fields[0][:2], 16)
+        level = int(fields[0][4:], 16)
+    elif len(fields) == 2:
+        profile, level = int(fields[0]), int(fields[1])
+    else:
+        return {}
+    return {
+        "profile": profile,
+        "profile_name": _AVC_PROFILES.get(profile),
+        "level": level / 10,
+    }
+
+
+def _hevc(fields):
+    # hvc1.[A-C]profile.compatibility.(L|H)level[.constraints...]
+    if len(fields) < 3:
+        return {}
+    profile = int(fields[0].lstrip("ABC"))
+    tier_level = fields[2]
+    if tier_level[:1] not in ("L", "H"):
+        return {"profile": profile, "profile_name": _HEVC_PROFILES.get(profile)}
+    return {
+        "profile": profile,
+        "profile_name": _HEVC_PROFILES.get(profile),
+        "tier": "Main" if tier_level[0] == "L" else "High",
+        "level": round(int(tier_level[1:]) / 30, 1),
+    }
+
+
+def _dolby_vision(fields):
+    # dvh1.PP.LL, both decimal
+    if len(fields) < 2:
+        return {}
+    profile = int(fields[0])
+    return {
+        "profile": profile,
+        "profile_name": f"Profile {profile}",
+        "level": int(fields[1]),
+    }
+
+
+def _av1(fields):
+    # av01.P.LLT.DD[...]: profile, seq_level_idx and tier, bit depth
+    if len(fields) < 3:
+        return {}
+    profile = int(fields[0])
+    level_index = int(fields[1][:-1])
+    return {
+        "profile": profile,
+        "profile_name": _AV1_PROFILES.get(profile),
+        "level": 2 + (level_index >> 2) + (level_index & 3) / 10,
+        "tier": "High" if fields[1][-1] == "H" else "Main",
+        "bit_depth": int(fields[2]),
+    }
+
+
+def _vp9(fields):
+    # vp09.PP.LL.DD[...]: level 31 is 3.1
+    if len(fields) < 3:
+        return {}
+    profile = int(fields[0])
+    return {
+        "profile": profile,
+        "profile_name": f"Profile {profile}",
+        "level": int(fields[1]) / 10,
+        "bit_depth": int(fields[2]),
+    }
+
+
+def _mp4a(fields):
+    # mp4a.OO[.A]: object type indication in hex, audio object type
+    if not fields:
+        return {}
+    indication = int(fields[0], 16)
+    if indication in _MP4A_FAMILIES:
+        return {"family": _MP4A_FAMILIES[indication]}
+    if indication != 0x40 or len(fields) < 2:
+        return {}
+    object_type = int(fields[1])
+    return {
+        "family": "mp3" if object_type == 34 else "aac",
+        "profile": object_type,
+        "profile_name": _AAC_OBJECT_TYPES.get(object_type),
+        "channels": 2 if object_type == 29 else None,
+    }
+
+
+_PARAMETERS = {
+    "avc": _avc,
+    "hevc": _hevc,
+    "dolby-vision": _dolby_vision,
+    "av1": _av1,
+    "vp9": _vp9,
+    "aac": _mp4a,
+}
+
+
+@lru_cache(maxsize=1024)
+def parse_codec(codec):
+    """
+    Return the `Codec` record of a single CODECS entry. Unknown formats
+    and malformed parameters leave the fields they would fill as None.
+    """
+    codec = codec.strip()
+    sample_entry, _, rest = codec.partition(".")
+    family, kind = _FAMILIES.get(sample_entry, (sample_entry.lower(), None))
+    fields = {"family": family}
+    parameters = _PARAMETERS.get(family)
+    if parameters is not None and rest:
+        try:
+            fields.update(parameters(rest.split(".")))
+        except ValueError:
+            pass
+    return Codec(
+        codec=codec,
+        sample_entry=sample_entry,
+        family=fields["family"],
+        kind=kind,
+        profile=fields.get("profile"),
+        profile_name=fields.get("profile_name"),
+        level=fields.get("level"),
+        tier=fields.get("tier"),
+        bit_depth=fields.get("bit_depth"),
+        channels=fields.get("channels"),
+    )
+
+
+@lru_cache(maxsize=1024)
+def parse_codecs(codecs):
+    """
+    Return a tuple of `Codec` records for a CODECS attribute value such as
+    "avc1.64001f,mp4a.40.2", in order. None and "" give an empty tuple.
+    """
+    if not codecs:
+        return ()
+    return tuple(
+        parse_codec(codec) for codec in codecs.strip('"').split(",") if codec.strip()
+    )
+
+
+@lru_cache(maxsize=256)
+def parse_channels(channels):
+    """Return the `Channels` of a CHANNELS attribute value, or None."""
+    if not channels:
+        return None
+    parameters = channels.strip('"').split("/")
+    try:
+        count = int(parameters[0])
+    except ValueError:
+        count = None
+
+    def identifiers(index):
+        if len(parameters) <= index or parameters[index] in ("", "-"):
+            return ()
+        return tuple(parameters[index].split(","))
+
+    return Channels(count, identifiers(1), identifiers(2))
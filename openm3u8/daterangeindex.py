@@ -0,0 +1,267 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+"""
+Time-range queries over EXT-X-DATERANGE tags.
+
+`DateRangeIndex` collects the date ranges of a playlist, wherever they sit
+in its segments and partial segments, merges tags that share an ID the way
+RFC 8216 section 4.3.2.7 describes (a later tag may add attributes, such
+as an END-DATE or SCTE35-IN, to an earlier one) and answers "which date
+ranges are active at T" and "which overlap [T0, T1)" in O(log n + k).
+
+A date range spans [START-DATE, end), where end is END-DATE, else
+START-DATE plus DURATION, else plus PLANNED-DURATION, else, with
+END-ON-NEXT=YES, the START-DATE of the next date range of the same CLASS.
+A date range none of these bound is open-ended. Ranges without a usable
+START-DATE are only reachable through `by_id`.
+"""
+
+import bisect
+from datetime import datetime, timedelta
+
+from openm3u8.parser import cast_date_time
+
+# Attributes of DateRange objects, keyed by their parser names
+_ATTRIBUTES = (
+    ("id", "id"),
+    ("start_date", "start_date"),
+    ("class", "class_"),
+    ("end_date", "end_date"),
+    ("duration", "duration"),
+    ("planned_duration", "planned_duration"),
+    ("scte35_cmd", "scte35_cmd"),
+    ("scte35_out", "scte35_out"),
+    ("scte35_in", "scte35_in"),
+    ("end_on_next", "end_on_next"),
+)
+
+
+def _attributes(daterange):
+    attributes = {key: getattr(daterange, name) for key, name in _ATTRIBUTES}
+    attributes.update(daterange.x_client_attrs)
+    return attributes
+
+
+def _merge(daterange, update):
+    """
+    Return `daterange` with the attributes `update` sets, as a new object
+    of the same type, or `daterange` itself when nothing changes.
+    """
+    attributes = _attributes(daterange)
+    changed = False
+    for key, value in _attributes(update).items():
+        if value is not None and attributes.get(key) != value:
+            attributes[key] = value
+            changed = True
+    return type(daterange)(**attributes) if changed else daterange
+
+
+def _date_time(value):
+    if value is None or isinstance(value, datetime):
+        return value
+    try:
+        return cast_date_time(value)
+    except (TypeError, ValueError):
+        return None
+
+
+def _query_time(value):
+    return value if isinstance(value, datetime) else cast_date_time(value)
+
+
+class _IntervalTree:
+    """
+    Static intervals sorted by start, searched as an implicit balanced
+    binary tree: the node of the slice [lo, hi) is its midpoint, and
+    `max_ends[mid]` is the latest end in that slice, so subtrees ending
+    before the query are skipped.
+    """
+
+    def __init__(self, entries):
+        # entries: (start, end, order, daterange), sorted
+        self.entries = entries
+        self.starts = [entry[0] for entry in entries]
+        self.max_ends = [None] * len(entries)
+        self._build(0, len(entries))
+
+    def _build(self, lo, hi):
+        if lo >= hi:
+            return None
+        mid = (lo + hi) // 2
+        latest = self.entries[mid][1]
+        for child in (self._build(lo, mid), self._build(mid + 1, hi)):
+            if child is not None and child > latest:
+                latest = child
+        self.max_ends[mid] = latest
+        return latest
+
+    def search(self, limit, when):
+        """
+        Return, in start order, the date ranges among the first `limit`
+        entries that end after `when`, or are instantaneous and start at
+        or after it.
+        """
+        found = []
+        self._search(0, len(self.entries), limit, when, found)
+        return found
+
+    def _search(self, lo, hi, limit, when, found):
+        if lo >= hi or lo >= limit:
+            return
+        mid = (lo + hi) // 2
+        if self.max_ends[mid] < when:
+            return
+        self._search(lo, mid, limit, when, found)
+        if mid < limit:
+            start, end, _, daterange = self.entries[mid]
+            if end > when or (end == start and start >= when):
+                found.append(daterange)
+            self._search(mid + 1, hi, limit, when, found)
+
+
+class DateRangeIndex:
+    """
+    Interval index over the date ranges of one or more playlists.
+
+    Build it from a playlist (`M3U8.daterange_index` does so on first
+    use), then `update` it with each reload of the playlist: tags whose ID
+    was already seen are merged into the indexed date range instead of
+    being added again. The trees behind the time queries are rebuilt on
+    the first query after a change.
+
+    Times are datetimes or ISO 8601 strings, and must be timezone-aware
+    when the playlist's dates are (as they are when written with a zone
+    designator, which RFC 8216 requires).
+    """
+
+    def __init__(self, playlist=None):
+        self._by_id = {}
+        self._trees = None
+        if playlist is not None:
+            self.update(playlist)
+
+    def update(self, playlist):
+        """
+        Add the date ranges of `playlist`, a `M3U8` or an iterable of
+        `DateRange` objects, merging those with an ID already indexed.
+        """
+        if hasattr(playlist, "segments"):
+            playlist = _playlist_dateranges(playlist)
+        for daterange in playlist:
+            known = self._by_id.get(daterange.id)
+            self._by_id[daterange.id] = (
+                daterange if known is None else _merge(known, daterange)
+            )
+        self._trees = None
+
+    def __len__(self):
+        return len(self._by_id)
+
+    def __iter__(self):
+        return iter(self._by_id.values())
+
+    def __contains__(self, daterange_id):
+        return daterange_id in self._by_id
+
+    def by_id(self, daterange_id):
+        """Return the date range with this ID, merged across updates, or None."""
+        return self._by_id.get(daterange_id)
+
+    def by_class(self, class_):
+        """Return the date ranges of this CLASS, in start order."""
+        tree = self._get_trees().get(class_)
+        return [] if tree is None else [entry[3] for entry in tree.entries]
+
+    def active_at(self, when, class_=None):
+        """
+        Return the date ranges active at `when`, in start order, optionally
+        only those of CLASS `class_`. Instantaneous ranges are active at
+        their START-DATE.
+        """
+        when = _query_time(when)
+        tree = self._get_trees().get(class_, _EMPTY)
+        return tree.search(bisect.bisect_right(tree.starts, when), when)
+
+    def overlapping(self, start, end, class_=None):
+        """
+        Return the date ranges overlapping [start, end), in start order,
+        optionally only those of CLASS `class_`.
+        """
+        start, end = _query_time(start), _query_time(end)
+        tree = self._get_trees().get(class_, _EMPTY)
+        return tree.search(bisect.bisect_left(tree.starts, end), start)
+
+    def _get_trees(self):
+        if self._trees is None:
+            self._trees = self._build_trees()
+        return self._trees
+
+    def _build_trees(self):
+        starts = []
+        for order, daterange in enumerate(self._by_id.values()):
+            start = _date_time(daterange.start_date)
+            if start is not None:
+                starts.append((start, order, daterange))
+        starts.sort(key=lambda item: (item[0], item[1]))
+
+        # END-ON-NEXT ranges end where the next range of their class starts
+        next_start = {}
+        ends = [None] * len(starts)
+        for position in range(len(starts) - 1, -1, -1):
+            start, _, daterange = starts[position]
+            ends[position] = _end(daterange, start, next_start.get(daterange.class_))
+            next_start[daterange.class_] = start
+
+        by_class = {None: []}
+        for (start, order, daterange), end in zip(starts, ends):
+            entry = (start, end, order, daterange)
+            by_class[None].append(entry)
+            if daterange.class_ is not None:
+                by_class.setdefault(daterange.class_, []).append(entry)
+        return {class_: _IntervalTree(entries) for class_, entries in by_class.items()}
+
+
+def _end(daterange, start, next_start):
+    end_date = _date_time(daterange.end_date)
+    if end_date is not None:
+        return end_date
+    for duration in (daterange.duration, daterange.planned_duration):
+        if duration is not None:
+            return start + timedelta(seconds=duration)
+    if daterange.end_on_next == "YES" and next_start is not None:
+        return next_start
+    return _OPEN_END
+
+
+class _OpenEnd:
+    """Sorts after every datetime, aware or naive."""
+
+    def __gt__(self, other):
+        return other is not self
+
+    def __ge__(self, other):
+        return True
+
+    def __lt__(self, other):
+        return False
+
+    def __le__(self, other):
+        return other is self
+
+    def __eq__(self, other):
+        return other is self
+
+    __hash__ = object.__hash__
+
+
+_OPEN_END = _OpenEnd()
+_EMPTY = _IntervalTree([])
+
+
+def _playlist_dateranges(playlist):
+    for segment in playlist.segments:
+        yield from segment.dateranges
+        for part in segment.parts:
+            yield from part.dateranges
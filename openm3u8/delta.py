@@ -0,0 +1,116 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+"""
+Differences between two versions of the same media playlist.
+
+Segments are matched by media sequence number (EXT-X-MEDIA-SEQUENCE plus
+their position), so a reload of a sliding live window costs one pass over
+each segment list rather than a content-based list comparison. The pass
+runs in the C extension when it is available.
+"""
+
+import os
+
+
+def _diff_segments(old, new, old_media_sequence, new_media_sequence):
+    old_end = old_media_sequence + len(old)
+    new_end = new_media_sequence + len(new)
+    removed = [
+        segment
+        for msn, segment in enumerate(old, old_media_sequence)
+        if msn < new_media_sequence or msn >= new_end
+    ]
+    added = []
+    changed = []
+    for msn, segment in enumerate(new, new_media_sequence):
+        if msn < old_media_sequence or msn >= old_end:
+            added.append(segment)
+            continue
+        previous = old[msn - old_media_sequence]
+        if previous != segment:
+            changed.append((msn, previous, segment))
+    return removed, added, changed
+
+
+diff_segments = _diff_segments
+if os.environ.get("M3U8_NO_C_EXTENSION", "") != "1":
+    try:
+        from openm3u8._m3u8_parser import diff_segments
+    except ImportError:
+        pass
+
+
+def _changed_keys(old, new):
+    return tuple(
+        key for key in {**old, **new} if old.get(key, None) != new.get(key, None)
+    )
+
+
+def _skipped(data):
+    return (data.get("skip") or {}).get("skipped_segments") or 0
+
+
+def _first_listed(data):
+    """Media sequence number of the first segment listed in `data`."""
+    return (data.get("media_sequence") or 0) + _skipped(data)
+
+
+def diff(old, new):
+    """
+    Compare two parse results (or M3U8 objects) for the same rendition.
+
+    Returns a dict with:
+
+      `removed`   old segments no longer in the new window, usually its head
+      `added`     new segments not in the old window, usually its tail
+      `changed`   a dict per segment present in both whose content differs,
+                  with `media_sequence`, `fields` (the differing keys, such
+                  as "uri", "duration", "key" or "dateranges"), `old` and
+                  `new`
+      `header`    {key: (old value, new value)} for every other top-level
+                  field that differs, `media_sequence` included
+
+    Segments are numbered past those an EXT-X-SKIP delta update omits,
+    and old segments the new playlist skips are neither removed nor
+    changed. M3U8 objects are compared through their parsed `data`, so
+    changes made to the model after loading are not seen.
+    """
+    old = getattr(old, "data", old)
+    new = getattr(new, "data", new)
+    old_segments = old.get("segments", [])
+    new_segments = new.get("segments", [])
+
+    removed, added, changed = diff_segments(
+        old_segments, new_segments, _first_listed(old), _first_listed(new)
+    )
+    skipped = _skipped(new)
+    if skipped:
+        # Segments a delta update skips are still in the window
+        window_start = new.get("media_sequence") or 0
+        kept = {
+            id(segment)
+            for msn, segment in enumerate(old_segments, _first_listed(old))
+            if window_start <= msn < window_start + skipped
+        }
+        removed = [segment for segment in removed if id(segment) not in kept]
+    header = {
+        key: (old.get(key), new.get(key))
+        for key in {**old, **new}
+        if key != "segments" and old.get(key) != new.get(key)
+    }
+    return {
+        "removed": removed,
+        "added": added,
+        "changed": [
+            {
+                "media_sequence": msn,
+                "fields": _changed_keys(previous, segment),
+                "old": previous,
+                "new": segment,
+            }
+            for msn, previous, segment in changed
+        ],
+        "header": header,
+    }
@@ -1,31 +1,145 @@
+import codecs
 import gzip
 import ssl
 import urllib.request
+import zlib
 from urllib.parse import urljoin
 
+# Bytes read from the response at a time when streaming
+CHUNK_SIZE = 64 * 1024
+
+_GZIP_MAGIC = b"\037\213"
+
 
 class DefaultHTTPClient:
     def __init__(self, proxies=None):
         self.proxies = proxies
 
-    def download(self, uri, timeout=None, headers={}, verify_ssl=True):
+    def _open(self, uri, timeout, headers, verify_ssl):
         proxy_handler = urllib.request.ProxyHandler(self.proxies)
         https_handler = HTTPSHandler(verify_ssl=verify_ssl)
         opener = urllib.request.build_opener(proxy_handler, https_handler)
         opener.addheaders = headers.items()
         resource = opener.open(uri, timeout=timeout)
-        base_uri = urljoin(resource.geturl(), ".")
+        return resource, urljoin(resource.geturl(), ".")
+
+    def download(self, uri, timeout=None, headers={}, verify_ssl=True):
+        resource, base_uri = self._open(uri, timeout, headers, verify_ssl)
+        charset = resource.headers.get_content_charset(failobj="utf-8")
 
         if resource.info().get("Content-Encoding") == "gzip":
-            content = gzip.decompress(resource.read()).decode(
-                resource.headers.get_content_charset(failobj="utf-8")
-            )
+            # Decompress in pieces so the whole uncompressed body is never
+            # held as bytes next to the decoded text
+            content = "".join(_decode(_gunzip([resource.read()]), charset))
         else:
-            content = resource.read().decode(
-                resource.headers.get_content_charset(failobj="utf-8")
-            )
+            content = resource.read().decode(charset)
         return content, base_uri
 
+    def stream(
+        self, uri, timeout=None, headers={}, verify_ssl=True, chunk_size=CHUNK_SIZE
+    ):
+        """
+        Like `download`, but return (chunks, base_uri) where chunks is an
+        iterator of decoded text pieces read, gunzipped and decoded
+        `chunk_size` bytes at a time. The response is closed when the
+        iterator is exhausted or closed.
+        """
+        resource, base_uri = self._open(uri, timeout, headers, verify_ssl)
+        return _stream(resource, chunk_size), base_uri
+
+
+def _stream(resource, chunk_size):
+    try:
+        charset = resource.headers.get_content_charset(failobj="utf-8")
+        chunks = iter(lambda: resource.read(chunk_size), b"")
+        if resource.info().get("Content-Encoding") == "gzip":
+            chunks = _gunzip(chunks, chunk_size)
+        yield from _decode(chunks, charset)
+    finally:
+        resource.close()
+
+
+# zlib's messages for the checks gzip.decompress reports as BadGzipFile
+_GZIP_ERRORS = {
+    "unknown compression method": "Unknown compression method",
+    "incorrect data check": "CRC check failed",
+    "incorrect length check": "Incorrect length of data produced",
+}
+
+
+def _gzip_error(error):
+    for check, message in _GZIP_ERRORS.items():
+        if check in str(error):
+            return gzip.BadGzipFile(message)
+    return error
+
+
+def _gunzip(chunks, max_length=CHUNK_SIZE):
+    """
+    Decompress gzip `chunks`, yielding at most `max_length` bytes at once.
+    Errors are those of gzip.decompress: BadGzipFile for a bad header or
+    check, EOFError for a truncated member and zlib.error for corrupt data.
+    """
+    decompressor = None
+    head = b""  # Start of the next member, until its magic number is read
+    members = 0
+    for data in chunks:
+        while data:
+            if decompressor is None:
+                if members and not head:
+                    # Zero padding between members, as gzip.decompress allows
+                    data = data.lstrip(b"\0")
+                    if not data:
+                        break
+                needed = 2 - len(head)
+                head, data = head + data[:needed], data[needed:]
+                if len(head) < 2:
+                    break
+                if head != _GZIP_MAGIC:
+                    raise gzip.BadGzipFile(f"Not a gzipped file ({head!r})")
+                decompressor = zlib.decompressobj(16 + zlib.MAX_WBITS)
+                data, head = head + data, b""
+            try:
+                out = decompressor.decompress(data, max_length)
+            except zlib.error as error:
+                raise _gzip_error(error) from None
+            if out:
+                yield out
+            data = decompressor.unconsumed_tail
+            if decompressor.eof:
+                # Concatenated members are read on, as gzip.decompress does
+                data = decompressor.unused_data
+                decompressor = None
+                members += 1
+    if head:
+        raise gzip.BadGzipFile(f"Not a gzipped file ({head!r})")
+    if decompressor is not None:
+        # Output zlib held back when it filled max_length
+        try:
+            out = decompressor.flush()
+        except zlib.error as error:
+            raise _gzip_error(error) from None
+        if out:
+            yield out
+        if not decompressor.eof:
+            raise EOFError(
+                "Compressed file ended before the end-of-stream marker was reached"
+            )
+        rest = decompressor.unused_data.lstrip(b"\0")
+        if rest:
+            yield from _gunzip([rest], max_length)
+
+
+def _decode(chunks, charset):
+    decoder = codecs.getincrementaldecoder(charset)()
+    for data in chunks:
+        text = decoder.decode(data)
+        if text:
+            yield text
+    text = decoder.decode(b"", final=True)
+    if text:
+        yield text
+
 
 class HTTPSHandler:
     def __new__(self, verify_ssl=True):
@@ -1,22 +1,178 @@
+from functools import lru_cache
 from os.path import dirname
 from urllib.parse import urljoin, urlsplit
 
 
+def _join(base_uri, uri):
+    ret = urljoin(base_uri, uri)
+    if base_uri:
+        base_uri_parts = urlsplit(base_uri)
+        if (not base_uri_parts.scheme) and (not base_uri_parts.netloc):
+            return ret
+
+    if not urlsplit(ret).scheme:
+        raise ValueError("There can not be `absolute_uri` with no `base_uri` set")
+
+    return ret
+
+
+@lru_cache(maxsize=64)
+def _join_prefix(base_uri):
+    """
+    Return what joining `base_uri` with a plain relative reference puts in
+    front of it, or None when such joins have to go through `_join`.
+    """
+    try:
+        probe = _join(base_uri, "x")
+    except ValueError:
+        return None
+    return probe[:-1] if probe.endswith("x") else None
+
+
+def _is_plain_reference(uri):
+    """
+    True for relative references that urljoin resolves by appending them to
+    the base directory: no scheme, no leading "/", "?", "#" or whitespace,
+    no dot or empty segments, no ";" parameters, no empty query or fragment
+    and no characters urlsplit would strip.
+    """
+    return (
+        uri[:1] not in ("", "/", "?", "#", ".", " ")
+        and ":" not in uri
+        and "/." not in uri
+        and "//" not in uri
+        and ";" not in uri
+        and uri[-1] not in "?#"
+        and "?#" not in uri
+        and uri.isprintable()
+    )
+
+
+def resolve_uri(base_uri, uri):
+    """Return `uri` joined with `base_uri` like `BasePathMixin.absolute_uri`."""
+    if _is_plain_reference(uri):
+        prefix = _join_prefix(base_uri)
+        if prefix is not None:
+            return prefix + uri
+    return _join(base_uri, uri)
+
+
+def absolute_uris(items):
+    """
+    Return the `absolute_uri` of each of `items`, sharing the base URI
+    parsing between them. Results are cached on the items like the
+    property does.
+    """
+    results = []
+    for item in items:
+        uri = item.uri
+        if uri is None:
+            results.append(None)
+            continue
+        base_uri = item.base_uri
+        cached = item._absolute_uri
+        if cached is not None and cached[0] == base_uri and cached[1] == uri:
+            results.append(cached[2])
+            continue
+        ret = resolve_uri(base_uri, uri)
+        item._absolute_uri = (base_uri, uri, ret)
+        results.append(ret)
+    return results
+
+
+class BaseContext:
+    """
+    The base URI and base path shared by the objects of one playlist.
+
+    Re-basing a playlist updates its context once instead of visiting every
+    object. Each object remembers the `uri_version` and `path_version` it
+    last agreed with: a base URI set on the object itself is kept until the
+    context's base URI changes again, and a new base path is applied to the
+    object's URI the next time that URI is read.
+    """
+
+    __slots__ = ("base_uri", "base_path", "uri_version", "path_version")
+
+    def __init__(self, base_uri=None):
+        self.base_uri = base_uri
+        self.base_path = None
+        self.uri_version = 0
+        self.path_version = 0
+
+    def set_base_uri(self, base_uri):
+        self.base_uri = base_uri
+        self.uri_version += 1
+
+    def set_base_path(self, base_path):
+        self.base_path = base_path
+        self.path_version += 1
+
+
+def _rebased_uri(uri, newbase_path):
+    """Return `uri` with its directory replaced by `newbase_path`."""
+    base_path = dirname(uri.split("?")[0])
+    if not base_path:
+        return f"{newbase_path}/{uri}"
+    return uri.replace(base_path, newbase_path)
+
+
 class BasePathMixin:
+    _context = None
+    _uri = None
+    _base_uri = None
+    _uri_version = 0
+    _path_version = 0
+    # (base_uri, uri, absolute_uri) of the last resolution; it is reused
+    # while neither input changes
+    _absolute_uri = None
+
+    def _attach(self, context):
+        """Share `context`, keeping the current base URI and URI."""
+        self._context = context
+        self._uri_version = context.uri_version
+        self._path_version = context.path_version
+
+    @property
+    def uri(self):
+        context = self._context
+        if context is not None and self._path_version != context.path_version:
+            self._path_version = context.path_version
+            if self._uri is not None:
+                self._uri = _rebased_uri(self._uri, context.base_path)
+        return self._uri
+
+    @uri.setter
+    def uri(self, uri):
+        self._uri = uri
+        if self._context is not None:
+            self._path_version = self._context.path_version
+
+    @property
+    def base_uri(self):
+        context = self._context
+        if context is None or self._uri_version == context.uri_version:
+            return self._base_uri
+        return context.base_uri
+
+    @base_uri.setter
+    def base_uri(self, base_uri):
+        self._base_uri = base_uri
+        if self._context is not None:
+            self._uri_version = self._context.uri_version
+
     @property
     def absolute_uri(self):
-        if self.uri is None:
+        uri = self.uri
+        if uri is None:
             return None
 
-        ret = urljoin(self.base_uri, self.uri)
-        if self.base_uri:
-            base_uri_parts = urlsplit(self.base_uri)
-            if (not base_uri_parts.scheme) and (not base_uri_parts.netloc):
-                return ret
-
-        if not urlsplit(ret).scheme:
-            raise ValueError("There can not be `absolute_uri` with no `base_uri` set")
+        base_uri = self.base_uri
+        cached = self._absolute_uri
+        if cached is not None and cached[0] == base_uri and cached[1] == uri:
+            return cached[2]
 
+        ret = resolve_uri(base_uri, uri)
+        self._absolute_uri = (base_uri, uri, ret)
         return ret
 
     @property
@@ -32,13 +188,56 @@ class BasePathMixin:
     @base_path.setter
     def base_path(self, newbase_path):
         if self.uri is not None:
-            if not self.base_path:
-                self.uri = f"{newbase_path}/{self.uri}"
-            else:
-                self.uri = self.uri.replace(self.base_path, newbase_path)
+            self.uri = _rebased_uri(self.uri, newbase_path)
 
 
 class GroupedBasePathMixin:
+    """
+    Lists of BasePathMixin objects. Once a list shares a playlist's
+    BaseContext, the items added to it share the context too.
+    """
+
+    _context = None
+
+    def _attach(self, context):
+        self._context = context
+        for item in self:
+            if item is not None:
+                item._attach(context)
+
+    def _adopt(self, items):
+        if self._context is not None:
+            for item in items:
+                if item is not None:
+                    item._attach(self._context)
+        return items
+
+    def append(self, item):
+        super().append(item)
+        self._adopt((item,))
+
+    def insert(self, index, item):
+        super().insert(index, item)
+        self._adopt((item,))
+
+    def extend(self, items):
+        super().extend(self._adopt(list(items)))
+
+    def __iadd__(self, items):
+        self.extend(items)
+        return self
+
+    def __setitem__(self, index, value):
+        if isinstance(index, slice):
+            value = self._adopt(list(value))
+        else:
+            self._adopt((value,))
+        super().__setitem__(index, value)
+
+    def absolute_uris(self):
+        """Return the `absolute_uri` of every item, in order."""
+        return absolute_uris(self)
+
     def _set_base_uri(self, new_base_uri):
         for item in self:
             item.base_uri = new_base_uri
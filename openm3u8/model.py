@@ -2,11 +2,22 @@
 # Modifications Copyright (c) 2026 Wurl.
 # Use of this source code is governed by a MIT License
 # license that can be found in the LICENSE file.
+import bisect
 import decimal
+import itertools
 import os
 
-from openm3u8.mixins import BasePathMixin, GroupedBasePathMixin
+from openm3u8.byterange import resolve_byteranges
+from openm3u8.codecinfo import parse_channels, parse_codecs
+from openm3u8.daterangeindex import DateRangeIndex
+from openm3u8.mixins import (
+    BaseContext,
+    BasePathMixin,
+    GroupedBasePathMixin,
+    absolute_uris,
+)
 from openm3u8.parser import parse, format_date_time
+from openm3u8.scte35 import SpliceInfoSection, decode as decode_scte35
 
 # Try to import the C extension for faster parsing, fall back to Python
 if os.environ.get("M3U8_NO_C_EXTENSION", "") != "1":
@@ -147,6 +158,12 @@ class M3U8:
         https://github.com/image-media-playlist/spec/blob/master/image_media_playlist_v0_4.pdf
     """
 
+    # Content fingerprint, set by load()/loads()
+    fingerprint = None
+    # Parse options the fingerprinted content was parsed with
+    _parse_options = None
+    _daterange_index = None
+
     simple_attributes = (
         # obj attribute      # parser attribute
         ("is_variant", "is_variant"),
@@ -170,17 +187,38 @@ class M3U8:
         base_uri=None,
         strict=False,
         custom_tags_parser=None,
+        custom_tag_handlers=None,
+        fields=None,
     ):
         if content is not None:
-            self.data = parse(content, strict, custom_tags_parser)
+            data = parse(
+                content, strict, custom_tags_parser, custom_tag_handlers, fields
+            )
         else:
-            self.data = {}
+            data = {}
+        self._load(data, base_path, base_uri)
+
+    @classmethod
+    def from_data(cls, data, base_path=None, base_uri=None):
+        """
+        Build a playlist from the dict returned by `parse`, for instance one
+        restored with `openm3u8.loadb`, without parsing any text.
+        """
+        playlist = cls.__new__(cls)
+        playlist._load(data, base_path, base_uri)
+        return playlist
+
+    def _load(self, data, base_path, base_uri):
+        self.data = data
+        self._daterange_index = None
         self._base_uri = base_uri
         if self._base_uri:
             if not self._base_uri.endswith("/"):
                 self._base_uri += "/"
 
         self._initialize_attributes()
+        self._context = BaseContext(self._base_uri)
+        self._attach_context()
         self.base_path = base_path
 
     def _initialize_attributes(self):
@@ -206,6 +244,16 @@ class M3U8:
         for attr, param in self.simple_attributes:
             setattr(self, attr, self.data.get(param))
 
+        self.ad_breaks = [
+            AdBreak(
+                segments=self.segments[
+                    ad_break["start_segment"] : ad_break["end_segment"] + 1
+                ],
+                **ad_break,
+            )
+            for ad_break in self.data.get("ad_breaks", [])
+        ]
+
         for i, segment in enumerate(self.segments, self.media_sequence or 0):
             segment.media_sequence = i
 
@@ -302,22 +350,8 @@ class M3U8:
     @base_uri.setter
     def base_uri(self, new_base_uri):
         self._base_uri = new_base_uri
-        self.media.base_uri = new_base_uri
-        self.playlists.base_uri = new_base_uri
-        self.iframe_playlists.base_uri = new_base_uri
-        self.segments.base_uri = new_base_uri
-        self.rendition_reports.base_uri = new_base_uri
-        self.image_playlists.base_uri = new_base_uri
-        for key in self.keys:
-            if key:
-                key.base_uri = new_base_uri
-        for key in self.session_keys:
-            if key:
-                key.base_uri = new_base_uri
-        if self.preload_hint:
-            self.preload_hint.base_uri = new_base_uri
-        if self.content_steering:
-            self.content_steering.base_uri = new_base_uri
+        self._attach_context()
+        self._context.set_base_uri(new_base_uri)
 
     @property
     def base_path(self):
@@ -328,25 +362,49 @@ class M3U8:
         self._base_path = newbase_path
         self._update_base_path()
 
+    @property
+    def daterange_index(self):
+        """
+        A `DateRangeIndex` over the date ranges of all segments and partial
+        segments, built on first access. Build a new one, or `update` it,
+        after adding or editing date ranges.
+        """
+        if self._daterange_index is None:
+            self._daterange_index = DateRangeIndex(self)
+        return self._daterange_index
+
     def _update_base_path(self):
         if self._base_path is None:
             return
-        for key in self.keys:
-            if key:
-                key.base_path = self._base_path
-        for key in self.session_keys:
-            if key:
-                key.base_path = self._base_path
-        self.media.base_path = self._base_path
-        self.segments.base_path = self._base_path
-        self.playlists.base_path = self._base_path
-        self.iframe_playlists.base_path = self._base_path
-        self.image_playlists.base_path = self._base_path
-        self.rendition_reports.base_path = self._base_path
-        if self.preload_hint:
-            self.preload_hint.base_path = self._base_path
-        if self.content_steering:
-            self.content_steering.base_path = self._base_path
+        self._attach_context()
+        self._context.set_base_path(self._base_path)
+
+    def _attach_context(self):
+        """
+        Share this playlist's BaseContext with every object holding a URI.
+        Lists keep their items attached as they change, so only objects and
+        lists assigned since the last call are visited.
+        """
+        context = self._context
+        for items in (
+            self.media,
+            self.segments,
+            self.playlists,
+            self.iframe_playlists,
+            self.image_playlists,
+            self.rendition_reports,
+        ):
+            if items._context is not context:
+                items._attach(context)
+        for item in (
+            *self.keys,
+            *self.session_keys,
+            *self.segment_map,
+            self.preload_hint,
+            self.content_steering,
+        ):
+            if item and item._context is not context:
+                item._attach(context)
 
     def add_playlist(self, playlist):
         self.is_variant = True
@@ -371,6 +429,43 @@ class M3U8:
     def add_rendition_report(self, report):
         self.rendition_reports.append(report)
 
+    def absolute_uris(self):
+        """
+        Returns (item, absolute_uri) pairs for every object with a URI: keys,
+        maps, media, variant and image playlists, segments with their parts
+        and maps, rendition reports, the preload hint and content steering.
+        The base URI is parsed once for all of them and every result is
+        cached on its item until its `uri` or `base_uri` changes.
+        """
+        items = [
+            *(key for key in self.keys if key),
+            *(key for key in self.session_keys if key),
+            *self.segment_map,
+            *self.media,
+            *self.playlists,
+            *self.iframe_playlists,
+            *self.image_playlists,
+        ]
+        for segment in self.segments:
+            items.extend(segment.parts)
+            if segment.init_section is not None:
+                items.append(segment.init_section)
+            items.append(segment)
+        items.extend(self.rendition_reports)
+        if self.preload_hint:
+            items.append(self.preload_hint)
+        if self.content_steering:
+            items.append(self.content_steering)
+        return list(zip(items, absolute_uris(items)))
+
+    def byteranges(self):
+        """
+        Returns (item, ByteRange) pairs with the resolved byte ranges of the
+        segments, parts, maps and preload hint. See
+        `openm3u8.byterange.resolve_byteranges`.
+        """
+        return resolve_byteranges(self)
+
     def dumps(self, timespec="milliseconds", infspec="auto"):
         """
         Returns the current m3u8 as a string.
@@ -458,6 +553,38 @@ class M3U8:
             os.makedirs(basename, exist_ok=True)
 
 
+def _scte35_section(attribute, encode):
+    """
+    A property decoding the SCTE-35 payload string in `attribute` on first
+    access, and again only when the string changes. Assigning a
+    `SpliceInfoSection` stores it back encoded by `encode`.
+    """
+    cache = f"_{attribute}_section"
+
+    def get(self):
+        payload = getattr(self, attribute)
+        if not payload:
+            return None
+        cached = self.__dict__.get(cache)
+        if cached is not None and cached[0] == payload:
+            return cached[1]
+        section = decode_scte35(payload)
+        self.__dict__[cache] = (payload, section)
+        return section
+
+    def set(self, section):
+        payload = None if section is None else encode(section)
+        setattr(self, attribute, payload)
+        self.__dict__[cache] = (payload, section)
+
+    return property(
+        get,
+        set,
+        doc=f"`{attribute}` decoded as an openm3u8.scte35.SpliceInfoSection,"
+        " or None. Raises ValueError when the payload is malformed.",
+    )
+
+
 class Segment(BasePathMixin):
     """
     A video segment from a M3U8 playlist
@@ -500,6 +627,10 @@ class Segment(BasePathMixin):
     `scte35`
       Base64 encoded SCTE35 metadata if available
 
+    `scte35_section`, `oatcls_scte35_section`
+      `scte35` and `oatcls_scte35` decoded as SpliceInfoSection records,
+      decoded on first access; assigning a section encodes it back
+
     `scte35_duration`
       Planned SCTE35 duration
 
@@ -564,8 +695,13 @@ class Segment(BasePathMixin):
         media_sequence=None,
         custom_parser_values=None,
     ):
+        # Set first so the attributes BaseContext attaches later are part of
+        # the instance layout from the start
+        self._context = None
+        self._uri_version = 0
+        self._path_version = 0
         self.media_sequence = media_sequence
-        self.uri = uri
+        self._uri = uri
         self.duration = duration
         self.title = title
         self._base_uri = base_uri
@@ -584,15 +720,15 @@ class Segment(BasePathMixin):
         self.scte35_elapsedtime = scte35_elapsedtime
         self.asset_metadata = asset_metadata
         self.key = keyobject
-        self.parts = PartialSegmentList(
+        self._parts = PartialSegmentList(
             [PartialSegment(base_uri=self._base_uri, **partial) for partial in parts]
             if parts
             else []
         )
         if init_section is not None:
-            self.init_section = InitializationSection(self._base_uri, **init_section)
+            self._init_section = InitializationSection(self._base_uri, **init_section)
         else:
-            self.init_section = None
+            self._init_section = None
         self.dateranges = DateRangeList(
             [DateRange(**daterange) for daterange in dateranges] if dateranges else []
         )
@@ -600,6 +736,11 @@ class Segment(BasePathMixin):
         self.blackout = blackout
         self.custom_parser_values = custom_parser_values or {}
 
+    scte35_section = _scte35_section("scte35", SpliceInfoSection.to_base64)
+    oatcls_scte35_section = _scte35_section(
+        "oatcls_scte35", SpliceInfoSection.to_base64
+    )
+
     def add_part(self, part):
         self.parts.append(part)
 
@@ -728,17 +869,166 @@ class Segment(BasePathMixin):
 
     @property
     def base_uri(self):
-        return self._base_uri
+        return super().base_uri
 
     @base_uri.setter
     def base_uri(self, newbase_uri):
-        self._base_uri = newbase_uri
+        super(Segment, self.__class__).base_uri.fset(self, newbase_uri)
         self.parts.base_uri = newbase_uri
         if self.init_section is not None:
             self.init_section.base_uri = newbase_uri
 
+    def _attach(self, context):
+        # The parts list shares the context too, so parts appended to it
+        # later follow the playlist's base_uri and base_path
+        self._context = context
+        self._uri_version = context.uri_version
+        self._path_version = context.path_version
+        self._parts._attach(context)
+        if self._init_section is not None:
+            self._init_section._attach(context)
+
+    @property
+    def parts(self):
+        return self._parts
+
+    @parts.setter
+    def parts(self, parts):
+        if not isinstance(parts, PartialSegmentList):
+            parts = PartialSegmentList(parts)
+        self._parts = parts
+        if self._context is not None:
+            parts._attach(self._context)
+
+    @property
+    def init_section(self):
+        return self._init_section
+
+    @init_section.setter
+    def init_section(self, init_section):
+        self._init_section = init_section
+        if self._context is not None and init_section is not None:
+            init_section._attach(self._context)
+
+
+class _SegmentIndex:
+    """
+    Lookup tables over a SegmentList, built once and reused until the list
+    changes.
+
+    `starts` holds each segment's playback offset from the first segment.
+    `wall_clock` holds (current_program_date_time, position) for segments
+    that have one, in time order, so lookups work across discontinuities
+    where the date-time jumps. `positions` maps media sequence numbers to
+    list positions.
+    """
+
+    def __init__(self, segments):
+        durations = [segment.duration or 0 for segment in segments]
+        self.starts = list(itertools.accumulate(durations, initial=0.0))
+        self.durations = durations
+        self.wall_clock = sorted(
+            (segment.current_program_date_time, position)
+            for position, segment in enumerate(segments)
+            if segment.current_program_date_time is not None
+        )
+        self.wall_clock_starts = [start for start, _ in self.wall_clock]
+        self.positions = {
+            segment.media_sequence: position
+            for position, segment in enumerate(segments)
+            if getattr(segment, "media_sequence", None) is not None
+        }
+
+
+def _invalidates_index(method):
+    def wrapper(self, *args, **kwargs):
+        self._index = None
+        return method(self, *args, **kwargs)
+
+    wrapper.__name__ = method.__name__
+    wrapper.__doc__ = method.__doc__
+    return wrapper
+
+
+class SegmentList(GroupedBasePathMixin, list):
+    """
+    List of Segment objects.
+
+    Besides list operations it answers time and media sequence lookups in
+    O(log n) from an index built on first use. List mutations rebuild the
+    index; call `invalidate_index()` after changing a segment's duration,
+    date-time or media sequence in place.
+    """
+
+    _index = None
+
+    append = _invalidates_index(GroupedBasePathMixin.append)
+    extend = _invalidates_index(GroupedBasePathMixin.extend)
+    insert = _invalidates_index(GroupedBasePathMixin.insert)
+    pop = _invalidates_index(list.pop)
+    remove = _invalidates_index(list.remove)
+    clear = _invalidates_index(list.clear)
+    sort = _invalidates_index(list.sort)
+    reverse = _invalidates_index(list.reverse)
+    __setitem__ = _invalidates_index(GroupedBasePathMixin.__setitem__)
+    __delitem__ = _invalidates_index(list.__delitem__)
+    __iadd__ = _invalidates_index(GroupedBasePathMixin.__iadd__)
+    __imul__ = _invalidates_index(list.__imul__)
+
+    def invalidate_index(self):
+        self._index = None
+
+    def _get_index(self):
+        if self._index is None:
+            self._index = _SegmentIndex(self)
+        return self._index
+
+    def at_time(self, offset):
+        """
+        Return the segment playing `offset` seconds after the start of the
+        first segment, or None when outside the list.
+        """
+        index = self._get_index()
+        position = bisect.bisect_right(index.starts, offset) - 1
+        if 0 <= position < len(self) and offset < index.starts[position + 1]:
+            return self[position]
+        return None
+
+    def at_program_date_time(self, when):
+        """
+        Return the segment whose wall-clock interval, from its
+        current_program_date_time over its duration, contains `when`, or
+        None when no segment does.
+        """
+        index = self._get_index()
+        position = bisect.bisect_right(index.wall_clock_starts, when) - 1
+        if position < 0:
+            return None
+        start, segment_position = index.wall_clock[position]
+        duration = index.durations[segment_position]
+        if (when - start).total_seconds() < duration:
+            return self[segment_position]
+        return None
+
+    def by_media_sequence(self, media_sequence):
+        """Return the segment with this media sequence number, or None."""
+        position = self._get_index().positions.get(media_sequence)
+        return None if position is None else self[position]
+
+    def between(self, start, end):
+        """
+        Return the segments overlapping the playback interval [start, end),
+        in seconds from the start of the first segment.
+        """
+        index = self._get_index()
+        first = max(bisect.bisect_right(index.starts, start) - 1, 0)
+        last = bisect.bisect_left(index.starts, end, lo=first)
+        return [
+            segment
+            for position, segment in enumerate(self[first:last], first)
+            if index.starts[position + 1] > start
+        ]
 
-class SegmentList(list, GroupedBasePathMixin):
     def dumps(self, timespec="milliseconds", infspec="auto"):
         output = []
         last_segment = None
@@ -853,7 +1143,7 @@ class PartialSegment(BasePathMixin):
         return self.dumps(None)
 
 
-class PartialSegmentList(list, GroupedBasePathMixin):
+class PartialSegmentList(GroupedBasePathMixin, list):
     def __str__(self):
         output = [str(part) for part in self]
         return "\n".join(output)
@@ -1163,6 +1453,11 @@ class StreamInfo:
         self.stable_variant_id = kwargs.get("stable_variant_id")
         self.req_video_layout = kwargs.get("req_video_layout")
 
+    @property
+    def parsed_codecs(self):
+        """`codecs` as a tuple of `openm3u8.codecinfo.Codec` records."""
+        return parse_codecs(self.codecs)
+
     def __str__(self):
         stream_inf = []
         if self.program_id is not None:
@@ -1256,6 +1551,11 @@ class Media(BasePathMixin):
         self.stable_rendition_id = stable_rendition_id
         self.extras = extras
 
+    @property
+    def parsed_channels(self):
+        """`channels` as an `openm3u8.codecinfo.Channels`, or None."""
+        return parse_channels(self.channels)
+
     def dumps(self):
         media_out = []
 
@@ -1298,14 +1598,237 @@ class TagList(list):
         return "\n".join(output)
 
 
-class MediaList(TagList, GroupedBasePathMixin):
+class MediaList(GroupedBasePathMixin, TagList):
     @property
     def uri(self):
         return [media.uri for media in self]
 
 
-class PlaylistList(TagList, GroupedBasePathMixin):
-    pass
+# HDCP-LEVEL values in increasing order of protection
+_HDCP_LEVELS = {"NONE": 0, "TYPE-0": 1, "TYPE-1": 2}
+
+# Variants without PATHWAY-ID belong to the default pathway
+DEFAULT_PATHWAY_ID = "."
+
+
+def _codec_families(codecs):
+    """Return the sample entry types ("avc1", "mp4a", ...) listed in CODECS."""
+    if not codecs:
+        return None
+    return frozenset(codec.sample_entry for codec in parse_codecs(codecs))
+
+
+class _VariantIndex:
+    """
+    Variants of a PlaylistList sorted by bandwidth, per pathway.
+
+    `rows` maps a pathway ID, and None for every pathway, to tuples of
+    (bandwidth, position, width, height, frame rate, HDCP rank, video
+    range, codec families) in increasing bandwidth order; `bandwidths`
+    holds the matching bandwidth lists for bisecting.
+    """
+
+    def __init__(self, playlists, average):
+        rows = []
+        for position, playlist in enumerate(playlists):
+            info = playlist.stream_info
+            bandwidth = info.bandwidth
+            if average and info.average_bandwidth is not None:
+                bandwidth = info.average_bandwidth
+            width, height = info.resolution or (0, 0)
+            rows.append(
+                (
+                    bandwidth or 0,
+                    position,
+                    width,
+                    height,
+                    info.frame_rate or 0,
+                    _HDCP_LEVELS.get(info.hdcp_level or "NONE", len(_HDCP_LEVELS)),
+                    info.video_range or "SDR",
+                    _codec_families(info.codecs),
+                    info.pathway_id or DEFAULT_PATHWAY_ID,
+                )
+            )
+        # Equal bandwidths are searched in playlist order
+        rows.sort(key=lambda row: (row[0], -row[1]))
+        self.rows = {None: rows}
+        for row in rows:
+            self.rows.setdefault(row[8], []).append(row)
+        self.bandwidths = {
+            pathway_id: [row[0] for row in pathway_rows]
+            for pathway_id, pathway_rows in self.rows.items()
+        }
+
+
+class PlaylistList(GroupedBasePathMixin, TagList):
+    """
+    List of Playlist objects (the EXT-X-STREAM-INF variants).
+
+    `select` and `ladder` answer variant selection queries from an index
+    sorted by bandwidth, built on first use. List mutations rebuild the
+    index; call `invalidate_index()` after changing a variant's stream info
+    in place.
+
+    Both take the same constraints, each left out when None:
+
+    `max_resolution`
+      (width, height) the variant must fit in; variants without RESOLUTION
+      always fit
+    `max_frame_rate`
+      highest accepted FRAME-RATE
+    `codecs`
+      codec families the client decodes, as the part of each CODECS entry
+      before the first dot ("avc1", "hvc1", "mp4a", ...); every codec of
+      the variant must be one of them
+    `video_range`
+      accepted VIDEO-RANGE value or values; variants without one are "SDR"
+    `hdcp_level`
+      highest HDCP-LEVEL the client supports ("NONE", "TYPE-0", "TYPE-1")
+    `pathway_id`
+      only variants of this content steering pathway; variants without
+      PATHWAY-ID are in DEFAULT_PATHWAY_ID
+    """
+
+    _index = None
+
+    append = _invalidates_index(GroupedBasePathMixin.append)
+    extend = _invalidates_index(GroupedBasePathMixin.extend)
+    insert = _invalidates_index(GroupedBasePathMixin.insert)
+    pop = _invalidates_index(list.pop)
+    remove = _invalidates_index(list.remove)
+    clear = _invalidates_index(list.clear)
+    sort = _invalidates_index(list.sort)
+    reverse = _invalidates_index(list.reverse)
+    __setitem__ = _invalidates_index(GroupedBasePathMixin.__setitem__)
+    __delitem__ = _invalidates_index(list.__delitem__)
+    __iadd__ = _invalidates_index(GroupedBasePathMixin.__iadd__)
+    __imul__ = _invalidates_index(list.__imul__)
+
+    def invalidate_index(self):
+        self._index = None
+
+    def _get_index(self, average):
+        # One index per bandwidth attribute, built when first queried
+        if self._index is None:
+            self._index = {}
+        index = self._index.get(average)
+        if index is None:
+            index = self._index[average] = _VariantIndex(self, average)
+        return index
+
+    def _matching(self, rows, end, constraints):
+        (
+            max_width,
+            max_height,
+            max_frame_rate,
+            codecs,
+            video_ranges,
+            max_hdcp,
+        ) = constraints
+        for position in range(end - 1, -1, -1):
+            row = rows[position]
+            if max_width is not None and (row[2] > max_width or row[3] > max_height):
+                continue
+            if max_frame_rate is not None and row[4] > max_frame_rate:
+                continue
+            if max_hdcp is not None and row[5] > max_hdcp:
+                continue
+            if video_ranges is not None and row[6] not in video_ranges:
+                continue
+            if codecs is not None and row[7] is not None and not row[7] <= codecs:
+                continue
+            yield self[row[1]]
+
+    def _query(
+        self,
+        max_bandwidth,
+        max_resolution,
+        max_frame_rate,
+        codecs,
+        video_range,
+        hdcp_level,
+        pathway_id,
+        average,
+    ):
+        index = self._get_index(average)
+        rows = index.rows.get(pathway_id, ())
+        end = len(rows)
+        if max_bandwidth is not None and rows:
+            end = bisect.bisect_right(index.bandwidths[pathway_id], max_bandwidth)
+        max_width, max_height = max_resolution or (None, None)
+        if isinstance(codecs, str):
+            codecs = (codecs,)
+        if isinstance(video_range, str):
+            video_range = (video_range,)
+        constraints = (
+            max_width,
+            max_height,
+            max_frame_rate,
+            None if codecs is None else frozenset(codecs),
+            None if video_range is None else frozenset(video_range),
+            None if hdcp_level is None else _HDCP_LEVELS[hdcp_level],
+        )
+        return self._matching(rows, end, constraints)
+
+    def select(
+        self,
+        max_bandwidth=None,
+        max_resolution=None,
+        max_frame_rate=None,
+        codecs=None,
+        video_range=None,
+        hdcp_level=None,
+        pathway_id=None,
+        average=False,
+    ):
+        """
+        Return the highest-bandwidth variant with a bandwidth of at most
+        `max_bandwidth` that meets the constraints, or None.
+
+        With ``average=True`` AVERAGE-BANDWIDTH is compared instead, for
+        variants that have it. The bandwidth cap is found by bisection;
+        variants above it are never looked at, and the ones below are
+        checked from the top down until one meets the other constraints.
+        """
+        return next(
+            self._query(
+                max_bandwidth,
+                max_resolution,
+                max_frame_rate,
+                codecs,
+                video_range,
+                hdcp_level,
+                pathway_id,
+                average,
+            ),
+            None,
+        )
+
+    def ladder(
+        self,
+        max_resolution=None,
+        max_frame_rate=None,
+        codecs=None,
+        video_range=None,
+        hdcp_level=None,
+        pathway_id=None,
+        average=False,
+    ):
+        """Return the variants meeting the constraints, lowest bandwidth first."""
+        variants = list(
+            self._query(
+                None,
+                max_resolution,
+                max_frame_rate,
+                codecs,
+                video_range,
+                hdcp_level,
+                pathway_id,
+                average,
+            )
+        )
+        variants.reverse()
+        return variants
 
 
 class SessionDataList(TagList):
@@ -1346,7 +1869,7 @@ class RenditionReport(BasePathMixin):
         return self.dumps()
 
 
-class RenditionReportList(list, GroupedBasePathMixin):
+class RenditionReportList(GroupedBasePathMixin, list):
     def __str__(self):
         output = [str(report) for report in self]
         return "\n".join(output)
@@ -1413,6 +1936,70 @@ class Skip:
         return self.dumps()
 
 
+class AdBreak:
+    """
+    One ad break of a media playlist, as found by the parser in
+    `M3U8.ad_breaks`.
+
+    `source` is "cue" for EXT-X-CUE-OUT/CUE-OUT-CONT/CUE-IN breaks and
+    "daterange" for EXT-X-DATERANGE SCTE35-OUT/SCTE35-IN pairs, whose ID is
+    `id`. `segments` are the playlist segments inside the break, from
+    `start_segment` to `end_segment` inclusive. `planned_duration` is the
+    duration the cue announced, `duration` the sum of the segments seen so
+    far, and `complete` whether the closing CUE-IN or SCTE35-IN was seen.
+    A break joined mid-way (starting with an EXT-X-CUE-OUT-CONT) sets
+    `elapsed_time` to the time already spent in it. `scte35`,
+    `oatcls_scte35`, `asset_metadata` and `scte35_in` are the cue payloads
+    as written.
+    """
+
+    def __init__(
+        self,
+        source,
+        start_segment,
+        end_segment,
+        segments=(),
+        id=None,
+        planned_duration=None,
+        duration=0.0,
+        elapsed_time=None,
+        program_date_time=None,
+        scte35=None,
+        oatcls_scte35=None,
+        asset_metadata=None,
+        scte35_in=None,
+        complete=False,
+    ):
+        self.source = source
+        self.id = id
+        self.start_segment = start_segment
+        self.end_segment = end_segment
+        self.segments = list(segments)
+        self.planned_duration = planned_duration
+        self.duration = duration
+        self.elapsed_time = elapsed_time
+        self.program_date_time = program_date_time
+        self.scte35 = scte35
+        self.oatcls_scte35 = oatcls_scte35
+        self.asset_metadata = asset_metadata
+        self.scte35_in = scte35_in
+        self.complete = complete
+
+    @property
+    def scte35_section(self):
+        """`scte35` decoded as an openm3u8.scte35.SpliceInfoSection, or None."""
+        if not self.scte35:
+            return None
+        return decode_scte35(self.scte35)
+
+    def __repr__(self):
+        return (
+            f"AdBreak(source={self.source!r}, start_segment={self.start_segment},"
+            f" end_segment={self.end_segment}, duration={self.duration!r},"
+            f" complete={self.complete})"
+        )
+
+
 class PartInformation:
     def __init__(self, part_target=None):
         self.part_target = part_target
@@ -1495,6 +2082,10 @@ class DateRange:
             (attr, kwargs.get(attr)) for attr in kwargs if attr.startswith("x_")
         ]
 
+    scte35_cmd_section = _scte35_section("scte35_cmd", SpliceInfoSection.to_hex)
+    scte35_out_section = _scte35_section("scte35_out", SpliceInfoSection.to_hex)
+    scte35_in_section = _scte35_section("scte35_in", SpliceInfoSection.to_hex)
+
     def dumps(self):
         daterange = []
         daterange.append("ID=" + quoted(self.id))
@@ -3,7 +3,10 @@
 # Use of this source code is governed by a MIT License
 # license that can be found in the LICENSE file.
 
+import functools
+import hashlib
 import itertools
+import math
 import re
 from datetime import datetime, timedelta
 
@@ -22,6 +25,8 @@ http://tools.ietf.org/html/draft-pantos-http-live-streaming-08#section-3.2
 http://stackoverflow.com/questions/2785755/how-to-split-but-ignore-separators-in-quoted-strings-in-python
 """
 ATTRIBUTELISTPATTERN = re.compile(r"""((?:[^,"']|"[^"]*"|'[^']*')+)""")
+# findall(line, pos) scans from pos, so attribute lists need no slicing
+_find_attributes = ATTRIBUTELISTPATTERN.findall
 
 
 def cast_date_time(value):
@@ -41,133 +46,285 @@ class ParseError(Exception):
         return "Syntax error in manifest on line %d: %s" % (self.lineno, self.line)
 
 
-def parse(content, strict=False, custom_tags_parser=None):
+def parse(
+    content,
+    strict=False,
+    custom_tags_parser=None,
+    custom_tag_handlers=None,
+    fields=None,
+    until=None,
+):
     """
     Given a M3U8 playlist content returns a dictionary with all data found
-    """
-    data = {
-        "media_sequence": 0,
-        "is_variant": False,
-        "is_endlist": False,
-        "is_i_frames_only": False,
-        "is_independent_segments": False,
-        "is_images_only": False,
-        "playlist_type": None,
-        "playlists": [],
-        "segments": [],
-        "iframe_playlists": [],
-        "image_playlists": [],
-        "tiles": [],
-        "media": [],
-        "keys": [],
-        "rendition_reports": [],
-        "skip": {},
-        "part_inf": {},
-        "session_data": [],
-        "session_keys": [],
-        "segment_map": [],
-    }
 
-    state = {
-        "expect_segment": False,
-        "expect_playlist": False,
-        "current_key": None,
-        "current_segment_map": None,
-    }
+    `custom_tag_handlers` maps a tag name, such as "#EXT-X-AD", to a
+    callable with the same signature as `custom_tags_parser`. A handler is
+    only called for lines of exactly that tag ("#EXT-X-AD" or
+    "#EXT-X-AD:..." but not "#EXT-X-AD-MARKER"), after `custom_tags_parser`.
+
+    `fields` optionally names the outputs the caller needs (see
+    PROJECTION_FIELDS), e.g. {"segments.uri", "media_sequence"}. Tags that
+    cannot affect them are recognized but not parsed, so other fields keep
+    their defaults. A trailing segment made only of EXT-X-PART or
+    EXT-X-BITRATE tags is always produced, with only the projected keys, so
+    the segment count does not depend on `fields`.
+
+    `until` stops at the first media segment URI line: "header" returns no
+    segments and "first_segment" includes that one. Variant URIs do not stop
+    the parse. Strict validation still covers the whole content.
+    """
+    parser = PlaylistParser(
+        strict, custom_tags_parser, custom_tag_handlers, fields, until
+    )
+    parser._parse_content(content)
+    return parser._finish()
 
-    lines = string_to_lines(content)
-    if strict:
-        found_errors = version_matching.validate(lines)
 
-        if len(found_errors) > 0:
-            raise Exception(found_errors)
+class PlaylistParser:
+    """
+    Incremental counterpart of `parse`, for content that arrives in pieces.
+
+    Pass text to `feed` as it is received and call `close` at the end to
+    get the same dict `parse` returns for the whole content. Lines are
+    parsed as soon as they are complete, so `data` already holds the
+    segments seen so far. `feed` returns True once `until` has stopped the
+    parse, after which the rest of the content can be skipped. In strict
+    mode the content is validated as a whole, so it is only parsed by
+    `close`.
+    """
 
-    for lineno, line in enumerate(lines, 1):
-        line = line.strip()
-        parse_kwargs = {
-            "line": line,
-            "lineno": lineno,
-            "data": data,
-            "state": state,
-            "strict": strict,
+    def __init__(
+        self,
+        strict=False,
+        custom_tags_parser=None,
+        custom_tag_handlers=None,
+        fields=None,
+        until=None,
+    ):
+        if until not in _UNTIL_MODES:
+            raise ValueError(
+                f"until must be None, 'header' or 'first_segment', not {until!r}"
+            )
+        self.strict = strict
+        self.until = until
+        self.done = False
+        self.data = {
+            "media_sequence": 0,
+            "is_variant": False,
+            "is_endlist": False,
+            "is_i_frames_only": False,
+            "is_independent_segments": False,
+            "is_images_only": False,
+            "playlist_type": None,
+            "playlists": [],
+            "segments": [],
+            "iframe_playlists": [],
+            "image_playlists": [],
+            "tiles": [],
+            "media": [],
+            "keys": [],
+            "rendition_reports": [],
+            "skip": {},
+            "part_inf": {},
+            "session_data": [],
+            "session_keys": [],
+            "segment_map": [],
+            "ad_breaks": [],
         }
-
-        # Blank lines are ignored.
-        if not line:
-            continue
-
-        # Call custom parser if needed
-        if line.startswith("#") and callable(custom_tags_parser):
-            go_to_next_line = custom_tags_parser(line, lineno, data, state)
-
-            # Do not try to parse other standard tags on this line if custom_tags_parser
-            # function returns `True`
-            if go_to_next_line:
+        self.state = {
+            "expect_segment": False,
+            "expect_playlist": False,
+            "current_key": None,
+            "current_segment_map": None,
+        }
+        self._handlers = _custom_tag_handlers(custom_tag_handlers)
+        self._custom_tags_parser = (
+            custom_tags_parser if callable(custom_tags_parser) else None
+        )
+        self._dispatch = DISPATCH if fields is None else _projected_dispatch(fields)
+        self._lineno = 0
+        self._pending = ""
+        self._chunks = [] if strict else None
+
+    def feed(self, text):
+        """Parse the complete lines of `text`; return True once done."""
+        if self.done:
+            return True
+        if self._chunks is not None:
+            self._chunks.append(text)
+            return False
+        text = self._pending + text
+        lines = text.splitlines(True)
+        self._pending = ""
+        if lines:
+            # Hold back a line whose end has not arrived yet, and a "\r"
+            # that may be the first half of "\r\n"
+            last = lines[-1]
+            if last[-1] == "\r" or last.splitlines()[0] == last:
+                self._pending = lines.pop()
+        if not self._lineno:
+            # Leading blank lines are not numbered, as in parse()
+            lines = list(itertools.dropwhile(str.isspace, lines))
+        self._parse(lines)
+        return self.done
+
+    def close(self):
+        """Parse whatever is left and return the parse result."""
+        if self._chunks is not None:
+            self._parse_content("".join(self._chunks))
+            self._chunks = None
+        elif self._pending and not self.done:
+            self._parse([self._pending])
+        self._pending = ""
+        return self._finish()
+
+    def _parse_content(self, content):
+        lines = string_to_lines(content)
+        if self.strict:
+            found_errors = version_matching.validate(lines)
+
+            if len(found_errors) > 0:
+                raise Exception(found_errors)
+        self._parse(lines)
+
+    def _finish(self):
+        # Handle remaining partial segments.
+        if "segment" in self.state:
+            self.data["segments"].append(self.state.pop("segment"))
+        return self.data
+
+    def _parse(self, lines):
+        data = self.data
+        state = self.state
+        strict = self.strict
+        custom_tags_parser = self._custom_tags_parser
+        handlers = self._handlers
+        stop_before_segment = self.until == "header"
+        stop_after_segment = self.until == "first_segment"
+        # Handlers are called positionally as handler(line, lineno, data,
+        # state, strict); binding the table locally keeps the loop free of
+        # global lookups.
+        dispatch = self._dispatch
+        ext_m3u = protocol.ext_m3u
+
+        lineno = self._lineno
+        for lineno, line in enumerate(lines, lineno + 1):
+            line = line.strip()
+
+            # Blank lines are ignored.
+            if not line:
                 continue
 
-        # Fast-path: dispatch based on tag token up to first ':' (or full tag if none)
-        if line.startswith("#"):
-            tag = line.split(":", 1)[0]
-            handler = DISPATCH.get(tag)
-            if handler is not None:
-                handler(**parse_kwargs)
+            if line[0] == "#":
+                # Call custom parser if needed. Do not try to parse other
+                # standard tags on this line if it returns `True`.
+                if custom_tags_parser is not None and custom_tags_parser(
+                    line, lineno, data, state
+                ):
+                    continue
+
+                # Dispatch based on tag token up to first ':' (or full tag if none)
+                tag = line.partition(":")[0]
+                if handlers:
+                    handler = handlers.get(tag)
+                    if handler is not None and handler(line, lineno, data, state):
+                        continue
+
+                handler = dispatch.get(tag)
+                if handler is not None:
+                    handler(line, lineno, data, state, strict)
+                # #EXTM3U should be present; ignore if seen.
+                # In strict mode, unrecognized tags are illegal.
+                elif strict and tag != ext_m3u:
+                    raise ParseError(lineno, line)
                 continue
-            # #EXTM3U should be present; ignore if seen
-            if tag == protocol.ext_m3u:
-                continue
-            # In strict mode, unrecognized tags are illegal
-            if strict:
+
+            # Lines that don't start with # are either segments or playlists.
+            if state["expect_segment"]:
+                if stop_before_segment:
+                    state.pop("segment", None)
+                    self.done = True
+                    break
+                _parse_ts_chunk(line, lineno, data, state, strict)
+                if stop_after_segment:
+                    self.done = True
+                    break
+            elif state["expect_playlist"]:
+                _parse_variant_playlist(line, lineno, data, state, strict)
+            # In strict mode, any other content is illegal
+            elif strict:
                 raise ParseError(lineno, line)
-            continue
+        self._lineno = lineno
+
+
+_UNTIL_MODES = (None, "header", "first_segment")
 
-        # Lines that don't start with # are either segments or playlists.
-        if state["expect_segment"]:
-            _parse_ts_chunk(**parse_kwargs)
-        elif state["expect_playlist"]:
-            _parse_variant_playlist(**parse_kwargs)
-        # In strict mode, any other content is illegal
-        elif strict:
-            raise ParseError(lineno, line)
 
-    # Handle remaining partial segments.
-    if "segment" in state:
-        data["segments"].append(state.pop("segment"))
+def fingerprint(content, ignore=None):
+    """
+    Return a 64-bit hash of the playlist's stripped, non-blank lines.
+
+    Lines starting with one of the `ignore` prefixes are left out. This is
+    the pure-Python counterpart of the C extension's fingerprint() and uses
+    a different hash, so values from the two are not comparable.
+    """
+    if isinstance(ignore, str):
+        raise TypeError("ignore must be an iterable of line prefixes, not str")
+    prefixes = tuple(ignore or ())
+    lines = []
+    for line in content.splitlines():
+        line = line.strip()
+        if line and not (prefixes and line.startswith(prefixes)):
+            lines.append(line)
+    digest = hashlib.blake2b("\n".join(lines).encode(), digest_size=8).digest()
+    return int.from_bytes(digest, "little")
+
 
-    return data
+def _custom_tag_handlers(custom_tag_handlers):
+    if custom_tag_handlers is None:
+        return {}
+    handlers = dict(custom_tag_handlers)
+    for tag, handler in handlers.items():
+        if not isinstance(tag, str):
+            raise TypeError("custom_tag_handlers keys must be str")
+        if not callable(handler):
+            raise TypeError(f"custom_tag_handlers[{tag!r}] is not callable")
+    return handlers
 
 
-def _parse_key(line, data, state, **kwargs):
-    params = ATTRIBUTELISTPATTERN.split(line.replace(protocol.ext_x_key + ":", ""))[
-        1::2
-    ]
+def _tag_value(line, tag):
+    # Text after "TAG:"; callers are only dispatched lines starting with tag
+    return line[len(tag) + 1 :]
+
+
+def _parse_key_attributes(line, tag):
     key = {}
-    for param in params:
+    for param in _find_attributes(line, len(tag) + 1):
         name, value = param.split("=", 1)
-        key[normalize_attribute(name)] = remove_quotes(value)
+        key[_normalized_attribute(name)] = remove_quotes(value)
+    return key
 
+
+def _parse_key(line, lineno, data, state, strict):
+    key = _parse_key_attributes(line, protocol.ext_x_key)
     state["current_key"] = key
     if key not in data["keys"]:
         data["keys"].append(key)
 
 
-def _parse_extinf(line, state, lineno, strict, **kwargs):
-    chunks = line.replace(protocol.extinf + ":", "").split(",", 1)
-    if len(chunks) == 2:
-        duration, title = chunks
-    elif len(chunks) == 1:
-        if strict:
-            raise ParseError(lineno, line)
-        else:
-            duration = chunks[0]
-            title = ""
-    if "segment" not in state:
-        state["segment"] = {}
-    state["segment"]["duration"] = float(duration)
-    state["segment"]["title"] = title
+def _parse_extinf(line, lineno, data, state, strict):
+    duration, sep, title = _tag_value(line, protocol.extinf).partition(",")
+    if not sep and strict:
+        raise ParseError(lineno, line)
+    segment = state.get("segment")
+    if segment is None:
+        segment = state["segment"] = {}
+    segment["duration"] = float(duration)
+    segment["title"] = title
     state["expect_segment"] = True
 
 
-def _parse_ts_chunk(line, data, state, **kwargs):
+def _parse_ts_chunk(line, lineno, data, state, strict):
     segment = state.pop("segment")
     if state.get("program_date_time"):
         segment["program_date_time"] = state.pop("program_date_time")
@@ -203,47 +360,171 @@ def _parse_ts_chunk(line, data, state, **kwargs):
     segment["blackout"] = state.pop("blackout", None)
     data["segments"].append(segment)
     state["expect_segment"] = False
+    if (
+        segment["cue_out"]
+        or segment["cue_in"]
+        or segment["dateranges"]
+        or "open_ad_breaks" in state
+    ):
+        _track_ad_breaks(segment, data, state)
+
+
+def _to_float(value):
+    try:
+        return float(value)
+    except (TypeError, ValueError):
+        return None
+
+
+def _ad_break(source, index, segment, scte35, planned_duration):
+    return {
+        "source": source,
+        "id": None,
+        "start_segment": index,
+        "end_segment": index,
+        "planned_duration": planned_duration,
+        "duration": 0.0,
+        "elapsed_time": None,
+        "program_date_time": segment.get("current_program_date_time"),
+        "scte35": scte35,
+        "oatcls_scte35": None,
+        "asset_metadata": None,
+        "scte35_in": None,
+        "complete": False,
+    }
 
 
-def _parse_attribute_list(prefix, line, attribute_parser, default_parser=None):
-    params = ATTRIBUTELISTPATTERN.split(line.replace(prefix + ":", ""))[1::2]
+def _track_ad_breaks(segment, data, state):
+    """
+    Extend data["ad_breaks"] with the segment just appended.
+
+    A break opens at the segment following EXT-X-CUE-OUT, or at one marked
+    by EXT-X-CUE-OUT-CONT outside any break (a live window that starts mid
+    break), and ends before the segment following EXT-X-CUE-IN.
+    DATERANGE breaks open at the first SCTE35-OUT of an ID (later tags may
+    repeat it) and end at the SCTE35-IN with the same ID; a tag carrying
+    both is a complete break over its segment. Breaks still open when the
+    playlist ends are not complete.
+    """
+    index = len(data["segments"]) - 1
+    open_breaks = state.get("open_ad_breaks", [])
+    cue = next(
+        (i for i, ad_break in enumerate(open_breaks) if ad_break["source"] == "cue"),
+        None,
+    )
 
-    attributes = {}
-    if not line.startswith(prefix + ":"):
-        return attributes
+    if segment["cue_in"] and cue is not None:
+        open_breaks.pop(cue)["complete"] = True
+        cue = None
+    if segment["cue_out_start"] or (segment["cue_out"] and cue is None):
+        if cue is not None:
+            # A new CUE-OUT without CUE-IN leaves the previous break open-ended
+            del open_breaks[cue]
+        ad_break = _ad_break(
+            "cue",
+            index,
+            segment,
+            segment["scte35"],
+            _to_float(segment["scte35_duration"]),
+        )
+        ad_break["oatcls_scte35"] = segment["oatcls_scte35"]
+        ad_break["asset_metadata"] = segment["asset_metadata"]
+        if not segment["cue_out_start"]:
+            ad_break["elapsed_time"] = _to_float(segment["scte35_elapsedtime"])
+        data["ad_breaks"].append(ad_break)
+        open_breaks.append(ad_break)
+
+    for daterange in segment["dateranges"] or ():
+        daterange_id = daterange.get("id")
+        if daterange.get("scte35_in") is not None:
+            for i, ad_break in enumerate(open_breaks):
+                if ad_break["source"] == "daterange" and ad_break["id"] == daterange_id:
+                    ad_break["complete"] = True
+                    ad_break["scte35_in"] = daterange["scte35_in"]
+                    del open_breaks[i]
+                    break
+        if daterange.get("scte35_out") is not None and not any(
+            ad_break["source"] == "daterange" and ad_break["id"] == daterange_id
+            for ad_break in data["ad_breaks"]
+        ):
+            planned = daterange.get("planned_duration")
+            ad_break = _ad_break(
+                "daterange",
+                index,
+                segment,
+                daterange["scte35_out"],
+                daterange.get("duration") if planned is None else planned,
+            )
+            ad_break["id"] = daterange_id
+            data["ad_breaks"].append(ad_break)
+            if daterange.get("scte35_in") is None:
+                open_breaks.append(ad_break)
+            else:
+                # OUT and IN on one tag: a break over this segment alone
+                ad_break["duration"] = segment.get("duration", 0.0)
+                ad_break["scte35_in"] = daterange["scte35_in"]
+                ad_break["complete"] = True
+
+    duration = segment.get("duration", 0.0)
+    for ad_break in open_breaks:
+        ad_break["end_segment"] = index
+        ad_break["duration"] += duration
+    if open_breaks:
+        state["open_ad_breaks"] = open_breaks
+    else:
+        state.pop("open_ad_breaks", None)
 
-    for param in params:
-        param_parts = param.split("=", 1)
-        if len(param_parts) == 1:
-            name = ""
-            value = param_parts[0]
-        else:
-            name, value = param_parts
 
-        name = normalize_attribute(name)
-        if name in attribute_parser:
-            value = attribute_parser[name](value)
-        elif default_parser is not None:
-            value = default_parser(value)
+def _attribute_list_parser(prefix, attribute_parser, default_parser=None):
+    """
+    Build a function that parses "prefix:attribute-list" lines into dicts.
 
-        attributes[name] = value
+    The prefix length, the value parsers and the key normalization cache are
+    bound once, so each call is a single regex scan from the end of the
+    prefix plus one dict lookup per attribute.
+    """
+    head = prefix + ":"
+    start = len(head)
+    find_attributes = _find_attributes
+    normalized_attribute = _normalized_attribute
+
+    def parse_attribute_list(line):
+        attributes = {}
+        if not line.startswith(head):
+            return attributes
+
+        for param in find_attributes(line, start):
+            name, sep, value = param.partition("=")
+            if not sep:
+                name, value = "", param
+
+            name = normalized_attribute(name)
+            value_parser = attribute_parser.get(name)
+            if value_parser is not None:
+                value = value_parser(value)
+            elif default_parser is not None:
+                value = default_parser(value)
+
+            attributes[name] = value
 
-    return attributes
+        return attributes
+
+    return parse_attribute_list
+
+
+def _parse_attribute_list(prefix, line, attribute_parser, default_parser=None):
+    return _attribute_list_parser(prefix, attribute_parser, default_parser)(line)
 
 
-def _parse_stream_inf(line, data, state, **kwargs):
+def _parse_stream_inf(line, lineno, data, state, strict):
     state["expect_playlist"] = True
     data["is_variant"] = True
     data["media_sequence"] = None
-    state["stream_info"] = _parse_attribute_list(
-        protocol.ext_x_stream_inf, line, STREAM_INF_ATTRIBUTE_PARSER
-    )
+    state["stream_info"] = _stream_inf_attributes(line)
 
 
-def _parse_i_frame_stream_inf(line, data, **kwargs):
-    iframe_stream_info = _parse_attribute_list(
-        protocol.ext_x_i_frame_stream_inf, line, IFRAME_STREAM_INF_ATTRIBUTE_PARSER
-    )
+def _parse_i_frame_stream_inf(line, lineno, data, state, strict):
+    iframe_stream_info = _i_frame_stream_inf_attributes(line)
     iframe_playlist = {
         "uri": iframe_stream_info.pop("uri"),
         "iframe_stream_info": iframe_stream_info,
@@ -252,10 +533,8 @@ def _parse_i_frame_stream_inf(line, data, **kwargs):
     data["iframe_playlists"].append(iframe_playlist)
 
 
-def _parse_image_stream_inf(line, data, **kwargs):
-    image_stream_info = _parse_attribute_list(
-        protocol.ext_x_image_stream_inf, line, IMAGE_STREAM_INF_ATTRIBUTE_PARSER
-    )
+def _parse_image_stream_inf(line, lineno, data, state, strict):
+    image_stream_info = _image_stream_inf_attributes(line)
     image_playlist = {
         "uri": image_stream_info.pop("uri"),
         "image_stream_info": image_stream_info,
@@ -264,107 +543,88 @@ def _parse_image_stream_inf(line, data, **kwargs):
     data["image_playlists"].append(image_playlist)
 
 
-def _parse_is_images_only(line, data, **kwargs):
+def _parse_is_images_only(line, lineno, data, state, strict):
     data["is_images_only"] = True
 
 
-def _parse_tiles(line, data, state, **kwargs):
-    tiles_info = _parse_attribute_list(
-        protocol.ext_x_tiles, line, TILES_ATTRIBUTE_PARSER
-    )
-    data["tiles"].append(tiles_info)
+def _parse_tiles(line, lineno, data, state, strict):
+    data["tiles"].append(_tiles_attributes(line))
 
 
-def _parse_media(line, data, **kwargs):
-    media = _parse_attribute_list(protocol.ext_x_media, line, MEDIA_ATTRIBUTE_PARSER)
-    data["media"].append(media)
+def _parse_media(line, lineno, data, state, strict):
+    data["media"].append(_media_attributes(line))
 
 
-def _parse_variant_playlist(line, data, state, **kwargs):
+def _parse_variant_playlist(line, lineno, data, state, strict):
     playlist = {"uri": line, "stream_info": state.pop("stream_info")}
     data["playlists"].append(playlist)
     state["expect_playlist"] = False
 
 
-def _parse_bitrate(state, **kwargs):
+def _parse_bitrate(line, lineno, data, state, strict):
     if "segment" not in state:
         state["segment"] = {}
-    state["segment"]["bitrate"] = _parse_simple_parameter(cast_to=int, **kwargs)
+    state["segment"]["bitrate"] = _parse_simple_parameter(line, data, cast_to=int)
 
 
-def _parse_byterange(line, state, **kwargs):
+def _parse_byterange(line, lineno, data, state, strict):
     if "segment" not in state:
         state["segment"] = {}
-    state["segment"]["byterange"] = line.replace(protocol.ext_x_byterange + ":", "")
+    state["segment"]["byterange"] = _tag_value(line, protocol.ext_x_byterange)
     state["expect_segment"] = True
 
 
-def _parse_targetduration(**parse_kwargs):
-    return _parse_simple_parameter(cast_to=int, **parse_kwargs)
-
+def _simple_parameter_parser(tag, cast_to=str):
+    """
+    Build a handler storing "TAG:value" as data[key] = cast_to(value).
 
-def _parse_media_sequence(**parse_kwargs):
-    return _parse_simple_parameter(cast_to=int, **parse_kwargs)
+    The key is the normalized tag without its "#EXT-X-" prefix, computed once
+    per tag instead of once per line.
+    """
+    key = normalize_attribute(tag.replace("#EXT-X-", ""))
 
+    def parse_simple_parameter(line, lineno, data, state, strict):
+        _, value = line.split(":", 1)
+        data[key] = cast_to(value.strip().lower())
 
-def _parse_discontinuity_sequence(**parse_kwargs):
-    return _parse_simple_parameter(cast_to=int, **parse_kwargs)
+    return parse_simple_parameter
 
 
-def _parse_program_date_time(line, state, data, **parse_kwargs):
-    _, program_date_time = _parse_simple_parameter_raw_value(
-        line, cast_to=cast_date_time, **parse_kwargs
-    )
+def _parse_program_date_time(line, lineno, data, state, strict):
+    program_date_time = cast_date_time(line.split(":", 1)[1])
     if not data.get("program_date_time"):
         data["program_date_time"] = program_date_time
     state["current_program_date_time"] = program_date_time
     state["program_date_time"] = program_date_time
 
 
-def _parse_discontinuity(state, **parse_kwargs):
+def _parse_discontinuity(line, lineno, data, state, strict):
     state["discontinuity"] = True
 
 
-def _parse_cue_in(state, **parse_kwargs):
+def _parse_cue_in(line, lineno, data, state, strict):
     state["cue_in"] = True
 
 
-def _parse_cue_span(state, **parse_kwargs):
+def _parse_cue_span(line, lineno, data, state, strict):
     state["cue_out"] = True
 
 
-def _parse_version(**parse_kwargs):
-    return _parse_simple_parameter(cast_to=int, **parse_kwargs)
-
-
-def _parse_allow_cache(**parse_kwargs):
-    return _parse_simple_parameter(cast_to=str, **parse_kwargs)
-
-
-def _parse_playlist_type(line, data, **kwargs):
-    return _parse_simple_parameter(line, data)
-
-
-def _parse_x_map(line, data, state, **kwargs):
-    segment_map_info = _parse_attribute_list(
-        protocol.ext_x_map, line, X_MAP_ATTRIBUTE_PARSER
-    )
+def _parse_x_map(line, lineno, data, state, strict):
+    segment_map_info = _x_map_attributes(line)
     state["current_segment_map"] = segment_map_info
     data["segment_map"].append(segment_map_info)
 
 
-def _parse_start(line, data, **kwargs):
-    start_info = _parse_attribute_list(
-        protocol.ext_x_start, line, START_ATTRIBUTE_PARSER
-    )
-    data["start"] = start_info
+def _parse_start(line, lineno, data, state, strict):
+    data["start"] = _start_attributes(line)
 
 
-def _parse_gap(state, **kwargs):
+def _parse_gap(line, lineno, data, state, strict):
     state["gap"] = True
 
 
-def _parse_blackout(line, state, **kwargs):
+def _parse_blackout(line, lineno, data, state, strict):
     # Store the full tag content to pass through unmodified
     # Extract everything after "#EXT-X-BLACKOUT"
     if ":" in line:
@@ -396,31 +656,26 @@ def _parse_simple_parameter(line, data, cast_to=str, **kwargs):
     return _parse_and_set_simple_parameter_raw_value(line, data, cast_to, True)
 
 
-def _parse_i_frames_only(data, **kwargs):
+def _parse_i_frames_only(line, lineno, data, state, strict):
     data["is_i_frames_only"] = True
 
 
-def _parse_is_independent_segments(data, **kwargs):
+def _parse_is_independent_segments(line, lineno, data, state, strict):
     data["is_independent_segments"] = True
 
 
-def _parse_endlist(data, **kwargs):
+def _parse_endlist(line, lineno, data, state, strict):
     data["is_endlist"] = True
 
 
-def _parse_cueout_cont(line, state, **kwargs):
+def _parse_cueout_cont(line, lineno, data, state, strict):
     state["cue_out"] = True
 
-    elements = line.split(":", 1)
-    if len(elements) != 2:
+    if ":" not in line:
         return
 
     # EXT-X-CUE-OUT-CONT:ElapsedTime=10,Duration=60,SCTE35=... style
-    cue_info = _parse_attribute_list(
-        protocol.ext_x_cue_out_cont,
-        line,
-        CUEOUT_CONT_ATTRIBUTE_PARSER,
-    )
+    cue_info = _cueout_cont_attributes(line)
 
     # EXT-X-CUE-OUT-CONT:2.436/120 style
     progress = cue_info.get("")
@@ -445,21 +700,16 @@ def _parse_cueout_cont(line, state, **kwargs):
         state["current_cue_out_elapsedtime"] = elapsedtime
 
 
-def _parse_cueout(line, state, **kwargs):
+def _parse_cueout(line, lineno, data, state, strict):
     state["cue_out_start"] = True
     state["cue_out"] = True
     if "DURATION" in line.upper():
         state["cue_out_explicitly_duration"] = True
 
-    elements = line.split(":", 1)
-    if len(elements) != 2:
+    if ":" not in line:
         return
 
-    cue_info = _parse_attribute_list(
-        protocol.ext_x_cue_out,
-        line,
-        CUEOUT_ATTRIBUTE_PARSER,
-    )
+    cue_info = _cueout_attributes(line)
     cue_out_scte35 = cue_info.get("cue")
     cue_out_duration = cue_info.get("duration") or cue_info.get("")
 
@@ -468,28 +718,20 @@ def _parse_cueout(line, state, **kwargs):
     state["current_cue_out_duration"] = cue_out_duration
 
 
-def _parse_server_control(line, data, **kwargs):
-    data["server_control"] = _parse_attribute_list(
-        protocol.ext_x_server_control, line, SERVER_CONTROL_ATTRIBUTE_PARSER
-    )
-
+def _parse_server_control(line, lineno, data, state, strict):
+    data["server_control"] = _server_control_attributes(line)
 
-def _parse_part_inf(line, data, **kwargs):
-    data["part_inf"] = _parse_attribute_list(
-        protocol.ext_x_part_inf, line, PART_INF_ATTRIBUTE_PARSER
-    )
 
+def _parse_part_inf(line, lineno, data, state, strict):
+    data["part_inf"] = _part_inf_attributes(line)
 
-def _parse_rendition_report(line, data, **kwargs):
-    rendition_report = _parse_attribute_list(
-        protocol.ext_x_rendition_report, line, RENDITION_REPORT_ATTRIBUTE_PARSER
-    )
 
-    data["rendition_reports"].append(rendition_report)
+def _parse_rendition_report(line, lineno, data, state, strict):
+    data["rendition_reports"].append(_rendition_report_attributes(line))
 
 
-def _parse_part(line, state, **kwargs):
-    part = _parse_attribute_list(protocol.ext_x_part, line, PART_ATTRIBUTE_PARSER)
+def _parse_part(line, lineno, data, state, strict):
+    part = _part_attributes(line)
 
     # this should always be true according to spec
     if state.get("current_program_date_time"):
@@ -508,40 +750,24 @@ def _parse_part(line, state, **kwargs):
     segment["parts"].append(part)
 
 
-def _parse_skip(line, data, **parse_kwargs):
-    data["skip"] = _parse_attribute_list(
-        protocol.ext_x_skip, line, SKIP_ATTRIBUTE_PARSER
-    )
+def _parse_skip(line, lineno, data, state, strict):
+    data["skip"] = _skip_attributes(line)
 
 
-def _parse_session_data(line, data, **kwargs):
-    session_data = _parse_attribute_list(
-        protocol.ext_x_session_data, line, SESSION_DATA_ATTRIBUTE_PARSER
-    )
-    data["session_data"].append(session_data)
+def _parse_session_data(line, lineno, data, state, strict):
+    data["session_data"].append(_session_data_attributes(line))
 
 
-def _parse_session_key(line, data, **kwargs):
-    params = ATTRIBUTELISTPATTERN.split(
-        line.replace(protocol.ext_x_session_key + ":", "")
-    )[1::2]
-    key = {}
-    for param in params:
-        name, value = param.split("=", 1)
-        key[normalize_attribute(name)] = remove_quotes(value)
-    data["session_keys"].append(key)
+def _parse_session_key(line, lineno, data, state, strict):
+    data["session_keys"].append(_parse_key_attributes(line, protocol.ext_x_session_key))
 
 
-def _parse_preload_hint(line, data, **kwargs):
-    data["preload_hint"] = _parse_attribute_list(
-        protocol.ext_x_preload_hint, line, PRELOAD_HINT_ATTRIBUTE_PARSER
-    )
+def _parse_preload_hint(line, lineno, data, state, strict):
+    data["preload_hint"] = _preload_hint_attributes(line)
 
 
-def _parse_daterange(line, state, **kwargs):
-    parsed = _parse_attribute_list(
-        protocol.ext_x_daterange, line, DATERANGE_ATTRIBUTE_PARSER
-    )
+def _parse_daterange(line, lineno, data, state, strict):
+    parsed = _daterange_attributes(line)
 
     if "dateranges" not in state:
         state["dateranges"] = []
@@ -549,25 +775,21 @@ def _parse_daterange(line, state, **kwargs):
     state["dateranges"].append(parsed)
 
 
-def _parse_content_steering(line, data, **kwargs):
-    data["content_steering"] = _parse_attribute_list(
-        protocol.ext_x_content_steering, line, CONTENT_STEERING_ATTRIBUTE_PARSER
-    )
+def _parse_content_steering(line, lineno, data, state, strict):
+    data["content_steering"] = _content_steering_attributes(line)
 
 
-def _parse_oatcls_scte35(line, state, **kwargs):
+def _parse_oatcls_scte35(line, lineno, data, state, strict):
     scte35_cue = line.split(":", 1)[1]
     state["current_cue_out_oatcls_scte35"] = scte35_cue
     if not state.get("current_cue_out_scte35"):
         state["current_cue_out_scte35"] = scte35_cue
 
 
-def _parse_asset(line, state, **kwargs):
+def _parse_asset(line, lineno, data, state, strict):
     # EXT-X-ASSET attribute values may or may not be quoted, and need to be URL-encoded.
     # They are preserved as-is here to prevent loss of information.
-    state["asset_metadata"] = _parse_attribute_list(
-        protocol.ext_x_asset, line, {}, default_parser=str
-    )
+    state["asset_metadata"] = _asset_attributes(line)
 
 
 def string_to_lines(string):
@@ -598,6 +820,22 @@ def normalize_attribute(attribute):
     return attribute.replace("-", "_").lower().strip()
 
 
+# Attribute names repeat across lines ("BANDWIDTH", "URI", ...), so the
+# attribute list parsers memoize normalization. The cache is bounded in case
+# a playlist carries unbounded distinct names.
+_NORMALIZED_ATTRIBUTES = {}
+_NORMALIZED_ATTRIBUTES_MAX = 4096
+
+
+def _normalized_attribute(attribute):
+    normalized = _NORMALIZED_ATTRIBUTES.get(attribute)
+    if normalized is None:
+        if len(_NORMALIZED_ATTRIBUTES) >= _NORMALIZED_ATTRIBUTES_MAX:
+            _NORMALIZED_ATTRIBUTES.clear()
+        normalized = _NORMALIZED_ATTRIBUTES[attribute] = normalize_attribute(attribute)
+    return normalized
+
+
 def get_segment_custom_value(state, key, default=None):
     """
     Helper function for getting custom values for Segment
@@ -624,6 +862,124 @@ def save_segment_custom_value(state, key, value):
     state["segment"]["custom_parser_values"][key] = value
 
 
+# Attribute value types for CustomTagSchema. The values match the AttrType
+# enum in the C extension, which exports the same names.
+ATTR_STRING = 0
+ATTR_INT = 1
+ATTR_FLOAT = 2
+ATTR_QUOTED_STRING = 3
+ATTR_BANDWIDTH = 4
+
+
+def _lenient(cast):
+    # Like the C parser: strip quotes, convert, keep the string if that fails
+    def parse_value(value):
+        value = remove_quotes(value)
+        try:
+            return cast(value)
+        except ValueError:
+            return value
+
+    return parse_value
+
+
+def _finite_float(value):
+    number = float(value)
+    if not math.isfinite(number):
+        raise ValueError(f"not a finite number: {value!r}")
+    return number
+
+
+_ATTR_TYPE_PARSERS = {
+    ATTR_STRING: None,
+    ATTR_INT: _lenient(int),
+    ATTR_FLOAT: _lenient(_finite_float),
+    ATTR_QUOTED_STRING: remove_quotes,
+    ATTR_BANDWIDTH: _lenient(lambda x: int(_finite_float(x))),
+}
+
+
+class CustomTagSchema:
+    """
+    Declarative parser for a custom attribute-list tag.
+
+    Register it as a value in `custom_tag_handlers`, keyed by the exact tag
+    it parses (here #EXT-X-AD, not #EXT-X-AD-MARKER):
+
+        handlers = {
+            "#EXT-X-AD": CustomTagSchema({"ID": ATTR_QUOTED_STRING,
+                                          "DURATION": ATTR_FLOAT}),
+        }
+
+    `attributes` maps attribute names to ATTR_* types; names are normalized
+    like every other attribute ("AD-ID" -> "ad_id") and attributes that are
+    not listed are kept as raw strings. The parsed dict is stored under
+    `name` (default: the normalized tag, e.g. "ext_x_ad") in the pending
+    segment's `custom_parser_values` when `destination` is "segment", or in
+    the top-level parsed data when it is "playlist". With `multiple=True`
+    every occurrence is appended to a list instead of replacing the last.
+
+    The C parser applies schemas without calling back into Python; calling
+    the schema runs the equivalent pure Python implementation.
+    """
+
+    DESTINATIONS = ("segment", "playlist")
+
+    def __init__(self, attributes, destination="segment", name=None, multiple=False):
+        if destination not in self.DESTINATIONS:
+            raise ValueError(f"destination must be one of {self.DESTINATIONS}")
+        for attribute, attr_type in attributes.items():
+            if attr_type not in _ATTR_TYPE_PARSERS:
+                raise ValueError(
+                    f"unknown attribute type {attr_type!r} for {attribute!r}"
+                )
+        self.attribute_types = tuple(
+            (normalize_attribute(attribute), attr_type)
+            for attribute, attr_type in attributes.items()
+        )
+        self.destination = destination
+        self.name = name
+        self.multiple = multiple
+        self._parsers = {
+            attribute: _ATTR_TYPE_PARSERS[attr_type]
+            for attribute, attr_type in self.attribute_types
+            if attr_type != ATTR_STRING
+        }
+        self._attribute_lists = {}
+
+    def __repr__(self):
+        return (
+            f"CustomTagSchema({dict(self.attribute_types)!r}, "
+            f"destination={self.destination!r}, name={self.name!r}, "
+            f"multiple={self.multiple!r})"
+        )
+
+    def __call__(self, line, lineno, data, state):
+        tag = line.partition(":")[0]
+        parse_attribute_list = self._attribute_lists.get(tag)
+        if parse_attribute_list is None:
+            parse_attribute_list = self._attribute_lists[tag] = _attribute_list_parser(
+                tag, self._parsers
+            )
+        attributes = parse_attribute_list(line)
+        name = self.name if self.name is not None else normalize_attribute(tag[1:])
+
+        if self.destination == "segment":
+            segment = state.setdefault("segment", {})
+            target = segment.setdefault("custom_parser_values", {})
+        else:
+            target = data
+
+        if self.multiple:
+            values = target.get(name)
+            if not isinstance(values, list):
+                values = target[name] = []
+            values.append(attributes)
+        else:
+            target[name] = attributes
+        return True
+
+
 # Attribute parser constants (built once)
 STREAM_INF_ATTRIBUTE_PARSER = remove_quotes_parser(
     "codecs",
@@ -739,8 +1095,64 @@ CUEOUT_ATTRIBUTE_PARSER = remove_quotes_parser("cue")
 TILES_ATTRIBUTE_PARSER = remove_quotes_parser("uri")
 TILES_ATTRIBUTE_PARSER.update({"resolution": str, "layout": str, "duration": float})
 
+# Per-tag attribute list parsers (built once)
+_stream_inf_attributes = _attribute_list_parser(
+    protocol.ext_x_stream_inf, STREAM_INF_ATTRIBUTE_PARSER
+)
+_i_frame_stream_inf_attributes = _attribute_list_parser(
+    protocol.ext_x_i_frame_stream_inf, IFRAME_STREAM_INF_ATTRIBUTE_PARSER
+)
+_image_stream_inf_attributes = _attribute_list_parser(
+    protocol.ext_x_image_stream_inf, IMAGE_STREAM_INF_ATTRIBUTE_PARSER
+)
+_media_attributes = _attribute_list_parser(protocol.ext_x_media, MEDIA_ATTRIBUTE_PARSER)
+_x_map_attributes = _attribute_list_parser(protocol.ext_x_map, X_MAP_ATTRIBUTE_PARSER)
+_start_attributes = _attribute_list_parser(protocol.ext_x_start, START_ATTRIBUTE_PARSER)
+_server_control_attributes = _attribute_list_parser(
+    protocol.ext_x_server_control, SERVER_CONTROL_ATTRIBUTE_PARSER
+)
+_part_inf_attributes = _attribute_list_parser(
+    protocol.ext_x_part_inf, PART_INF_ATTRIBUTE_PARSER
+)
+_rendition_report_attributes = _attribute_list_parser(
+    protocol.ext_x_rendition_report, RENDITION_REPORT_ATTRIBUTE_PARSER
+)
+_part_attributes = _attribute_list_parser(protocol.ext_x_part, PART_ATTRIBUTE_PARSER)
+_skip_attributes = _attribute_list_parser(protocol.ext_x_skip, SKIP_ATTRIBUTE_PARSER)
+_session_data_attributes = _attribute_list_parser(
+    protocol.ext_x_session_data, SESSION_DATA_ATTRIBUTE_PARSER
+)
+_preload_hint_attributes = _attribute_list_parser(
+    protocol.ext_x_preload_hint, PRELOAD_HINT_ATTRIBUTE_PARSER
+)
+_daterange_attributes = _attribute_list_parser(
+    protocol.ext_x_daterange, DATERANGE_ATTRIBUTE_PARSER
+)
+_content_steering_attributes = _attribute_list_parser(
+    protocol.ext_x_content_steering, CONTENT_STEERING_ATTRIBUTE_PARSER
+)
+_cueout_cont_attributes = _attribute_list_parser(
+    protocol.ext_x_cue_out_cont, CUEOUT_CONT_ATTRIBUTE_PARSER
+)
+_cueout_attributes = _attribute_list_parser(
+    protocol.ext_x_cue_out, CUEOUT_ATTRIBUTE_PARSER
+)
+_tiles_attributes = _attribute_list_parser(protocol.ext_x_tiles, TILES_ATTRIBUTE_PARSER)
+_asset_attributes = _attribute_list_parser(protocol.ext_x_asset, {}, default_parser=str)
+
+# Simple "TAG:value" handlers (built once)
+_parse_targetduration = _simple_parameter_parser(protocol.ext_x_targetduration, int)
+_parse_media_sequence = _simple_parameter_parser(protocol.ext_x_media_sequence, int)
+_parse_discontinuity_sequence = _simple_parameter_parser(
+    protocol.ext_x_discontinuity_sequence, int
+)
+_parse_version = _simple_parameter_parser(protocol.ext_x_version, int)
+_parse_allow_cache = _simple_parameter_parser(protocol.ext_x_allow_cache)
+_parse_playlist_type = _simple_parameter_parser(protocol.ext_x_playlist_type)
+
 
-# Single token-to-handler dispatch to avoid a long startswith chain
+# Single token-to-handler dispatch to avoid a long startswith chain.
+# Handlers take (line, lineno, data, state, strict) positionally.
 DISPATCH = {
     protocol.ext_x_byterange: _parse_byterange,
     protocol.ext_x_bitrate: _parse_bitrate,
@@ -784,3 +1196,146 @@ DISPATCH = {
     protocol.ext_x_tiles: _parse_tiles,
     protocol.ext_x_blackout: _parse_blackout,
 }
+
+# Field projection: every output field maps to the tags whose handlers can
+# change it. "segments.<key>" names a key of each segment dict; any name is
+# also accepted as a prefix, so "segments" selects every segment field.
+# Fields listed with no tags are always produced.
+_CUE_TAGS = (
+    protocol.ext_x_cue_out,
+    protocol.ext_x_cue_out_cont,
+    protocol.ext_x_cue_in,
+    protocol.ext_x_cue_span,
+    protocol.ext_oatcls_scte35,
+    protocol.ext_x_asset,
+)
+
+PROJECTION_FIELDS = {
+    "media_sequence": (protocol.ext_x_media_sequence,),
+    "is_variant": (),
+    "is_endlist": (protocol.ext_x_endlist,),
+    "is_i_frames_only": (protocol.ext_i_frames_only,),
+    "is_independent_segments": (protocol.ext_is_independent_segments,),
+    "is_images_only": (protocol.ext_x_images_only,),
+    "playlist_type": (protocol.ext_x_playlist_type,),
+    "targetduration": (protocol.ext_x_targetduration,),
+    "discontinuity_sequence": (protocol.ext_x_discontinuity_sequence,),
+    "version": (protocol.ext_x_version,),
+    "allow_cache": (protocol.ext_x_allow_cache,),
+    "program_date_time": (protocol.ext_x_program_date_time,),
+    "bitrate": (protocol.ext_x_bitrate,),
+    "playlists": (),
+    "iframe_playlists": (protocol.ext_x_i_frame_stream_inf,),
+    "image_playlists": (protocol.ext_x_image_stream_inf,),
+    "tiles": (protocol.ext_x_tiles,),
+    "media": (protocol.ext_x_media,),
+    "keys": (protocol.ext_x_key,),
+    "rendition_reports": (protocol.ext_x_rendition_report,),
+    "skip": (protocol.ext_x_skip,),
+    "part_inf": (protocol.ext_x_part_inf,),
+    "session_data": (protocol.ext_x_session_data,),
+    "session_keys": (protocol.ext_x_session_key,),
+    "segment_map": (protocol.ext_x_map,),
+    "start": (protocol.ext_x_start,),
+    "server_control": (protocol.ext_x_server_control,),
+    "preload_hint": (protocol.ext_x_preload_hint,),
+    "content_steering": (protocol.ext_x_content_steering,),
+    "segments.uri": (),
+    "segments.duration": (),
+    "segments.title": (),
+    "segments.byterange": (),
+    "segments.bitrate": (protocol.ext_x_bitrate,),
+    # Parts advance the running date-time, and claim pending dateranges/gaps
+    "segments.program_date_time": (protocol.ext_x_program_date_time,),
+    "segments.current_program_date_time": (
+        protocol.ext_x_program_date_time,
+        protocol.ext_x_part,
+    ),
+    "segments.discontinuity": (protocol.ext_x_discontinuity,),
+    "segments.cue_in": _CUE_TAGS,
+    "segments.cue_out": _CUE_TAGS,
+    "segments.cue_out_start": _CUE_TAGS,
+    "segments.cue_out_explicitly_duration": _CUE_TAGS,
+    "segments.scte35": _CUE_TAGS,
+    "segments.oatcls_scte35": _CUE_TAGS,
+    "segments.scte35_duration": _CUE_TAGS,
+    "segments.scte35_elapsedtime": _CUE_TAGS,
+    "segments.asset_metadata": _CUE_TAGS,
+    "segments.key": (protocol.ext_x_key,),
+    "segments.init_section": (protocol.ext_x_map,),
+    "segments.dateranges": (protocol.ext_x_daterange, protocol.ext_x_part),
+    "segments.gap_tag": (protocol.ext_x_gap, protocol.ext_x_part),
+    "segments.blackout": (protocol.ext_x_blackout,),
+    "segments.parts": (
+        protocol.ext_x_part,
+        protocol.ext_x_program_date_time,
+        protocol.ext_x_daterange,
+        protocol.ext_x_gap,
+    ),
+    "ad_breaks": _CUE_TAGS
+    + (
+        protocol.ext_x_daterange,
+        protocol.ext_x_part,
+        protocol.ext_x_program_date_time,
+    ),
+}
+
+# Tags that decide which URI lines become segments or variants
+_STRUCTURAL_TAGS = (
+    protocol.extinf,
+    protocol.ext_x_byterange,
+    protocol.ext_x_stream_inf,
+)
+
+
+# Tags that open the segment they belong to, even when projected out
+_SEGMENT_OPENING_TAGS = (protocol.ext_x_part, protocol.ext_x_bitrate)
+
+
+def _skip_tag(line, lineno, data, state, strict):
+    pass
+
+
+def _open_segment(line, lineno, data, state, strict):
+    if "segment" not in state:
+        state["segment"] = {}
+
+
+def projection_tags(fields):
+    """
+    Return the set of tags that must be parsed to produce `fields`.
+
+    Raises ValueError for a name that is neither a field in
+    PROJECTION_FIELDS nor a prefix of one.
+    """
+    if isinstance(fields, str):
+        raise TypeError("fields must be an iterable of field names, not str")
+    tags = set(_STRUCTURAL_TAGS)
+    for name in fields:
+        if not isinstance(name, str):
+            raise TypeError("fields must be str")
+        group = name + "."
+        matched = False
+        for field, field_tags in PROJECTION_FIELDS.items():
+            if field == name or field.startswith(group):
+                tags.update(field_tags)
+                matched = True
+        if not matched:
+            raise ValueError(f"unknown field {name!r}")
+    return tags
+
+
+def _projected_dispatch(fields):
+    if isinstance(fields, str):
+        raise TypeError("fields must be an iterable of field names, not str")
+    return _projected_dispatch_for(frozenset(fields))
+
+
+@functools.lru_cache(maxsize=64)
+def _projected_dispatch_for(fields):
+    # Unrequested tags keep a no-op entry so strict mode still accepts them
+    tags = projection_tags(fields)
+    dispatch = dict.fromkeys(DISPATCH, _skip_tag)
+    dispatch.update(dict.fromkeys(_SEGMENT_OPENING_TAGS, _open_segment))
+    dispatch.update((tag, handler) for tag, handler in DISPATCH.items() if tag in tags)
+    return dispatch
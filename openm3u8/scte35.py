@@ -0,0 +1,934 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+"""
+SCTE-35 splice_info_section payloads.
+
+Playlists carry SCTE-35 cues as strings: base64 in EXT-X-CUE-OUT-CONT and
+EXT-OATCLS-SCTE35, hex in the SCTE35-CMD, SCTE35-OUT and SCTE35-IN
+attributes of EXT-X-DATERANGE. `decode` turns either form into a
+`SpliceInfoSection` with its splice command (`SpliceInsert`, `TimeSignal`,
+...) and splice descriptors (`SegmentationDescriptor`, ...), and checks
+the section's CRC-32; `encode` is the reverse and recomputes the lengths
+and the CRC. Times are in 90 kHz ticks as in the section itself, with
+seconds available from properties.
+
+The bit-level decoding runs in the C extension when it is available.
+"""
+
+import base64
+import binascii
+import os
+
+TABLE_ID = 0xFC
+CUEI = 0x43554549  # "CUEI", the identifier of the SCTE-35 descriptors
+TICKS_PER_SECOND = 90000
+_PTS_MASK = (1 << 33) - 1
+
+SPLICE_NULL = 0x00
+SPLICE_SCHEDULE = 0x04
+SPLICE_INSERT = 0x05
+TIME_SIGNAL = 0x06
+BANDWIDTH_RESERVATION = 0x07
+PRIVATE_COMMAND = 0xFF
+
+AVAIL_DESCRIPTOR = 0x00
+DTMF_DESCRIPTOR = 0x01
+SEGMENTATION_DESCRIPTOR = 0x02
+TIME_DESCRIPTOR = 0x03
+AUDIO_DESCRIPTOR = 0x04
+
+SEGMENTATION_TYPES = {
+    0x00: "Not Indicated",
+    0x01: "Content Identification",
+    0x02: "Call Ad Server",
+    0x10: "Program Start",
+    0x11: "Program End",
+    0x12: "Program Early Termination",
+    0x13: "Program Breakaway",
+    0x14: "Program Resumption",
+    0x15: "Program Runover Planned",
+    0x16: "Program Runover Unplanned",
+    0x17: "Program Overlap Start",
+    0x18: "Program Blackout Override",
+    0x19: "Program Join",
+    0x20: "Chapter Start",
+    0x21: "Chapter End",
+    0x22: "Break Start",
+    0x23: "Break End",
+    0x24: "Opening Credit Start",
+    0x25: "Opening Credit End",
+    0x26: "Closing Credit Start",
+    0x27: "Closing Credit End",
+    0x30: "Provider Advertisement Start",
+    0x31: "Provider Advertisement End",
+    0x32: "Distributor Advertisement Start",
+    0x33: "Distributor Advertisement End",
+    0x34: "Provider Placement Opportunity Start",
+    0x35: "Provider Placement Opportunity End",
+    0x36: "Distributor Placement Opportunity Start",
+    0x37: "Distributor Placement Opportunity End",
+    0x38: "Provider Overlay Placement Opportunity Start",
+    0x39: "Provider Overlay Placement Opportunity End",
+    0x3A: "Distributor Overlay Placement Opportunity Start",
+    0x3B: "Distributor Overlay Placement Opportunity End",
+    0x3C: "Provider Promo Start",
+    0x3D: "Provider Promo End",
+    0x3E: "Distributor Promo Start",
+    0x3F: "Distributor Promo End",
+    0x40: "Unscheduled Event Start",
+    0x41: "Unscheduled Event End",
+    0x42: "Alternate Content Opportunity Start",
+    0x43: "Alternate Content Opportunity End",
+    0x44: "Provider Ad Block Start",
+    0x45: "Provider Ad Block End",
+    0x46: "Distributor Ad Block Start",
+    0x47: "Distributor Ad Block End",
+    0x50: "Network Start",
+    0x51: "Network End",
+}
+
+# Segmentation types followed by sub_segment_num and sub_segments_expected
+_SUB_SEGMENT_TYPES = frozenset((0x34, 0x36, 0x38, 0x3A, 0x44, 0x46))
+
+# segmentation_upid_type values whose UPID is text rather than binary
+_TEXT_UPID_TYPES = frozenset((0x01, 0x02, 0x03, 0x07, 0x09, 0x0E, 0x0F, 0x11))
+MID_UPID_TYPE = 0x0D
+
+
+def _crc_table():
+    table = []
+    for byte in range(256):
+        crc = byte << 24
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x04C11DB7 if crc & 0x80000000 else crc << 1) & (
+                0xFFFFFFFF
+            )
+        table.append(crc)
+    return table
+
+
+_CRC_TABLE = _crc_table()
+
+
+def crc32(data):
+    """Return the MPEG-2 CRC-32 of `data`, as used by splice_info_section."""
+    crc = 0xFFFFFFFF
+    table = _CRC_TABLE
+    for byte in data:
+        crc = ((crc << 8) & 0xFFFFFFFF) ^ table[(crc >> 24) ^ byte]
+    return crc
+
+
+class _Bits:
+    """Big-endian bit reader over a bytes object."""
+
+    __slots__ = ("value", "size", "pos")
+
+    def __init__(self, data, start=0, end=None):
+        end = len(data) if end is None else end
+        self.value = int.from_bytes(data[start:end], "big")
+        self.size = (end - start) * 8
+        self.pos = 0
+
+    def read(self, n):
+        pos = self.pos + n
+        if pos > self.size:
+            raise ValueError("SCTE-35 section is truncated")
+        self.pos = pos
+        return (self.value >> (self.size - pos)) & ((1 << n) - 1)
+
+    def flag(self):
+        return bool(self.read(1))
+
+    def skip(self, n):
+        self.read(n)
+
+    def bytes(self, n):
+        return self.read(n * 8).to_bytes(n, "big") if n else b""
+
+    def splice_time(self):
+        # time_specified_flag, then 33 bits of pts_time or 7 reserved bits
+        if self.read(1):
+            self.skip(6)
+            return self.read(33)
+        self.skip(7)
+        return None
+
+    @property
+    def remaining(self):
+        return (self.size - self.pos) // 8
+
+
+def _decode_splice_insert(bits):
+    command = {
+        "splice_event_id": bits.read(32),
+        "splice_event_cancel_indicator": bits.flag(),
+    }
+    bits.skip(7)
+    if command["splice_event_cancel_indicator"]:
+        return command
+    command["out_of_network_indicator"] = bits.flag()
+    command["program_splice_flag"] = program = bits.flag()
+    command["duration_flag"] = duration = bits.flag()
+    command["splice_immediate_flag"] = immediate = bits.flag()
+    command["event_id_compliance_flag"] = bits.flag()
+    bits.skip(3)
+    if program and not immediate:
+        command["pts_time"] = bits.splice_time()
+    if not program:
+        components = []
+        for _ in range(bits.read(8)):
+            tag = bits.read(8)
+            components.append((tag, None if immediate else bits.splice_time()))
+        command["components"] = components
+    if duration:
+        command["auto_return"] = bits.flag()
+        bits.skip(6)
+        command["break_duration"] = bits.read(33)
+    command["unique_program_id"] = bits.read(16)
+    command["avail_num"] = bits.read(8)
+    command["avails_expected"] = bits.read(8)
+    return command
+
+
+def _decode_command(command_type, bits, length):
+    if command_type == SPLICE_INSERT:
+        return _decode_splice_insert(bits)
+    if command_type == TIME_SIGNAL:
+        return {"pts_time": bits.splice_time()}
+    if command_type in (SPLICE_NULL, BANDWIDTH_RESERVATION):
+        return {}
+    if length is None:
+        raise ValueError(
+            f"splice command 0x{command_type:02X} needs a splice_command_length"
+        )
+    if command_type == PRIVATE_COMMAND:
+        return {"identifier": bits.read(32), "data": bits.bytes(length - 4)}
+    return {"data": bits.bytes(length)}
+
+
+def _decode_segmentation(bits, descriptor):
+    descriptor["segmentation_event_id"] = bits.read(32)
+    descriptor["segmentation_event_cancel_indicator"] = bits.flag()
+    descriptor["segmentation_event_id_compliance_indicator"] = bits.flag()
+    bits.skip(6)
+    if descriptor["segmentation_event_cancel_indicator"]:
+        return
+    descriptor["program_segmentation_flag"] = program = bits.flag()
+    descriptor["segmentation_duration_flag"] = duration = bits.flag()
+    descriptor["delivery_not_restricted_flag"] = unrestricted = bits.flag()
+    if unrestricted:
+        bits.skip(5)
+    else:
+        descriptor["web_delivery_allowed_flag"] = bits.flag()
+        descriptor["no_regional_blackout_flag"] = bits.flag()
+        descriptor["archive_allowed_flag"] = bits.flag()
+        descriptor["device_restrictions"] = bits.read(2)
+    if not program:
+        components = []
+        for _ in range(bits.read(8)):
+            tag = bits.read(8)
+            bits.skip(7)
+            components.append((tag, bits.read(33)))
+        descriptor["components"] = components
+    if duration:
+        descriptor["segmentation_duration"] = bits.read(40)
+    descriptor["segmentation_upid_type"] = bits.read(8)
+    descriptor["segmentation_upid"] = bits.bytes(bits.read(8))
+    descriptor["segmentation_type_id"] = type_id = bits.read(8)
+    descriptor["segment_num"] = bits.read(8)
+    descriptor["segments_expected"] = bits.read(8)
+    if type_id in _SUB_SEGMENT_TYPES and bits.remaining >= 2:
+        descriptor["sub_segment_num"] = bits.read(8)
+        descriptor["sub_segments_expected"] = bits.read(8)
+
+
+def _decode_descriptor(tag, bits, length):
+    descriptor = {"tag": tag, "identifier": bits.read(32)}
+    if tag == AVAIL_DESCRIPTOR:
+        descriptor["provider_avail_id"] = bits.read(32)
+    elif tag == DTMF_DESCRIPTOR:
+        descriptor["preroll"] = bits.read(8)
+        count = bits.read(3)
+        bits.skip(5)
+        descriptor["dtmf_chars"] = bits.bytes(count).decode("ascii", "replace")
+    elif tag == SEGMENTATION_DESCRIPTOR:
+        _decode_segmentation(bits, descriptor)
+    elif tag == TIME_DESCRIPTOR:
+        descriptor["tai_seconds"] = bits.read(48)
+        descriptor["tai_ns"] = bits.read(32)
+        descriptor["utc_offset"] = bits.read(16)
+    elif tag == AUDIO_DESCRIPTOR:
+        components = []
+        count = bits.read(4)
+        bits.skip(4)
+        for _ in range(count):
+            components.append(
+                (
+                    bits.read(8),
+                    bits.bytes(3).decode("ascii", "replace"),
+                    bits.read(3),
+                    bits.read(4),
+                    bits.flag(),
+                )
+            )
+        descriptor["components"] = components
+    else:
+        descriptor["data"] = bits.bytes(length - 4)
+    return descriptor
+
+
+def _decode_section(data):
+    """
+    Decode the splice_info_section at the start of `data` into a dict of
+    its fields, with the command and each descriptor a dict of their own.
+    """
+    data = bytes(data)
+    if len(data) < 3:
+        raise ValueError("SCTE-35 section is truncated")
+    if data[0] != TABLE_ID:
+        raise ValueError(
+            f"not a SCTE-35 splice_info_section (table_id 0x{data[0]:02X})"
+        )
+    end = 3 + (((data[1] & 0x0F) << 8) | data[2])
+    if end > len(data) or end < 18:
+        raise ValueError("SCTE-35 section is truncated")
+
+    bits = _Bits(data, 0, end - 4)
+    bits.skip(8 + 2)
+    section = {"table_id": TABLE_ID, "sap_type": bits.read(2)}
+    bits.skip(12)
+    section["protocol_version"] = bits.read(8)
+    section["encrypted_packet"] = encrypted = bits.flag()
+    section["encryption_algorithm"] = bits.read(6)
+    section["pts_adjustment"] = bits.read(33)
+    section["cw_index"] = bits.read(8)
+    section["tier"] = bits.read(12)
+    length = bits.read(12)
+    section["splice_command_type"] = command_type = bits.read(8)
+    section["crc_32"] = crc = int.from_bytes(data[end - 4 : end], "big")
+    section["crc_valid"] = crc32(data[: end - 4]) == crc
+    if encrypted:
+        # Command and descriptors are only readable after decryption
+        section["splice_command"] = None
+        section["descriptors"] = []
+        return section
+
+    start = bits.pos // 8
+    if length == 0xFFF:
+        # Legacy encoders leave the length unset; the command then ends
+        # where its own syntax ends
+        section["splice_command"] = _decode_command(command_type, bits, None)
+    else:
+        if start + length > end - 4:
+            raise ValueError("SCTE-35 section is truncated")
+        section["splice_command"] = _decode_command(
+            command_type, _Bits(data, start, start + length), length
+        )
+        bits.pos = (start + length) * 8
+
+    descriptors = section["descriptors"] = []
+    loop_end = bits.pos // 8 + 2 + bits.read(16)
+    if loop_end > end - 4:
+        raise ValueError("SCTE-35 section is truncated")
+    position = bits.pos // 8
+    while position < loop_end:
+        if position + 2 > loop_end:
+            raise ValueError("SCTE-35 section is truncated")
+        tag, length = data[position], data[position + 1]
+        position += 2
+        if length < 4 or position + length > loop_end:
+            raise ValueError("SCTE-35 section is truncated")
+        descriptors.append(
+            _decode_descriptor(tag, _Bits(data, position, position + length), length)
+        )
+        position += length
+    return section
+
+
+decode_section = _decode_section
+if os.environ.get("M3U8_NO_C_EXTENSION", "") != "1":
+    try:
+        from openm3u8._m3u8_parser import decode_scte35 as decode_section
+    except ImportError:
+        pass
+
+
+class _Record:
+    """
+    Fields are set from keyword arguments, defaulting to `_defaults` and
+    otherwise None.
+    """
+
+    _fields = ()
+    _defaults = {}
+
+    def __init_subclass__(cls):
+        cls._blank = {name: cls._defaults.get(name) for name in cls._fields}
+
+    def __init__(self, **fields):
+        unknown = fields.keys() - self._blank.keys()
+        if unknown:
+            raise TypeError(f"{type(self).__name__} has no field {unknown.pop()!r}")
+        self.__dict__.update(self._blank)
+        self.__dict__.update(fields)
+
+    @classmethod
+    def _load(cls, fields):
+        # Decoder output has known fields only, so skip the check
+        record = cls.__new__(cls)
+        record.__dict__.update(cls._blank)
+        record.__dict__.update(fields)
+        return record
+
+    def _asdict(self):
+        return {name: self.__dict__[name] for name in self._fields}
+
+    def __eq__(self, other):
+        if type(other) is not type(self):
+            return NotImplemented
+        return self._asdict() == other._asdict()
+
+    def __repr__(self):
+        fields = ", ".join(
+            f"{name}={value!r}"
+            for name, value in self._asdict().items()
+            if value is not None
+        )
+        return f"{type(self).__name__}({fields})"
+
+
+def _seconds(ticks):
+    return None if ticks is None else ticks / TICKS_PER_SECOND
+
+
+# Splice commands
+
+
+class SpliceCommand(_Record):
+    """A splice command this module does not decode, kept as raw `data`."""
+
+    _fields = ("command_type", "data")
+
+
+class SpliceNull(_Record):
+    _fields = ()
+    command_type = SPLICE_NULL
+
+
+class BandwidthReservation(_Record):
+    _fields = ()
+    command_type = BANDWIDTH_RESERVATION
+
+
+class PrivateCommand(_Record):
+    _fields = ("identifier", "data")
+    command_type = PRIVATE_COMMAND
+    _defaults = {"data": b""}
+
+
+class TimeSignal(_Record):
+    """time_signal(): `pts_time` is None when no time is specified."""
+
+    _fields = ("pts_time",)
+    command_type = TIME_SIGNAL
+
+
+class SpliceInsert(_Record):
+    """
+    splice_insert(). `pts_time` is set for program splices that are not
+    immediate, `components` (a list of (component_tag, pts_time)) for
+    component splices, and `auto_return` and `break_duration` when
+    `duration_flag` is set. A cancelled event only has its id.
+    """
+
+    _fields = (
+        "splice_event_id",
+        "splice_event_cancel_indicator",
+        "out_of_network_indicator",
+        "program_splice_flag",
+        "duration_flag",
+        "splice_immediate_flag",
+        "event_id_compliance_flag",
+        "pts_time",
+        "components",
+        "auto_return",
+        "break_duration",
+        "unique_program_id",
+        "avail_num",
+        "avails_expected",
+    )
+    command_type = SPLICE_INSERT
+    _defaults = {
+        "splice_event_cancel_indicator": False,
+        "out_of_network_indicator": False,
+        "program_splice_flag": True,
+        "duration_flag": False,
+        "splice_immediate_flag": False,
+        "event_id_compliance_flag": True,
+        "unique_program_id": 0,
+        "avail_num": 0,
+        "avails_expected": 0,
+    }
+
+    @property
+    def break_duration_seconds(self):
+        return _seconds(self.break_duration)
+
+
+_COMMANDS = {
+    SPLICE_NULL: SpliceNull,
+    SPLICE_INSERT: SpliceInsert,
+    TIME_SIGNAL: TimeSignal,
+    BANDWIDTH_RESERVATION: BandwidthReservation,
+    PRIVATE_COMMAND: PrivateCommand,
+}
+
+
+# Splice descriptors
+
+
+class SpliceDescriptor(_Record):
+    """A splice descriptor this module does not decode, kept as raw `data`."""
+
+    _fields = ("tag", "identifier", "data")
+    _defaults = {"data": b""}
+
+
+class AvailDescriptor(_Record):
+    _fields = ("identifier", "provider_avail_id")
+    tag = AVAIL_DESCRIPTOR
+    _defaults = {"identifier": CUEI}
+
+
+class DTMFDescriptor(_Record):
+    _fields = ("identifier", "preroll", "dtmf_chars")
+    tag = DTMF_DESCRIPTOR
+    _defaults = {"identifier": CUEI, "dtmf_chars": ""}
+
+
+class TimeDescriptor(_Record):
+    _fields = ("identifier", "tai_seconds", "tai_ns", "utc_offset")
+    tag = TIME_DESCRIPTOR
+    _defaults = {"identifier": CUEI}
+
+
+class AudioDescriptor(_Record):
+    """`components` is a list of (component_tag, ISO_code, bit_stream_mode,
+    num_channels, full_srvc_audio)."""
+
+    _fields = ("identifier", "components")
+    tag = AUDIO_DESCRIPTOR
+    _defaults = {"identifier": CUEI}
+
+
+class SegmentationDescriptor(_Record):
+    """
+    segmentation_descriptor(). The delivery restriction fields are None
+    when `delivery_not_restricted_flag` is set, `components` (a list of
+    (component_tag, pts_offset)) is only set for component segmentation
+    and a cancelled event only has its id and flags. `segmentation_upid`
+    is the raw UPID; `upid` renders it.
+    """
+
+    _fields = (
+        "identifier",
+        "segmentation_event_id",
+        "segmentation_event_cancel_indicator",
+        "segmentation_event_id_compliance_indicator",
+        "program_segmentation_flag",
+        "segmentation_duration_flag",
+        "delivery_not_restricted_flag",
+        "web_delivery_allowed_flag",
+        "no_regional_blackout_flag",
+        "archive_allowed_flag",
+        "device_restrictions",
+        "components",
+        "segmentation_duration",
+        "segmentation_upid_type",
+        "segmentation_upid",
+        "segmentation_type_id",
+        "segment_num",
+        "segments_expected",
+        "sub_segment_num",
+        "sub_segments_expected",
+    )
+    tag = SEGMENTATION_DESCRIPTOR
+    _defaults = {
+        "identifier": CUEI,
+        "segmentation_event_cancel_indicator": False,
+        "segmentation_event_id_compliance_indicator": True,
+        "program_segmentation_flag": True,
+        "segmentation_duration_flag": False,
+        "delivery_not_restricted_flag": True,
+        "segmentation_upid_type": 0,
+        "segmentation_upid": b"",
+        "segmentation_type_id": 0,
+        "segment_num": 0,
+        "segments_expected": 0,
+    }
+
+    @property
+    def segmentation_type(self):
+        """The name of `segmentation_type_id`, such as "Break Start"."""
+        return SEGMENTATION_TYPES.get(self.segmentation_type_id)
+
+    @property
+    def duration(self):
+        """`segmentation_duration` in seconds, or None."""
+        return _seconds(self.segmentation_duration)
+
+    @property
+    def upid(self):
+        """
+        The UPID as text for the character based types (ISCI, Ad-ID, TID,
+        ADI, ADS, URI, SCR), as a list of (type, upid) for a MID, and as a
+        hex string otherwise. None when there is no UPID.
+        """
+        return _render_upid(self.segmentation_upid_type, self.segmentation_upid)
+
+
+def _render_upid(upid_type, upid):
+    if not upid:
+        return None
+    if upid_type in _TEXT_UPID_TYPES:
+        return upid.decode("ascii", "replace")
+    if upid_type == MID_UPID_TYPE:
+        upids = []
+        position = 0
+        while position + 2 <= len(upid):
+            inner_type, length = upid[position], upid[position + 1]
+            inner = upid[position + 2 : position + 2 + length]
+            upids.append((inner_type, _render_upid(inner_type, inner)))
+            position += 2 + length
+        return upids
+    return upid.hex()
+
+
+_DESCRIPTORS = {
+    AVAIL_DESCRIPTOR: AvailDescriptor,
+    DTMF_DESCRIPTOR: DTMFDescriptor,
+    SEGMENTATION_DESCRIPTOR: SegmentationDescriptor,
+    TIME_DESCRIPTOR: TimeDescriptor,
+    AUDIO_DESCRIPTOR: AudioDescriptor,
+}
+
+
+class SpliceInfoSection(_Record):
+    """
+    A splice_info_section. `splice_command` is None and `descriptors`
+    empty for encrypted sections. `crc_valid` tells whether `crc_32`
+    matched the decoded bytes; `encode` computes a fresh one.
+    """
+
+    _fields = (
+        "table_id",
+        "sap_type",
+        "protocol_version",
+        "encrypted_packet",
+        "encryption_algorithm",
+        "pts_adjustment",
+        "cw_index",
+        "tier",
+        "splice_command_type",
+        "splice_command",
+        "descriptors",
+        "crc_32",
+        "crc_valid",
+    )
+    _defaults = {
+        "table_id": TABLE_ID,
+        "sap_type": 3,
+        "protocol_version": 0,
+        "encrypted_packet": False,
+        "encryption_algorithm": 0,
+        "pts_adjustment": 0,
+        "cw_index": 0xFF,
+        "tier": 0xFFF,
+    }
+
+    def __init__(self, **fields):
+        super().__init__(**fields)
+        if self.descriptors is None:
+            self.descriptors = []
+        if self.splice_command_type is None and self.splice_command is not None:
+            self.splice_command_type = self.splice_command.command_type
+
+    @property
+    def pts_time(self):
+        """
+        The splice time of a splice_insert or time_signal with
+        `pts_adjustment` applied, in ticks, or None.
+        """
+        pts_time = getattr(self.splice_command, "pts_time", None)
+        if pts_time is None:
+            return None
+        return (pts_time + self.pts_adjustment) & _PTS_MASK
+
+    @property
+    def splice_time(self):
+        """`pts_time` in seconds."""
+        return _seconds(self.pts_time)
+
+    @property
+    def duration(self):
+        """
+        The break duration in seconds: that of a splice_insert, else the
+        first segmentation descriptor with a duration, else None.
+        """
+        duration = getattr(self.splice_command, "break_duration", None)
+        if duration is not None:
+            return _seconds(duration)
+        for descriptor in self.segmentation_descriptors:
+            if descriptor.segmentation_duration is not None:
+                return descriptor.duration
+        return None
+
+    @property
+    def segmentation_descriptors(self):
+        return [
+            descriptor
+            for descriptor in self.descriptors
+            if type(descriptor) is SegmentationDescriptor
+        ]
+
+    def encode(self):
+        return encode(self)
+
+    def to_base64(self):
+        return base64.b64encode(encode(self)).decode("ascii")
+
+    def to_hex(self):
+        """Return the section as the "0x..." hex form DATERANGE uses."""
+        return "0x" + encode(self).hex().upper()
+
+
+def _section(fields):
+    command = fields["splice_command"]
+    if command is not None:
+        command_type = fields["splice_command_type"]
+        cls = _COMMANDS.get(command_type)
+        if cls is None:
+            command["command_type"] = command_type
+            cls = SpliceCommand
+        fields["splice_command"] = cls._load(command)
+    descriptors = fields["descriptors"]
+    for i, descriptor in enumerate(descriptors):
+        cls = _DESCRIPTORS.get(descriptor["tag"])
+        if cls is None:
+            descriptors[i] = SpliceDescriptor._load(descriptor)
+        else:
+            del descriptor["tag"]
+            descriptors[i] = cls._load(descriptor)
+    return SpliceInfoSection._load(fields)
+
+
+def to_bytes(payload):
+    """
+    Return the bytes of a SCTE-35 `payload` given as bytes, base64 or hex
+    (with or without 0x), quoted or not.
+    """
+    if isinstance(payload, (bytes, bytearray, memoryview)):
+        return bytes(payload)
+    payload = payload.strip().strip('"')
+    try:
+        if payload[:2] in ("0x", "0X"):
+            return bytes.fromhex(payload[2:])
+        # A section starts with table_id 0xFC, "/" in base64
+        if payload[:2] in ("FC", "fc", "Fc", "fC"):
+            return bytes.fromhex(payload)
+        return base64.b64decode(payload, validate=True)
+    except (ValueError, binascii.Error) as error:
+        raise ValueError(f"not a base64 or hex SCTE-35 payload: {error}") from None
+
+
+def decode(payload, verify_crc=False):
+    """
+    Decode a SCTE-35 splice_info_section from bytes, base64 or hex and
+    return a `SpliceInfoSection`. Raises ValueError when the payload is
+    malformed or truncated, or when `verify_crc` is true and the CRC-32
+    does not match.
+    """
+    fields = decode_section(to_bytes(payload))
+    if verify_crc and not fields["crc_valid"]:
+        raise ValueError("SCTE-35 section fails its CRC-32 check")
+    return _section(fields)
+
+
+class _BitWriter:
+    __slots__ = ("value", "size")
+
+    def __init__(self):
+        self.value = 0
+        self.size = 0
+
+    def write(self, n, value):
+        value = int(value or 0)
+        if value < 0 or value >> n:
+            raise ValueError(f"{value} does not fit in {n} bits")
+        self.value = (self.value << n) | value
+        self.size += n
+
+    def bytes(self, data):
+        for byte in data:
+            self.write(8, byte)
+
+    def splice_time(self, pts_time):
+        if pts_time is None:
+            self.write(8, 0x7F)
+        else:
+            self.write(7, 0x7F)
+            self.write(33, pts_time)
+
+    def getvalue(self):
+        return self.value.to_bytes(self.size // 8, "big")
+
+
+def _encode_command(command):
+    out = _BitWriter()
+    if type(command) is SpliceInsert:
+        out.write(32, command.splice_event_id)
+        out.write(1, command.splice_event_cancel_indicator)
+        out.write(7, 0x7F)
+        if not command.splice_event_cancel_indicator:
+            program = command.program_splice_flag
+            immediate = command.splice_immediate_flag
+            out.write(1, command.out_of_network_indicator)
+            out.write(1, program)
+            out.write(1, command.duration_flag)
+            out.write(1, immediate)
+            out.write(1, command.event_id_compliance_flag)
+            out.write(3, 0x7)
+            if program and not immediate:
+                out.splice_time(command.pts_time)
+            if not program:
+                components = command.components or []
+                out.write(8, len(components))
+                for tag, pts_time in components:
+                    out.write(8, tag)
+                    if not immediate:
+                        out.splice_time(pts_time)
+            if command.duration_flag:
+                out.write(1, command.auto_return)
+                out.write(6, 0x3F)
+                out.write(33, command.break_duration)
+            out.write(16, command.unique_program_id)
+            out.write(8, command.avail_num)
+            out.write(8, command.avails_expected)
+    elif type(command) is TimeSignal:
+        out.splice_time(command.pts_time)
+    elif type(command) is PrivateCommand:
+        out.write(32, command.identifier)
+        out.bytes(command.data)
+    elif type(command) is SpliceCommand:
+        out.bytes(command.data or b"")
+    return out.getvalue()
+
+
+def _encode_segmentation(out, descriptor):
+    out.write(32, descriptor.segmentation_event_id)
+    out.write(1, descriptor.segmentation_event_cancel_indicator)
+    out.write(1, descriptor.segmentation_event_id_compliance_indicator)
+    out.write(6, 0x3F)
+    if descriptor.segmentation_event_cancel_indicator:
+        return
+    program = descriptor.program_segmentation_flag
+    out.write(1, program)
+    out.write(1, descriptor.segmentation_duration_flag)
+    out.write(1, descriptor.delivery_not_restricted_flag)
+    if descriptor.delivery_not_restricted_flag:
+        out.write(5, 0x1F)
+    else:
+        out.write(1, descriptor.web_delivery_allowed_flag)
+        out.write(1, descriptor.no_regional_blackout_flag)
+        out.write(1, descriptor.archive_allowed_flag)
+        out.write(2, descriptor.device_restrictions)
+    if not program:
+        components = descriptor.components or []
+        out.write(8, len(components))
+        for tag, pts_offset in components:
+            out.write(8, tag)
+            out.write(7, 0x7F)
+            out.write(33, pts_offset)
+    if descriptor.segmentation_duration_flag:
+        out.write(40, descriptor.segmentation_duration)
+    upid = descriptor.segmentation_upid or b""
+    out.write(8, descriptor.segmentation_upid_type)
+    out.write(8, len(upid))
+    out.bytes(upid)
+    out.write(8, descriptor.segmentation_type_id)
+    out.write(8, descriptor.segment_num)
+    out.write(8, descriptor.segments_expected)
+    if descriptor.sub_segment_num is not None:
+        out.write(8, descriptor.sub_segment_num)
+        out.write(8, descriptor.sub_segments_expected)
+
+
+def _encode_descriptor(descriptor):
+    out = _BitWriter()
+    out.write(32, descriptor.identifier)
+    if type(descriptor) is AvailDescriptor:
+        out.write(32, descriptor.provider_avail_id)
+    elif type(descriptor) is DTMFDescriptor:
+        chars = descriptor.dtmf_chars.encode("ascii")
+        out.write(8, descriptor.preroll)
+        out.write(3, len(chars))
+        out.write(5, 0x1F)
+        out.bytes(chars)
+    elif type(descriptor) is SegmentationDescriptor:
+        _encode_segmentation(out, descriptor)
+    elif type(descriptor) is TimeDescriptor:
+        out.write(48, descriptor.tai_seconds)
+        out.write(32, descriptor.tai_ns)
+        out.write(16, descriptor.utc_offset)
+    elif type(descriptor) is AudioDescriptor:
+        components = descriptor.components or []
+        out.write(4, len(components))
+        out.write(4, 0xF)
+        for tag, iso_code, bit_stream_mode, num_channels, full_srvc in components:
+            out.write(8, tag)
+            out.bytes(iso_code.encode("ascii"))
+            out.write(3, bit_stream_mode)
+            out.write(4, num_channels)
+            out.write(1, full_srvc)
+    else:
+        out.bytes(descriptor.data or b"")
+    body = out.getvalue()
+    if len(body) > 255:
+        raise ValueError("splice descriptor is longer than 255 bytes")
+    return bytes((descriptor.tag, len(body))) + body
+
+
+def encode(section):
+    """
+    Return the bytes of `section`, a `SpliceInfoSection`, with its
+    section, command and descriptor lengths and its CRC-32 computed.
+    Raises ValueError for encrypted sections and out of range fields.
+    """
+    if section.encrypted_packet:
+        raise ValueError("encrypted SCTE-35 sections cannot be encoded")
+    command = section.splice_command or SpliceNull()
+    command_bytes = _encode_command(command)
+    descriptors = b"".join(_encode_descriptor(d) for d in section.descriptors)
+
+    out = _BitWriter()
+    out.write(8, section.table_id)
+    out.write(1, 0)  # section_syntax_indicator
+    out.write(1, 0)  # private_indicator
+    out.write(2, section.sap_type)
+    out.write(12, 11 + len(command_bytes) + 2 + len(descriptors) + 4)
+    out.write(8, section.protocol_version)
+    out.write(1, 0)
+    out.write(6, section.encryption_algorithm)
+    out.write(33, section.pts_adjustment)
+    out.write(8, section.cw_index)
+    out.write(12, section.tier)
+    out.write(12, len(command_bytes))
+    out.write(8, command.command_type)
+    out.bytes(command_bytes)
+    out.write(16, len(descriptors))
+    out.bytes(descriptors)
+    data = out.getvalue()
+    return data + crc32(data).to_bytes(4, "big")
@@ -0,0 +1,406 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+"""
+Parsed playlists shared between processes through shared memory.
+
+One process, the writer, parses playlists and publishes them with
+`SharedPlaylistCache.put`; any number of readers (typically pre-forked
+web workers) attach to the cache by name and `get` a `PlaylistView` that
+reads the published snapshot in place, so each playlist is parsed once
+and held once per machine instead of once per worker.
+
+Every published playlist is a `dumpb` snapshot in a shared memory block
+of its own, named after the cache and a generation number that is never
+reused, and is never modified after publishing:
+
+    header   generation u64, snapshot length u64, key length u16
+    key      UTF-8
+    snapshot
+
+The cache block itself is a fixed-size directory:
+
+    header   magic, format version u32, capacity u32
+    entries  capacity x generation u64 (0 for a free entry)
+
+An update writes a new block, header last, then publishes it by storing
+its generation in the directory entry and finally unlinks the previous
+block. That store is a single aligned 8-byte write, which readers never
+see torn, so a directory entry needs no lock. A reader attaches the block
+an entry points to and checks the generation in its header, retrying,
+backing off, while the block has just been unlinked or its header is not
+visible yet; the key and snapshot behind a matching header never change.
+A reader gives up with TimeoutError after about a second. Readers that
+still hold a view of a replaced playlist keep the old block mapped until
+the view is released.
+"""
+
+import os
+import struct
+import sys
+import time
+from multiprocessing import resource_tracker, shared_memory
+
+from openm3u8.model import M3U8
+from openm3u8.snapshot import dumpb, restore
+
+MAGIC = b"OM3USHM\0"
+FORMAT_VERSION = 2
+
+_HEADER = struct.Struct("<8sII")
+_BLOCK = struct.Struct("<QQH")  # generation, snapshot length, key length
+_ENTRY_SIZE = 8
+_MAX_KEY = 255
+# Seconds readers wait for an entry that keeps changing
+_RETRY_TIMEOUT = 1.0
+
+
+def _retries():
+    """
+    Yield once per read attempt until `_RETRY_TIMEOUT` has passed, yielding
+    the CPU between attempts and then sleeping for up to a millisecond, so
+    readers waiting on a descheduled writer don't spin against it.
+    """
+    deadline = time.monotonic() + _RETRY_TIMEOUT
+    delay = 0.0
+    while True:
+        yield
+        if time.monotonic() >= deadline:
+            return
+        time.sleep(delay)
+        delay = min(delay * 2 or 1e-5, 1e-3)
+
+
+# Before 3.13 attaching to a block registers it with the resource tracker,
+# which unlinks it when the attaching process exits
+_UNTRACKED_ATTACH = sys.version_info >= (3, 13) or os.name != "posix"
+
+
+def _attach(name):
+    if sys.version_info >= (3, 13):
+        return shared_memory.SharedMemory(name, track=False)
+    block = shared_memory.SharedMemory(name)
+    if not _UNTRACKED_ATTACH:
+        resource_tracker.unregister(block._name, "shared_memory")
+    return block
+
+
+def _unlink(block):
+    block.close()
+    if not _UNTRACKED_ATTACH:
+        # A reader sharing our resource tracker may have unregistered it
+        resource_tracker.register(block._name, "shared_memory")
+    block.unlink()
+
+
+# Blocks whose segment table outlived its view: the mapping cannot be
+# closed while the table reads it, so closing is retried on later releases
+_unclosed = []
+
+
+def _close(block):
+    try:
+        block.close()
+    except BufferError:
+        _unclosed.append(block)
+    for pending in list(_unclosed):
+        try:
+            pending.close()
+        except BufferError:
+            continue
+        _unclosed.remove(pending)
+
+
+class PlaylistView:
+    """
+    Read-only view of a playlist published in a `SharedPlaylistCache`.
+
+    `data` is the parse result with header fields decoded and "segments" a
+    lazy `SegmentTable` reading the shared block; items are available as
+    ``view[key]`` too. `m3u8` builds a full, private `M3U8` from it.
+
+    The view keeps the block mapped and unmaps it when it is released,
+    with `release` or once it is garbage collected; its segment table is
+    only meant to be used while the view is alive.
+    """
+
+    __slots__ = ("key", "generation", "data", "meta", "_block", "_buffer")
+
+    def __init__(self, key, generation, block):
+        self.key = key
+        self.generation = generation
+        self._block = block
+        _, length, key_length = _BLOCK.unpack_from(block.buf)
+        start = _BLOCK.size + key_length
+        self._buffer = block.buf[start : start + length]
+        _, self.data, self.meta = restore(self._buffer, lazy=True)
+
+    def __getitem__(self, name):
+        return self.data[name]
+
+    def __contains__(self, name):
+        return name in self.data
+
+    def get(self, name, default=None):
+        return self.data.get(name, default)
+
+    @property
+    def segments(self):
+        return self.data.get("segments", ())
+
+    def m3u8(self):
+        """Return a new `M3U8` built from this view."""
+        data = dict(self.data)
+        if "segments" in data:
+            data["segments"] = data["segments"].tolist()
+        meta = self.meta or {}
+        playlist = M3U8.from_data(data, meta.get("base_path"), meta.get("base_uri"))
+        playlist.fingerprint = meta.get("fingerprint")
+        return playlist
+
+    def release(self):
+        """Unmap the playlist block; the view must not be used afterwards."""
+        block = getattr(self, "_block", None)
+        if block is None:
+            return
+        self._block = None
+        self.data = {}
+        self._buffer.release()
+        _close(block)
+
+    def __del__(self):
+        self.release()
+
+    def __repr__(self):
+        return f"<PlaylistView {self.key!r} generation {self.generation}>"
+
+
+class SharedPlaylistCache:
+    """
+    A named cache of parsed playlists in shared memory.
+
+    ``SharedPlaylistCache(name, create=True, capacity=...)`` creates the
+    cache and makes this process its only writer; readers open it with
+    ``SharedPlaylistCache(name)``. Writers `put` and `delete` entries and
+    `unlink` the cache when done; readers `get` views. Both `close` their
+    handle when they no longer need it. The cache does not outlive the
+    writer process: the resource tracker unlinks what is left when it
+    exits.
+    """
+
+    def __init__(self, name, create=False, capacity=256):
+        self.name = name
+        self.writer = create
+        if create:
+            if capacity < 1:
+                raise ValueError("capacity must be at least 1")
+            self._directory = shared_memory.SharedMemory(
+                name, create=True, size=_HEADER.size + capacity * _ENTRY_SIZE
+            )
+            _HEADER.pack_into(self._directory.buf, 0, MAGIC, FORMAT_VERSION, capacity)
+            self._blocks = {}
+            self._generation = 0
+        else:
+            self._directory = _attach(name)
+            magic, version, capacity = _HEADER.unpack_from(self._directory.buf)
+            if magic != MAGIC or version != FORMAT_VERSION:
+                self._directory.close()
+                raise ValueError(f"{name!r} is not a shared playlist cache")
+            self._views = {}
+            # Keys by generation: a published block never changes
+            self._keys = {}
+        self.capacity = capacity
+        self._slots = {}
+        # Native 8-byte items, so each entry is read and written at once
+        self._entries = self._directory.buf[
+            _HEADER.size : _HEADER.size + capacity * _ENTRY_SIZE
+        ].cast("Q")
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc_info):
+        self.close()
+
+    def _block_name(self, generation):
+        return f"{self.name}_{generation}"
+
+    # Writer
+
+    def put(self, key, playlist):
+        """
+        Publish `playlist` (a `M3U8` or a `parse` result) under `key`,
+        replacing any previous version atomically. Returns the generation
+        number of the new version. Raises ValueError when the key is too
+        long or the cache is full.
+        """
+        self._check_writer()
+        encoded = key.encode("utf-8")
+        if len(encoded) > _MAX_KEY:
+            raise ValueError(f"cache keys are limited to {_MAX_KEY} bytes")
+        slot = self._slots.get(key)
+        if slot is None:
+            used = set(self._slots.values())
+            slot = next((s for s in range(self.capacity) if s not in used), None)
+            if slot is None:
+                raise ValueError(f"cache {self.name!r} is full")
+
+        snapshot = dumpb(playlist)
+        self._generation += 1
+        generation = self._generation
+        start = _BLOCK.size + len(encoded)
+        block = shared_memory.SharedMemory(
+            self._block_name(generation),
+            create=True,
+            size=start + len(snapshot),
+        )
+        block.buf[_BLOCK.size : start] = encoded
+        block.buf[start : start + len(snapshot)] = snapshot
+        _BLOCK.pack_into(block.buf, 0, generation, len(snapshot), len(encoded))
+
+        self._entries[slot] = generation
+        self._slots[key] = slot
+        previous = self._blocks.get(key)
+        self._blocks[key] = block
+        if previous is not None:
+            _unlink(previous)
+        return generation
+
+    def delete(self, key):
+        """Remove `key` from the cache. Raises KeyError when it is missing."""
+        self._check_writer()
+        slot = self._slots.pop(key)
+        self._entries[slot] = 0
+        _unlink(self._blocks.pop(key))
+
+    def _check_writer(self):
+        if not self.writer:
+            raise PermissionError("only the process that created the cache writes")
+
+    # Reader
+
+    def _open(self, generation):
+        """
+        Return the block of `generation`, or None when it has been unlinked
+        since or its header is not visible yet.
+        """
+        try:
+            block = _attach(self._block_name(generation))
+        except FileNotFoundError:
+            return None
+        if _BLOCK.unpack_from(block.buf)[0] != generation:
+            block.close()
+            return None
+        return block
+
+    def _read_entry(self, slot):
+        """Return (generation, key) of `slot`, or (0, None) when it is free."""
+        for _ in _retries():
+            generation = self._entries[slot]
+            if not generation:
+                return 0, None
+            key = self._keys.get(generation)
+            if key is not None:
+                return generation, key
+            block = self._open(generation)
+            if block is None:
+                continue
+            size = _BLOCK.unpack_from(block.buf)[2]
+            key = bytes(block.buf[_BLOCK.size : _BLOCK.size + size])
+            block.close()
+            if len(self._keys) >= self.capacity:
+                published = set(self._entries)
+                self._keys = {g: k for g, k in self._keys.items() if g in published}
+            self._keys[generation] = key
+            return generation, key
+        raise TimeoutError(f"entry {slot} of {self.name!r} kept changing")
+
+    def _find(self, key, encoded):
+        slot = self._slots.get(key)
+        if slot is not None:
+            generation, found = self._read_entry(slot)
+            if found == encoded:
+                return slot, generation
+        for slot in range(self.capacity):
+            generation, found = self._read_entry(slot)
+            if found == encoded:
+                self._slots[key] = slot
+                return slot, generation
+        self._slots.pop(key, None)
+        return None, 0
+
+    def get(self, key, default=None):
+        """
+        Return a `PlaylistView` of the latest version of `key`, or
+        `default` when it is not in the cache. Views of an unchanged entry
+        are reused until they are released.
+        """
+        if self.writer:
+            raise PermissionError("the writer keeps its own playlists")
+        encoded = key.encode("utf-8")
+        for _ in _retries():
+            slot, generation = self._find(key, encoded)
+            if slot is None:
+                self._views.pop(key, None)
+                return default
+            view = self._views.get(key)
+            if (
+                view is not None
+                and view.generation == generation
+                and view._block is not None
+            ):
+                return view
+            block = self._open(generation)
+            if block is None:
+                continue  # replaced since the entry was read
+            view = self._views[key] = PlaylistView(key, generation, block)
+            return view
+        raise TimeoutError(f"{key!r} of {self.name!r} kept changing")
+
+    def __contains__(self, key):
+        encoded = key.encode("utf-8")
+        if self.writer:
+            return key in self._slots
+        return self._find(key, encoded)[0] is not None
+
+    def keys(self):
+        """Return the keys currently in the cache."""
+        if self.writer:
+            return list(self._slots)
+        keys = []
+        for slot in range(self.capacity):
+            generation, key = self._read_entry(slot)
+            if generation:
+                keys.append(key.decode("utf-8"))
+        return keys
+
+    def load(self, key):
+        """Return a full `M3U8` of `key`, or None when it is missing."""
+        view = self.get(key)
+        return None if view is None else view.m3u8()
+
+    # Lifetime
+
+    def close(self):
+        """
+        Close this handle; published playlists stay in shared memory, and
+        views still referenced keep their playlist mapped until released.
+        """
+        if self.writer:
+            for block in self._blocks.values():
+                block.close()
+        else:
+            self._views.clear()
+        self._entries.release()
+        self._directory.close()
+
+    def unlink(self):
+        """Destroy the cache and every playlist in it (writer only)."""
+        self._check_writer()
+        for block in self._blocks.values():
+            _unlink(block)
+        self._blocks.clear()
+        self._slots.clear()
+        self._entries.release()
+        _unlink(self._directory)
@@ -0,0 +1,719 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+"""
+Compact binary snapshots of parsed playlists.
+
+`dumpb` serializes the dict returned by `parse`, or a `M3U8` (the parse
+result it was built from plus its base URI and base path), and `loadb`
+restores it without reparsing the text. Segments are stored column by
+column: floats and integers as packed arrays, strings as indexes into a
+shared string table and values repeated on every segment only once, so
+snapshots are smaller than a pickle of the same dict and long segment
+lists load faster. With ``lazy=True`` segment records are only decoded when accessed.
+
+Layout, little-endian, every section aligned to 8 bytes:
+
+    header   magic, format version u16, kind u16, section count u32
+    index    (tag, offset u64, length u64) for each section
+    STRS     string count u32, flags u32, byte offsets u32[count + 1], UTF-8
+    OBJS     containers referenced more than once, shared again on load
+    HEAD     every top-level key except "segments"
+    META     base_uri, base_path and fingerprint of a M3U8
+    SEGS     row count u32, column count u32, column directory, columns
+
+Only the value types `parse` produces are supported: None, bool, int,
+float, str, list, tuple, dict and datetime with a fixed UTC offset.
+"""
+
+import struct
+import sys
+from array import array
+from datetime import datetime, timedelta, timezone
+from operator import itemgetter
+
+from openm3u8.model import M3U8
+
+MAGIC = b"OM3USNP\0"
+FORMAT_VERSION = 1
+
+KIND_DATA = 0
+KIND_M3U8 = 1
+
+_HEADER = struct.Struct("<8sHHI")
+_SECTION = struct.Struct("<4sQQ")
+_COLUMN = struct.Struct("<IBBHII")
+_U32 = struct.Struct("<I")
+_U32_PAIR = struct.Struct("<II")
+_I64 = struct.Struct("<q")
+_F64 = struct.Struct("<d")
+_DATETIME = struct.Struct("<qi")
+
+# Generic value tags
+_NONE, _FALSE, _TRUE, _INT, _BIGINT, _FLOAT, _STR = range(7)
+_LIST, _TUPLE, _DICT, _DATETIME_TAG, _REF = range(7, 12)
+
+# Column types
+_CONST, _FLOAT64, _INT64, _STRING, _BOOL, _DATETIMES, _GENERIC = range(7)
+_HAS_NULLS = 1
+_HAS_ABSENT = 2
+
+_INT64_MIN = -(2**63)
+_INT64_MAX = 2**63 - 1
+_NAIVE = -(2**31)
+_NO_NUL = 1
+
+_EPOCH = datetime(1970, 1, 1)
+_UTC_EPOCH = datetime(1970, 1, 1, tzinfo=timezone.utc)
+_MICROSECOND = timedelta(microseconds=1)
+_LITTLE_ENDIAN = sys.byteorder == "little"
+
+_ABSENT = object()
+
+
+class SnapshotError(ValueError):
+    """Raised by `loadb` for data that is not a readable snapshot."""
+
+
+def _align(out):
+    out.extend(b"\0" * (-len(out) % 8))
+
+
+def _fixed_offset(value):
+    """Return the UTC offset of `value` in seconds, _NAIVE, or None if unsupported."""
+    if value.tzinfo is None:
+        return _NAIVE if not value.fold else None
+    if type(value.tzinfo) is not timezone:
+        return None
+    offset = value.utcoffset()
+    if offset.microseconds:
+        return None
+    return offset.days * 86400 + offset.seconds
+
+
+def _micros(value, offset):
+    epoch = _EPOCH if offset == _NAIVE else _UTC_EPOCH
+    return (value - epoch) // _MICROSECOND
+
+
+class _Encoder:
+    def __init__(self):
+        self.strings = {}
+        self.refs = {}
+        self.shared = []
+
+    def string(self, value):
+        # 0 stands for None in string columns
+        index = self.strings.get(value)
+        if index is None:
+            index = self.strings[value] = len(self.strings) + 1
+        return index
+
+    def find_shared(self, value, seen):
+        """Record the containers in `value` that are reached more than once."""
+        if type(value) not in (list, tuple, dict):
+            return
+        key = id(value)
+        if key in seen:
+            if key not in self.refs:
+                self.refs[key] = len(self.shared)
+                self.shared.append(value)
+            return
+        seen[key] = value
+        for item in value.values() if type(value) is dict else value:
+            self.find_shared(item, seen)
+
+    def value(self, value, out, inline=False):
+        kind = type(value)
+        if value is None:
+            out.append(_NONE)
+        elif kind is bool:
+            out.append(_TRUE if value else _FALSE)
+        elif kind is int:
+            if _INT64_MIN <= value <= _INT64_MAX:
+                out.append(_INT)
+                out += _I64.pack(value)
+            else:
+                data = value.to_bytes(
+                    (value.bit_length() + 8) // 8, "little", signed=True
+                )
+                out.append(_BIGINT)
+                out += _U32.pack(len(data))
+                out += data
+        elif kind is float:
+            out.append(_FLOAT)
+            out += _F64.pack(value)
+        elif kind is str:
+            out.append(_STR)
+            out += _U32.pack(self.string(value))
+        elif kind in (list, tuple, dict):
+            ref = None if inline else self.refs.get(id(value))
+            if ref is not None:
+                out.append(_REF)
+                out += _U32.pack(ref)
+            elif kind is dict:
+                out.append(_DICT)
+                out += _U32.pack(len(value))
+                for key, item in value.items():
+                    self.value(key, out)
+                    self.value(item, out)
+            else:
+                out.append(_LIST if kind is list else _TUPLE)
+                out += _U32.pack(len(value))
+                for item in value:
+                    self.value(item, out)
+        elif kind is datetime and _fixed_offset(value) is not None:
+            offset = _fixed_offset(value)
+            out.append(_DATETIME_TAG)
+            out += _DATETIME.pack(_micros(value, offset), offset)
+        else:
+            raise TypeError(f"cannot snapshot a value of type {kind.__name__}")
+
+    def encoded(self, value, inline=False):
+        out = bytearray()
+        self.value(value, out, inline)
+        return out
+
+    def blobs(self, values, inline=False):
+        """Return u32 offsets followed by the encodings of `values`."""
+        blobs = [self.encoded(value, inline) for value in values]
+        offsets = [0]
+        for blob in blobs:
+            offsets.append(offsets[-1] + len(blob))
+        out = bytearray(struct.pack(f"<{len(offsets)}I", *offsets))
+        for blob in blobs:
+            out += blob
+        return out
+
+    def column(self, values):
+        """Return (type, flags, payload) for one segment key."""
+        present = [value for value in values if value is not _ABSENT]
+        flags = _HAS_ABSENT if len(present) != len(values) else 0
+        out = bytearray()
+        if flags & _HAS_ABSENT:
+            out += bytes(value is _ABSENT for value in values)
+            _align(out)
+
+        # A value every segment shares: an equal scalar, or the same shared
+        # container (the current key or map) so it stays shared on load
+        first = present[0]
+        if type(first) in _SCALARS:
+            constant = all(
+                type(value) is type(first) and value == first for value in present
+            )
+        else:
+            constant = id(first) in self.refs and all(
+                value is first for value in present
+            )
+        if constant:
+            out += self.encoded(first)
+            return _CONST, flags, out
+
+        types = {type(value) for value in present}
+        nulls = type(None) in types
+        types.discard(type(None))
+        if types == {str}:
+            ids = [0 if value is None else self.string(value) for value in present]
+            out += struct.pack(f"<{len(values)}I", *_spread(ids, values, 0))
+            return _STRING, flags, out
+        if types == {datetime} and all(
+            value is None or _fixed_offset(value) is not None for value in present
+        ):
+            pairs = [
+                (_INT64_MIN, 0)
+                if value is None
+                else (_micros(value, _fixed_offset(value)), _fixed_offset(value))
+                for value in present
+            ]
+            pairs = _spread(pairs, values, (_INT64_MIN, 0))
+            out += struct.pack(f"<{len(values)}q", *(micros for micros, _ in pairs))
+            out += struct.pack(f"<{len(values)}i", *(offset for _, offset in pairs))
+            return _DATETIMES, flags, out
+        if types in ({float}, {int}, {bool}) and not (
+            types == {int}
+            and not all(
+                value is None or _INT64_MIN <= value <= _INT64_MAX for value in present
+            )
+        ):
+            if nulls:
+                flags |= _HAS_NULLS
+                out += bytes(value is None for value in values)
+                _align(out)
+            numbers = _spread([value or 0 for value in present], values, 0)
+            if types == {float}:
+                out += struct.pack(f"<{len(values)}d", *numbers)
+                return _FLOAT64, flags, out
+            if types == {int}:
+                out += struct.pack(f"<{len(values)}q", *numbers)
+                return _INT64, flags, out
+            out += bytes(numbers)
+            return _BOOL, flags, out
+
+        out += self.blobs(_spread(present, values, None))
+        return _GENERIC, flags, out
+
+
+_SCALARS = (type(None), bool, int, float, str)
+
+
+def _spread(present, values, filler):
+    """Return `present` with `filler` where `values` had an absent key."""
+    if len(present) == len(values):
+        return present
+    items = iter(present)
+    return [filler if value is _ABSENT else next(items) for value in values]
+
+
+def _segments_section(encoder, segments):
+    keys = {}
+    for segment in segments:
+        for key in segment:
+            keys.setdefault(key, None)
+    columns = [
+        (key, encoder.column([segment.get(key, _ABSENT) for segment in segments]))
+        for key in keys
+    ]
+
+    out = bytearray(_U32_PAIR.pack(len(segments), len(columns)))
+    directory = len(out)
+    out += bytes(_COLUMN.size * len(columns))
+    _align(out)
+    for number, (key, (column_type, flags, payload)) in enumerate(columns):
+        offset = len(out)
+        out += payload
+        _align(out)
+        _COLUMN.pack_into(
+            out,
+            directory + number * _COLUMN.size,
+            encoder.string(key),
+            column_type,
+            flags,
+            0,
+            offset,
+            len(payload),
+        )
+    return out
+
+
+def _strings_section(strings):
+    ordered = sorted(strings, key=strings.get)
+    encoded = [value.encode("utf-8", "surrogatepass") for value in ordered]
+    flags = 0 if any("\0" in value for value in ordered) else _NO_NUL
+    offsets = [0]
+    for data in encoded:
+        # Strings are NUL separated so the whole table splits in one call
+        offsets.append(offsets[-1] + len(data) + 1)
+    out = bytearray(_U32_PAIR.pack(len(ordered), flags))
+    out += struct.pack(f"<{len(offsets)}I", *offsets)
+    out += b"".join(data + b"\0" for data in encoded)
+    return out
+
+
+def dumpb(playlist):
+    """
+    Return a binary snapshot of `playlist`, a dict returned by `parse` or a
+    `M3U8`. For a M3U8 the snapshot holds the parse result it was built
+    from (`M3U8.data`) with its base URI and base path, so changes made to
+    the model objects afterwards are not included. Raises TypeError for
+    values `parse` never produces, such as custom objects stored by a
+    custom tag parser.
+    """
+    if isinstance(playlist, M3U8):
+        kind = KIND_M3U8
+        data = playlist.data
+        meta = {
+            "base_uri": playlist.base_uri,
+            "base_path": playlist.base_path,
+            "fingerprint": playlist.fingerprint,
+        }
+    else:
+        kind = KIND_DATA
+        data = playlist
+        meta = None
+
+    segments = data.get("segments") or []
+    head = dict(data)
+    if "segments" in head:
+        head["segments"] = None  # stored in SEGS, keeps its place in the order
+
+    encoder = _Encoder()
+    seen = {}
+    encoder.find_shared(head, seen)
+    for segment in segments:
+        encoder.find_shared(segment, seen)
+        # Segment dicts are rebuilt row by row and never shared themselves
+        seen.pop(id(segment), None)
+
+    sections = [
+        (b"HEAD", encoder.encoded(head, inline=True)),
+        (b"SEGS", _segments_section(encoder, segments)),
+    ]
+    if meta is not None:
+        sections.append((b"META", encoder.encoded(meta)))
+    sections.append(
+        (
+            b"OBJS",
+            _U32.pack(len(encoder.shared)) + encoder.blobs(encoder.shared, inline=True),
+        )
+    )
+    sections.append((b"STRS", _strings_section(encoder.strings)))
+
+    out = bytearray(_HEADER.pack(MAGIC, FORMAT_VERSION, kind, len(sections)))
+    index = len(out)
+    out += bytes(_SECTION.size * len(sections))
+    _align(out)
+    for number, (tag, payload) in enumerate(sections):
+        _SECTION.pack_into(
+            out, index + number * _SECTION.size, tag, len(out), len(payload)
+        )
+        out += payload
+        _align(out)
+    return bytes(out)
+
+
+def _array(buffer, fmt, count):
+    """View `count` packed little-endian values of `fmt` in `buffer`."""
+    view = buffer[: count * struct.calcsize(fmt)]
+    if _LITTLE_ENDIAN:
+        return view.cast(fmt)
+    values = array(fmt)
+    values.frombytes(view)
+    values.byteswap()
+    return values
+
+
+class _Strings:
+    """The string table, decoded in full on first bulk use or one by one."""
+
+    def __init__(self, section):
+        count, self._flags = _U32_PAIR.unpack_from(section)
+        self._offsets = _array(section[8:], "I", count + 1)
+        self._data = section[8 + 4 * (count + 1) :]
+        self._all = None
+
+    def __getitem__(self, index):
+        if index == 0:
+            return None
+        if self._all is not None:
+            return self._all[index]
+        start = self._offsets[index - 1]
+        end = self._offsets[index] - 1
+        return str(self._data[start:end], "utf-8", "surrogatepass")
+
+    def all(self):
+        if self._all is None:
+            if self._flags & _NO_NUL:
+                text = str(self._data, "utf-8", "surrogatepass")
+                self._all = [None, *text.split("\0")[:-1]]
+            else:
+                self._all = [None] + [self[i] for i in range(1, len(self._offsets))]
+        return self._all
+
+
+class _Decoder:
+    def __init__(self, strings, objects):
+        self.strings = strings
+        count = _U32.unpack_from(objects)[0]
+        self._offsets = _array(objects[4:], "I", count + 1)
+        self._objects = objects[4 + 4 * (count + 1) :]
+        self._shared = [_ABSENT] * count
+        self._timezones = {0: timezone.utc}
+
+    def shared(self, index):
+        value = self._shared[index]
+        if value is _ABSENT:
+            value = self._shared[index] = self.value(
+                self._objects, self._offsets[index]
+            )[0]
+        return value
+
+    def datetime(self, micros, offset):
+        if offset == _NAIVE:
+            return _EPOCH + timedelta(microseconds=micros)
+        value = _UTC_EPOCH + timedelta(microseconds=micros)
+        if offset:
+            tz = self._timezones.get(offset)
+            if tz is None:
+                tz = self._timezones[offset] = timezone(timedelta(seconds=offset))
+            value = value.astimezone(tz)
+        return value
+
+    def value(self, buffer, pos):
+        """Decode the value at `pos`, returning (value, position after it)."""
+        tag = buffer[pos]
+        pos += 1
+        if tag == _STR:
+            return self.strings[_U32.unpack_from(buffer, pos)[0]], pos + 4
+        if tag == _NONE:
+            return None, pos
+        if tag == _FALSE or tag == _TRUE:
+            return tag == _TRUE, pos
+        if tag == _INT:
+            return _I64.unpack_from(buffer, pos)[0], pos + 8
+        if tag == _FLOAT:
+            return _F64.unpack_from(buffer, pos)[0], pos + 8
+        if tag == _DICT:
+            count = _U32.unpack_from(buffer, pos)[0]
+            pos += 4
+            result = {}
+            for _ in range(count):
+                key, pos = self.value(buffer, pos)
+                result[key], pos = self.value(buffer, pos)
+            return result, pos
+        if tag == _LIST or tag == _TUPLE:
+            count = _U32.unpack_from(buffer, pos)[0]
+            pos += 4
+            items = []
+            for _ in range(count):
+                item, pos = self.value(buffer, pos)
+                items.append(item)
+            return (items if tag == _LIST else tuple(items)), pos
+        if tag == _REF:
+            return self.shared(_U32.unpack_from(buffer, pos)[0]), pos + 4
+        if tag == _DATETIME_TAG:
+            micros, offset = _DATETIME.unpack_from(buffer, pos)
+            return self.datetime(micros, offset), pos + _DATETIME.size
+        if tag == _BIGINT:
+            size = _U32.unpack_from(buffer, pos)[0]
+            pos += 4
+            data = bytes(buffer[pos : pos + size])
+            return int.from_bytes(data, "little", signed=True), pos + size
+        raise SnapshotError(f"unknown value tag {tag}")
+
+
+class _Column:
+    def __init__(self, decoder, column_type, flags, payload, rows):
+        self.decoder = decoder
+        self.type = column_type
+        self.absent = None
+        if flags & _HAS_ABSENT:
+            self.absent = payload[:rows]
+            payload = payload[rows + (-rows % 8) :]
+        self.nulls = None
+        if flags & _HAS_NULLS:
+            self.nulls = payload[:rows]
+            payload = payload[rows + (-rows % 8) :]
+        self.rows = rows
+        if column_type == _CONST:
+            self.const = decoder.value(payload, 0)[0]
+        elif column_type == _FLOAT64:
+            self.values = _array(payload, "d", rows)
+        elif column_type == _INT64:
+            self.values = _array(payload, "q", rows)
+        elif column_type == _STRING:
+            self.values = _array(payload, "I", rows)
+        elif column_type == _BOOL:
+            self.values = payload[:rows]
+        elif column_type == _DATETIMES:
+            self.values = _array(payload, "q", rows)
+            self.offsets = _array(payload[8 * rows :], "i", rows)
+        elif column_type == _GENERIC:
+            self.values = _array(payload, "I", rows + 1)
+            self.blob = payload[4 * (rows + 1) :]
+        else:
+            raise SnapshotError(f"unknown column type {column_type}")
+
+    def get(self, row):
+        if self.absent is not None and self.absent[row]:
+            return _ABSENT
+        if self.nulls is not None and self.nulls[row]:
+            return None
+        column_type = self.type
+        if column_type == _CONST:
+            return self.const
+        if column_type == _STRING:
+            return self.decoder.strings[self.values[row]]
+        if column_type == _FLOAT64 or column_type == _INT64:
+            return self.values[row]
+        if column_type == _BOOL:
+            return bool(self.values[row])
+        if column_type == _DATETIMES:
+            micros = self.values[row]
+            if micros == _INT64_MIN:
+                return None
+            return self.decoder.datetime(micros, self.offsets[row])
+        return self.decoder.value(self.blob, self.values[row])[0]
+
+    def tolist(self):
+        column_type = self.type
+        rows = self.rows
+        if column_type == _CONST:
+            values = [self.const] * rows
+        elif column_type == _STRING:
+            strings = self.decoder.strings.all()
+            values = (
+                list(itemgetter(*self.values)(strings))
+                if rows > 1
+                else [strings[index] for index in self.values]
+            )
+        elif column_type == _FLOAT64 or column_type == _INT64:
+            values = self.values.tolist()
+        elif column_type == _BOOL:
+            values = list(map(bool, self.values))
+        elif column_type == _DATETIMES:
+            to_datetime = self.decoder.datetime
+            values = [
+                None if micros == _INT64_MIN else to_datetime(micros, offset)
+                for micros, offset in zip(self.values.tolist(), self.offsets.tolist())
+            ]
+        else:
+            values = [self.get(row) for row in range(rows)]
+            return values
+        if self.nulls is not None:
+            values = [
+                None if null else value for null, value in zip(self.nulls, values)
+            ]
+        if self.absent is not None:
+            values = [
+                _ABSENT if absent else value
+                for absent, value in zip(self.absent, values)
+            ]
+        return values
+
+
+class SegmentTable:
+    """
+    Read-only sequence over the segments of a snapshot loaded with
+    ``lazy=True``. Each item is decoded into a fresh segment dict when it
+    is accessed; `tolist` decodes them all column by column.
+    """
+
+    def __init__(self, keys, columns, rows):
+        self._keys = keys
+        self._columns = columns
+        self._rows = rows
+
+    def __len__(self):
+        return self._rows
+
+    def __getitem__(self, index):
+        if isinstance(index, slice):
+            return [self[row] for row in range(*index.indices(self._rows))]
+        if index < 0:
+            index += self._rows
+        if not 0 <= index < self._rows:
+            raise IndexError("segment index out of range")
+        segment = {}
+        for key, column in zip(self._keys, self._columns):
+            value = column.get(index)
+            if value is not _ABSENT:
+                segment[key] = value
+        return segment
+
+    def __iter__(self):
+        for row in range(self._rows):
+            yield self[row]
+
+    def tolist(self):
+        """Return every segment as a list of dicts."""
+        keys = self._keys
+        if not any(column.absent is not None for column in self._columns):
+            # Copy a template holding the constant columns and fill in the
+            # rest; constant values are scalars or containers that were
+            # shared by every segment to begin with
+            template = dict.fromkeys(keys)
+            varying_keys = []
+            varying = []
+            for key, column in zip(keys, self._columns):
+                if column.type == _CONST and column.nulls is None:
+                    template[key] = column.const
+                else:
+                    varying_keys.append(key)
+                    varying.append(column.tolist())
+            copy = template.copy
+            if not varying:
+                return [copy() for _ in range(self._rows)]
+            segments = []
+            append = segments.append
+            for row in zip(*varying):
+                segment = copy()
+                segment.update(zip(varying_keys, row))
+                append(segment)
+            return segments
+        columns = [column.tolist() for column in self._columns]
+        return [
+            {key: value for key, value in zip(keys, row) if value is not _ABSENT}
+            for row in zip(*columns)
+        ]
+
+
+def _sections(data):
+    buffer = memoryview(data)
+    if buffer.ndim != 1 or buffer.itemsize != 1:
+        buffer = buffer.cast("B")
+    try:
+        magic, version, kind, count = _HEADER.unpack_from(buffer)
+    except struct.error:
+        raise SnapshotError("data is too short for a snapshot") from None
+    if magic != MAGIC:
+        raise SnapshotError("data is not an openm3u8 snapshot")
+    if version != FORMAT_VERSION:
+        raise SnapshotError(f"unsupported snapshot format version {version}")
+    sections = {}
+    for number in range(count):
+        tag, offset, length = _SECTION.unpack_from(
+            buffer, _HEADER.size + number * _SECTION.size
+        )
+        if offset + length > len(buffer):
+            raise SnapshotError("snapshot is truncated")
+        sections[tag] = buffer[offset : offset + length]
+    return kind, sections
+
+
+def _segment_table(decoder, section):
+    rows, count = _U32_PAIR.unpack_from(section)
+    keys = []
+    columns = []
+    for number in range(count):
+        key, column_type, flags, _, offset, length = _COLUMN.unpack_from(
+            section, 8 + number * _COLUMN.size
+        )
+        keys.append(decoder.strings[key])
+        columns.append(
+            _Column(
+                decoder, column_type, flags, section[offset : offset + length], rows
+            )
+        )
+    return SegmentTable(keys, columns, rows)
+
+
+def restore(data, lazy=False):
+    """
+    Return (kind, parse result, meta) for snapshot `data`, whatever its
+    kind. meta holds the base_uri, base_path and fingerprint of a M3U8
+    snapshot and is None otherwise. `lazy` works as for `loadb`.
+    """
+    kind, sections = _sections(data)
+    try:
+        decoder = _Decoder(_Strings(sections[b"STRS"]), sections[b"OBJS"])
+        result = decoder.value(sections[b"HEAD"], 0)[0]
+        segments = _segment_table(decoder, sections[b"SEGS"])
+        meta = decoder.value(sections[b"META"], 0)[0] if b"META" in sections else None
+    except (KeyError, IndexError, struct.error) as error:
+        raise SnapshotError(f"corrupt snapshot: {error!r}") from None
+
+    if "segments" in result:
+        result["segments"] = segments if lazy else segments.tolist()
+    return kind, result, meta
+
+
+def loadb(data, lazy=False):
+    """
+    Restore a snapshot made by `dumpb` from any bytes-like object, returning
+    a `parse` result dict or a `M3U8`, whichever was saved.
+
+    With ``lazy=True`` a parse result's "segments" is a read-only
+    `SegmentTable` that decodes segments as they are accessed, and the
+    snapshot buffer must stay alive and unchanged while it is used. A M3U8
+    is always built in full. Raises SnapshotError for data that is not a
+    snapshot of a supported format version.
+    """
+    kind, result, meta = restore(data, lazy)
+    if kind != KIND_M3U8:
+        return result
+    if isinstance(result.get("segments"), SegmentTable):
+        result["segments"] = result["segments"].tolist()
+    playlist = M3U8.from_data(result, meta["base_path"], meta["base_uri"])
+    playlist.fingerprint = meta["fingerprint"]
+    return playlist
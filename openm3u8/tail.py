@@ -0,0 +1,458 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+"""
+Parse only the live edge of a media playlist.
+
+`parse_tail` finds the last N segments by walking the text backwards, then
+parses the playlist header followed by those segments, with the skipped
+body blanked out so that line numbers stay those of the whole playlist.
+The current key and map they inherit are found with reverse searches. The
+running program date-time is the last EXT-X-PROGRAM-DATE-TIME plus the
+EXTINF and EXT-X-PART durations after it, and an ad break still open
+before the tail is rebuilt from the segment that opened it plus the EXTINF
+durations since. Only those light scans cover the skipped body, so the
+cost grows with N rather than with the DVR window.
+"""
+
+import re
+from collections import Counter
+from datetime import timedelta
+
+from openm3u8 import protocol
+from openm3u8.model import parse
+from openm3u8.parser import cast_date_time
+
+_SEGMENT_TAGS = (protocol.extinf + ":", protocol.ext_x_byterange + ":")
+
+# Tags that belong to the media segment after them rather than the header
+_MEDIA_SEGMENT_TAGS = frozenset(
+    (
+        protocol.extinf,
+        protocol.ext_x_byterange,
+        protocol.ext_x_discontinuity,
+        protocol.ext_x_key,
+        protocol.ext_x_map,
+        protocol.ext_x_program_date_time,
+        protocol.ext_x_daterange,
+        protocol.ext_x_gap,
+        protocol.ext_x_bitrate,
+        protocol.ext_x_part,
+        protocol.ext_x_cue_out,
+        protocol.ext_x_cue_out_cont,
+        protocol.ext_x_cue_in,
+        protocol.ext_x_cue_span,
+        protocol.ext_oatcls_scte35,
+        protocol.ext_x_asset,
+        protocol.ext_x_blackout,
+    )
+)
+
+# Playlist tags, kept even when written among the first segment's tags
+_PLAYLIST_TAGS = frozenset(
+    tag
+    for name, tag in vars(protocol).items()
+    if not name.startswith("_") and tag not in _MEDIA_SEGMENT_TAGS
+)
+
+# Tags that mark a segment as part of an ad break (its "cue_out")
+_CUE_OUT_TAGS = (
+    protocol.ext_x_cue_out,
+    protocol.ext_x_cue_out_cont,
+    protocol.ext_x_cue_span,
+)
+
+# Segment values the parser carries from one segment of a break to the next
+_CUE_STATE = (
+    "scte35",
+    "oatcls_scte35",
+    "scte35_duration",
+    "scte35_elapsedtime",
+    "asset_metadata",
+)
+
+_EXTINF_DURATION = re.compile(r"#EXTINF:([^,\r\n]*)")
+_PART_DURATION = re.compile(r"#EXT-X-PART:(?:[^\r\n]*,)?DURATION=([^,\r\n]*)")
+
+
+def _lines_before(content, end):
+    """Yield (start, stripped line) for each line before `end`, last first."""
+    while end > 0:
+        start = content.rfind("\n", 0, end) + 1
+        yield start, content[start:end].strip()
+        end = start - 1
+
+
+def _lines_after(content, start, end=None):
+    """Yield (start, stripped line) for each line from `start` to `end`."""
+    end = len(content) if end is None else end
+    while start < end:
+        stop = content.find("\n", start, end)
+        if stop == -1:
+            stop = end
+        yield start, content[start:stop].strip()
+        start = stop + 1
+
+
+def _last_tag_line(content, tag, end):
+    """Return (start, line) of the last `tag` line before `end`, or None."""
+    pos = content.rfind("\n" + tag, 0, end)
+    while pos != -1:
+        start = pos + 1
+        stop = content.find("\n", start)
+        line = content[start : stop if stop != -1 else len(content)].strip()
+        if line.partition(":")[0] == tag:
+            return start, line
+        pos = content.rfind("\n" + tag, 0, pos)
+    return None
+
+
+def _first_tag_line(content, tag):
+    pos = content.find(tag + ":")
+    if pos == -1:
+        return None
+    stop = content.find("\n", pos)
+    return pos, content[pos : stop if stop != -1 else len(content)].strip()
+
+
+def _header_end(content):
+    """Return where the tags of the first media segment start."""
+    for line_start, line in _lines_after(content, 0):
+        if line and (line[0] != "#" or line.partition(":")[0] in _MEDIA_SEGMENT_TAGS):
+            return line_start
+    return len(content)
+
+
+def _segment_start(content, pos, floor):
+    """Return where the segment whose tags include the line at `pos` starts."""
+    for line_start, line in _lines_before(content, pos - 1):
+        if line_start < floor:
+            break
+        if line and line[0] != "#":
+            return content.find("\n", line_start) + 1
+    return floor
+
+
+def _previous_segment(content, start, floor):
+    """Return where the segment before the one starting at `start` starts."""
+    uri_start = content.rfind("\n", 0, start - 1) + 1
+    return _segment_start(content, uri_start, floor)
+
+
+def _segment_end(content, pos):
+    """Return where the segment whose tags include the line at `pos` ends."""
+    for line_start, line in _lines_after(content, pos):
+        if line and line[0] != "#":
+            return content.find("\n", line_start) + 1 or len(content)
+    return len(content)
+
+
+def _durations(pattern, content, start, end):
+    # The parser adds one rounded timedelta per segment; live playlists
+    # repeat a handful of durations, so add each of those once per count
+    return sum(
+        (
+            timedelta(seconds=float(value)) * count
+            for value, count in Counter(pattern.findall(content, start, end)).items()
+        ),
+        timedelta(),
+    )
+
+
+def _seconds(content, start, end):
+    """Return the sum of the EXTINF durations between `start` and `end`."""
+    total = 0.0
+    for value in _EXTINF_DURATION.findall(content, start, end):
+        total += float(value)
+    return total
+
+
+def _program_date_time(content, end, floor):
+    """
+    Return the running program date-time at `end`, a segment start: the
+    last EXT-X-PROGRAM-DATE-TIME before it plus the durations of the
+    segments and partial segments after it. None without such a tag.
+    """
+    found = _last_tag_line(content, protocol.ext_x_program_date_time, end)
+    if found is None or found[0] < floor:
+        return None
+    pos, line = found
+    return (
+        cast_date_time(line.split(":", 1)[1])
+        + _durations(
+            _EXTINF_DURATION, content, _segment_start(content, pos, floor), end
+        )
+        + _durations(_PART_DURATION, content, pos, end)
+    )
+
+
+def _continue_program_date_time(data, current):
+    """
+    Date the leading segments and parts of `data`, parsed without the
+    running program date-time, from `current` on, up to the first one with
+    an EXT-X-PROGRAM-DATE-TIME of its own.
+    """
+    segments = data["segments"]
+    dated = 0
+    for segment in segments:
+        dated_parts = True
+        for part in segment.get("parts") or ():
+            if "program_date_time" in part:
+                dated_parts = False
+                break
+            part["program_date_time"] = current
+            current += timedelta(seconds=part["duration"])
+        if not dated_parts or "program_date_time" in segment or "uri" not in segment:
+            break
+        segment["current_program_date_time"] = current
+        current += timedelta(seconds=segment["duration"])
+        dated += 1
+    for ad_break in data["ad_breaks"]:
+        if ad_break["program_date_time"] is None and ad_break["start_segment"] < dated:
+            segment = segments[ad_break["start_segment"]]
+            ad_break["program_date_time"] = segment["current_program_date_time"]
+
+
+def _open_cue_break(content, end, floor):
+    """
+    Return the position of the line that opened the EXT-X-CUE-OUT break
+    still open at `end`, or None: the last EXT-X-CUE-OUT after the last
+    EXT-X-CUE-IN, else the first EXT-X-CUE-OUT-CONT or EXT-X-CUE-SPAN after
+    it (a window that starts mid break).
+    """
+    cue_in = _last_tag_line(content, protocol.ext_x_cue_in, end)
+    if cue_in is not None:
+        floor = max(floor, cue_in[0])
+    cue_out = _last_tag_line(content, protocol.ext_x_cue_out, end)
+    if cue_out is not None and cue_out[0] >= floor:
+        return cue_out[0]
+    found = [
+        pos
+        for pos in (
+            content.find("\n" + tag, max(floor - 1, 0), end)
+            for tag in (protocol.ext_x_cue_out_cont, protocol.ext_x_cue_span)
+        )
+        if pos != -1
+    ]
+    return min(found) + 1 if found else None
+
+
+def _is_cue_out(content, start, end):
+    """Return whether the segment spanning [start, end) is marked as in a break."""
+    return any(
+        line.partition(":")[0] in _CUE_OUT_TAGS
+        for _, line in _lines_after(content, start, end)
+    )
+
+
+def _cue_run_start(content, start, floor):
+    """
+    Return where the run of break segments that ends at `start` starts,
+    which is `start` itself when the segment before it is not in a break.
+    """
+    while start > floor:
+        previous = _previous_segment(content, start, floor)
+        if not _is_cue_out(content, previous, start):
+            break
+        start = previous
+    return start
+
+
+def _carry_cue_state(content, data, start, floor):
+    """
+    Give the leading break segments of `data` the SCTE-35 and asset values
+    the parser carries into them from the break segments just before
+    `start`, by parsing only that run of break segments.
+    """
+    # The break segments take the carried values, and the segment after
+    # them the last ones
+    segments = data["segments"]
+    count = 0
+    while count < len(segments) and "uri" in segments[count]:
+        count += 1
+        if not segments[count - 1]["cue_out"]:
+            break
+    run_start = _cue_run_start(content, start, floor)
+    if run_start == start:
+        return
+
+    run_end = start
+    for _ in range(count):
+        run_end = _segment_end(content, run_end)
+    run = parse(content[run_start:run_end])["segments"]
+    carried = run[len(run) - count :]
+    for segment, run_segment in zip(segments, carried):
+        for name in _CUE_STATE:
+            segment[name] = run_segment.get(name)
+    # Breaks opened in that run were recorded with the segments' values
+    for ad_break in data["ad_breaks"]:
+        index = ad_break["start_segment"]
+        if ad_break["source"] != "cue" or index >= count:
+            continue
+        segment = segments[index]
+        ad_break["scte35"] = segment["scte35"]
+        ad_break["oatcls_scte35"] = segment["oatcls_scte35"]
+        ad_break["asset_metadata"] = segment["asset_metadata"]
+        ad_break["planned_duration"] = _to_float(segment["scte35_duration"])
+        if not segment["cue_out_start"]:
+            ad_break["elapsed_time"] = _to_float(segment["scte35_elapsedtime"])
+
+
+def _to_float(value):
+    try:
+        return float(value)
+    except (TypeError, ValueError):
+        return None
+
+
+def _continue_cue_break(content, data, start, floor):
+    """
+    Prepend to data["ad_breaks"] the EXT-X-CUE-OUT break still open before
+    `start`, extended over the segments of `data` as the parser would, and
+    drop the break the parser opened for its continuation instead.
+    """
+    opener = _open_cue_break(content, start, floor)
+    if opener is None:
+        return
+    # The opening segment, after the break segments whose values it carries
+    segment_start = _segment_start(content, opener, floor)
+    opening = parse(
+        content[
+            _cue_run_start(content, segment_start, floor) : _segment_end(
+                content, opener
+            )
+        ]
+    )
+    index = len(opening["segments"]) - 1
+    ad_break = next(
+        (
+            found
+            for found in opening["ad_breaks"]
+            if found["source"] == "cue" and found["start_segment"] == index
+        ),
+        None,
+    )
+    if ad_break is None:
+        return
+
+    if ad_break["program_date_time"] is None:
+        current = _program_date_time(content, segment_start, floor)
+        if current is not None:
+            for part in opening["segments"][index].get("parts") or ():
+                current += timedelta(seconds=part["duration"])
+        ad_break["program_date_time"] = current
+    ad_break["duration"] = _seconds(content, segment_start, start)
+
+    # The break ends before an EXT-X-CUE-IN segment or a new EXT-X-CUE-OUT
+    end = None
+    for index, segment in enumerate(data["segments"]):
+        if "uri" not in segment:
+            break
+        if segment["cue_in"]:
+            ad_break["complete"] = True
+            break
+        if segment["cue_out_start"]:
+            break
+        end = index
+        ad_break["duration"] += segment["duration"]
+    if end is None:
+        return
+    ad_break["start_segment"] = 0
+    ad_break["end_segment"] = end
+    data["ad_breaks"] = [ad_break] + [
+        found
+        for found in data["ad_breaks"]
+        if found["source"] != "cue" or found["start_segment"] > end
+    ]
+
+
+def parse_tail(content, n, custom_tags_parser=None, custom_tag_handlers=None):
+    """
+    Parse the header and only the last `n` complete segments of a media
+    playlist (plus any trailing partial segment), returning the same dict as
+    `parse` restricted to those segments.
+
+    Only the header and those segments are parsed, so the cost is
+    proportional to `n` rather than to the playlist length; the rest of the
+    playlist is only scanned for the durations after the last
+    EXT-X-PROGRAM-DATE-TIME and the state of a still open ad break.
+    `custom_tags_parser` and `custom_tag_handlers` see the parsed lines
+    with their line numbers in the whole playlist. `media_sequence` and
+    `discontinuity_sequence` are those of the first returned segment.
+    `keys`, `segment_map` and `tiles` only list entries seen in the parsed
+    text. `ad_breaks` keep the duration and start time of a break that
+    began before the tail, with `start_segment` clamped to 0; date-range
+    breaks opened before the tail are not listed. Master playlists, and
+    media playlists with at most `n` segments, are parsed in full.
+    """
+    if n < 1:
+        raise ValueError("n must be at least 1")
+
+    if content.find(protocol.extinf + ":") == -1:
+        return parse(content, False, custom_tags_parser, custom_tag_handlers)
+    header_end = _header_end(content)
+
+    # The tail starts right after the (n + 1)-th segment URI from the end. A
+    # URI line only ends a segment if an EXTINF or BYTERANGE precedes it.
+    start = None
+    segments = 0
+    uri_start = None
+    for line_start, line in _lines_before(content, len(content)):
+        if line_start < header_end:
+            break
+        if line and line[0] != "#":
+            uri_start = line_start
+        elif uri_start is not None and line.startswith(_SEGMENT_TAGS):
+            segments += 1
+            if segments > n:
+                start = content.find("\n", uri_start) + 1
+                break
+            uri_start = None
+    if not start:
+        return parse(content, False, custom_tags_parser, custom_tag_handlers)
+
+    # The skipped body becomes blank lines but for the playlist tags among
+    # the first segment's tags and the last EXT-X-KEY and EXT-X-MAP, which
+    # the tail inherits; those keep their own line numbers
+    kept = [
+        (line_start, line)
+        for line_start, line in _lines_after(
+            content, header_end, _segment_end(content, header_end)
+        )
+        if line.partition(":")[0] in _PLAYLIST_TAGS
+    ]
+    for tag in (protocol.ext_x_key, protocol.ext_x_map):
+        found = _last_tag_line(content, tag, start)
+        if found is not None and found[0] >= header_end:
+            kept.append(found)
+    pieces = [content[:header_end]]
+    pos = header_end
+    for line_start, line in sorted(set(kept)):
+        pieces += ["\n" * content.count("\n", pos, line_start), line]
+        pos = content.find("\n", line_start)
+    pieces += ["\n" * content.count("\n", pos, start), content[start:]]
+
+    data = parse("".join(pieces), False, custom_tags_parser, custom_tag_handlers)
+
+    current = _program_date_time(content, start, header_end)
+    if current is not None:
+        _continue_program_date_time(data, current)
+    _carry_cue_state(content, data, start, header_end)
+    _continue_cue_break(content, data, start, header_end)
+
+    data["media_sequence"] = (data["media_sequence"] or 0) + content.count(
+        protocol.extinf + ":", 0, start
+    )
+    # EXT-X-DISCONTINUITY also prefixes EXT-X-DISCONTINUITY-SEQUENCE
+    discontinuities = content.count(
+        protocol.ext_x_discontinuity, header_end, start
+    ) - content.count(protocol.ext_x_discontinuity_sequence, header_end, start)
+    if discontinuities:
+        data["discontinuity_sequence"] = (
+            data.get("discontinuity_sequence") or 0
+        ) + discontinuities
+    first_pdt = _first_tag_line(content, protocol.ext_x_program_date_time)
+    if first_pdt is not None:
+        data["program_date_time"] = cast_date_time(first_pdt[1].split(":", 1)[1])
+    return data
@@ -8,6 +8,7 @@ expressed declaratively.
 
 import os
 import sys
+import sysconfig
 
 from setuptools import Extension, setup
 
@@ -17,7 +18,13 @@ ext_modules = []
 
 # For a single wheel across CPython minor versions, build against the stable ABI
 # (abi3). Since python_requires is >=3.10, we can target the 3.10 limited API.
-PY_LIMITED_API = 0x030A0000
+# Building on 3.12+ targets the 3.12 limited API instead, which exposes
+# PyObject_Vectorcall for the custom tag callbacks.
+PY_LIMITED_API = 0x030C0000 if sys.version_info >= (3, 12) else 0x030A0000
+
+# Free-threaded builds (3.13t, 3.14t) do not support the limited API, so
+# they get a regular per-version extension instead of an abi3 one.
+FREE_THREADED = bool(sysconfig.get_config_var("Py_GIL_DISABLED"))
 
 # Check if we should build the C extension
 if (
@@ -33,8 +40,10 @@ if (
             "openm3u8._m3u8_parser",
             sources=["openm3u8/_m3u8_parser.c"],
             optional=not is_wheel_build,  # Required for wheels, optional otherwise
-            py_limited_api=True,
-            define_macros=[("Py_LIMITED_API", PY_LIMITED_API)],
+            py_limited_api=not FREE_THREADED,
+            define_macros=(
+                [] if FREE_THREADED else [("Py_LIMITED_API", PY_LIMITED_API)]
+            ),
         )
     )
 
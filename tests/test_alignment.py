@@ -0,0 +1,152 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+from datetime import datetime, timedelta, timezone
+
+import openm3u8 as m3u8
+
+MASTER = """#EXTM3U
+#EXT-X-MEDIA:TYPE=AUDIO,GROUP-ID="aac",NAME="en",URI="audio.m3u8"
+#EXT-X-STREAM-INF:BANDWIDTH=1280000,AUDIO="aac"
+hi.m3u8
+#EXT-X-STREAM-INF:BANDWIDTH=640000,AUDIO="aac"
+lo.m3u8
+#EXT-X-STREAM-INF:BANDWIDTH=320000,AUDIO="aac"
+missing.m3u8
+"""
+
+START = datetime(2026, 1, 1, tzinfo=timezone.utc)
+
+
+def _media(durations, media_sequence=100, discontinuity_at=None, pdt_offset=0.0):
+    lines = [
+        "#EXTM3U",
+        "#EXT-X-TARGETDURATION:6",
+        f"#EXT-X-MEDIA-SEQUENCE:{media_sequence}",
+        "#EXT-X-PROGRAM-DATE-TIME:"
+        + (START + timedelta(seconds=pdt_offset)).isoformat(),
+    ]
+    for msn, duration in enumerate(durations, media_sequence):
+        if msn == discontinuity_at:
+            lines.append("#EXT-X-DISCONTINUITY")
+        lines += [f"#EXTINF:{duration},", f"{msn}.ts"]
+    return "\n".join(lines) + "\n"
+
+
+def _check(renditions, **kwargs):
+    master = m3u8.loads(MASTER, uri="http://example.com/live/master.m3u8")
+    return m3u8.check_alignment(master, renditions, **kwargs)
+
+
+def test_aligned_renditions_pass():
+    report = _check(
+        {
+            "hi.m3u8": _media([6, 6, 6, 6]),
+            "lo.m3u8": m3u8.loads(
+                _media([6, 6, 6, 6, 6], media_sequence=99, pdt_offset=-6)
+            ),
+            "http://example.com/live/missing.m3u8": m3u8.parse(_media([6, 6])),
+            "audio.m3u8": _media([6.016, 5.995, 6.016, 5.995]),
+        }
+    )
+    assert report.reference == "hi.m3u8"
+    assert report.ok, report.deviations
+    assert [rendition.uri for rendition in report.renditions] == [
+        "hi.m3u8",
+        "lo.m3u8",
+        "missing.m3u8",
+        "audio.m3u8",
+    ]
+    assert report.renditions[1][1:4] == (99, 103, None)
+
+
+def test_deviations_are_reported_per_rendition():
+    class FailingClient:
+        def download(self, uri, *args):
+            raise OSError("unreachable: " + uri)
+
+    report = _check(
+        {
+            "hi.m3u8": _media([6, 6, 6, 6], discontinuity_at=102),
+            "lo.m3u8": _media([6, 6.5, 5.5, 6], pdt_offset=0.5),
+            "audio.m3u8": _media([6, 6], media_sequence=200),
+        },
+        http_client=FailingClient(),
+        tolerance=0.2,
+    )
+    assert not report.ok
+    hi, lo, missing, audio = report.renditions
+    assert hi.deviations == []
+    assert [deviation.check for deviation in lo.deviations] == [
+        "boundary",
+        "discontinuity_sequence",
+        "program_date_time",
+    ]
+    boundary, discontinuity, drift = lo.deviations
+    assert boundary[2:5] == (102, 12.0, 12.5)
+    assert discontinuity[2:5] == (102, 1, 0)
+    assert drift.media_sequence == 102
+    assert drift.actual - drift.expected == timedelta(seconds=1)
+    assert drift.reference == "hi.m3u8"
+    assert missing.deviations[0].check == "error"
+    assert (
+        "unreachable: http://example.com/live/missing.m3u8"
+        in missing.deviations[0].actual
+    )
+    assert audio.deviations[0][1:5] == ("media_sequence", None, (100, 103), (200, 201))
+
+
+def test_rendition_reports_are_checked_against_the_reported_playlists():
+    def low_latency(last_part, reports):
+        lines = [
+            "#EXTM3U",
+            "#EXT-X-TARGETDURATION:4",
+            "#EXT-X-PART-INF:PART-TARGET=1",
+            "#EXT-X-MEDIA-SEQUENCE:10",
+            "#EXTINF:4,",
+            "10.ts",
+        ]
+        lines += [
+            f'#EXT-X-PART:DURATION=1,URI="11.{i}.mp4"' for i in range(last_part + 1)
+        ]
+        lines += [
+            f'#EXT-X-RENDITION-REPORT:URI="{uri}",LAST-MSN={msn},LAST-PART={part}'
+            for uri, msn, part in reports
+        ]
+        return "\n".join(lines) + "\n"
+
+    report = _check(
+        {
+            "hi.m3u8": low_latency(2, [("lo.m3u8", 11, 1), ("audio.m3u8", 11, 2)]),
+            "lo.m3u8": low_latency(1, [("hi.m3u8", 11, 2)]),
+            "missing.m3u8": low_latency(2, [("/live/lo.m3u8", 11, 1)]),
+            "audio.m3u8": low_latency(3, [("hi.m3u8", 10, 2)]),
+        }
+    )
+    hi, lo, missing, audio = report.renditions
+    assert (hi.last_msn, hi.last_part) == (11, 2)
+    assert lo.deviations == missing.deviations == []
+    (stale,) = hi.deviations
+    assert stale.check == "rendition_report"
+    assert (stale.expected, stale.actual) == ((11, 3), (11, 2))
+    assert stale.reference == "http://example.com/live/audio.m3u8"
+    assert audio.deviations[0][2:5] == (10, (11, 2), (10, 2))
+
+
+def test_delta_updates_are_numbered_past_skipped_segments():
+    full = _media([6] * 7)
+    # The same window as a delta update skipping 100-103
+    delta = _media([6] * 3, media_sequence=104, pdt_offset=24).replace(
+        "SEQUENCE:104", "SEQUENCE:100\n#EXT-X-SKIP:SKIPPED-SEGMENTS=4"
+    )
+    delta += '#EXT-X-RENDITION-REPORT:URI="hi.m3u8",LAST-MSN=106\n'
+
+    hi = full + '#EXT-X-RENDITION-REPORT:URI="lo.m3u8",LAST-MSN=106\n'
+
+    report = _check(
+        {"hi.m3u8": hi, "lo.m3u8": delta, "missing.m3u8": full, "audio.m3u8": full}
+    )
+    lo = report.renditions[1]
+    assert (lo.media_sequence, lo.last_msn) == (104, 106)
+    assert report.ok, report.deviations
@@ -0,0 +1,114 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+import playlists
+import pytest
+
+import openm3u8 as m3u8
+from openm3u8.byterange import ByteRange, parse_byterange
+
+IMPLICIT_OFFSETS_PLAYLIST = """#EXTM3U
+#EXT-X-VERSION:7
+#EXT-X-TARGETDURATION:4
+#EXT-X-MAP:URI="main.mp4",BYTERANGE="700@0"
+#EXTINF:4,
+#EXT-X-BYTERANGE:1000@700
+main.mp4
+#EXTINF:4,
+#EXT-X-BYTERANGE:2000
+main.mp4
+#EXTINF:4,
+#EXT-X-BYTERANGE:500@0
+other.mp4
+#EXTINF:4,
+#EXT-X-BYTERANGE:1500
+main.mp4
+#EXT-X-ENDLIST
+"""
+
+
+def test_parse_byterange():
+    assert parse_byterange("76242@0") == (76242, 0)
+    assert parse_byterange('"812"') == (812, None)
+    with pytest.raises(ValueError):
+        parse_byterange("12@x")
+
+
+def test_resolve_byteranges_fills_implicit_offsets_per_resource():
+    playlist = m3u8.loads(
+        IMPLICIT_OFFSETS_PLAYLIST, uri="https://cdn.example.com/vod/index.m3u8"
+    )
+    main = "https://cdn.example.com/vod/main.mp4"
+    other = "https://cdn.example.com/vod/other.mp4"
+
+    resolved = playlist.byteranges()
+
+    assert [item for item, _ in resolved] == [
+        playlist.segment_map[0],
+        *playlist.segments,
+    ]
+    assert [byterange for _, byterange in resolved] == [
+        (main, 0, 700),
+        (main, 700, 1700),
+        (main, 1700, 3700),
+        (other, 0, 500),
+        (main, 3700, 5200),
+    ]
+    assert resolved[1][1].header == "bytes=700-1699"
+    assert resolved[1][1].length == 1000
+
+
+def test_resolve_byteranges_parts_and_preload_hint():
+    playlist = m3u8.loads(playlists.LOW_LATENCY_WITH_PRELOAD_AND_BYTERANGES_PLAYLIST)
+    ranges = [byterange for _, byterange in playlist.byteranges()]
+
+    assert ranges[-4:] == [
+        ("fs271.mp4", 0, 20000),
+        ("fs271.mp4", 20000, 43000),
+        ("fs271.mp4", 43000, 61000),
+        ("fs271.mp4", 61000, 81000),
+    ]
+
+
+def test_resolve_byteranges_requires_a_previous_sub_range():
+    playlist = m3u8.loads("#EXTM3U\n#EXTINF:4,\n#EXT-X-BYTERANGE:10\na.mp4\n")
+    with pytest.raises(ValueError):
+        playlist.byteranges()
+
+
+def test_plan_range_requests_merges_contiguous_ranges_under_cap():
+    ranges = [
+        ByteRange("a.mp4", 0, 100),
+        ByteRange("a.mp4", 100, 250),
+        ByteRange("a.mp4", 260, 300),
+        ByteRange("b.mp4", 300, 400),
+        ByteRange("a.mp4", 300, 500),
+        ByteRange("a.mp4", 500, 900),
+    ]
+
+    requests = m3u8.plan_range_requests(ranges, max_bytes=300)
+    assert [(r.uri, r.start, r.end) for r in requests] == [
+        ("a.mp4", 0, 250),
+        ("a.mp4", 260, 300),
+        ("b.mp4", 300, 400),
+        ("a.mp4", 300, 500),
+        ("a.mp4", 500, 900),
+    ]
+    assert requests[0].ranges == ranges[:2]
+    assert requests[0].header == "bytes=0-249"
+
+    requests = m3u8.plan_range_requests(ranges, max_bytes=300, max_gap=10)
+    assert [(r.start, r.end) for r in requests[:2]] == [(0, 300), (300, 400)]
+    assert [s for _, s in requests[0].slices()] == [
+        slice(0, 100),
+        slice(100, 250),
+        slice(260, 300),
+    ]
+
+
+def test_plan_range_requests_keeps_open_ended_ranges_apart():
+    ranges = [ByteRange("a.mp4", 0, 100), ByteRange("a.mp4", 100, None)]
+    requests = m3u8.plan_range_requests(ranges, max_bytes=1000)
+    assert len(requests) == 2
+    assert requests[1].header == "bytes=100-"
@@ -1,3 +1,5 @@
+import math
+
 import pytest
 
 import openm3u8.parser as py_parser
@@ -105,3 +107,298 @@ def test_strict_version_matching_line_numbers_preserve_blank_lines():
 
     assert py_errors[0].line_number == c_errors[0].line_number
     assert py_errors[0].line == c_errors[0].line
+
+
+def test_stats_disabled_by_default_and_records_per_tag():
+    content = "\n".join(
+        [
+            "#EXTM3U",
+            "#EXT-X-TARGETDURATION:8",
+            "#EXT-X-UNKNOWN-VENDOR-TAG:1",
+            "#EXTINF:8,",
+            "a.ts",
+            "#EXTINF:8,",
+            "b.ts",
+            "#EXT-X-ENDLIST",
+        ]
+    )
+    c_parser.reset_stats()
+    c_parser.parse(content)
+    assert c_parser.get_stats()["tags"]["#EXTINF"]["calls"] == 0
+
+    previous = c_parser.set_stats_enabled(True)
+    try:
+        assert previous is False
+        c_parser.parse(content, custom_tags_parser=lambda *args: False)
+        stats = c_parser.get_stats()
+    finally:
+        c_parser.set_stats_enabled(previous)
+        c_parser.reset_stats()
+
+    assert stats["enabled"] is True
+    assert stats["parse"]["calls"] == 1
+    assert stats["setup"]["calls"] == 1
+    assert stats["strict_validation"]["calls"] == 0
+    assert stats["custom_tags_parser"]["calls"] == 6
+    assert stats["uri_lines"]["calls"] == 2
+    assert stats["unknown_tags"]["calls"] == 1
+    assert stats["tags"]["#EXTINF"]["calls"] == 2
+    assert stats["tags"]["#EXT-X-TARGETDURATION"]["calls"] == 1
+    assert stats["tags"]["#EXT-X-ENDLIST"]["calls"] == 1
+    assert stats["parse"]["ns"] >= stats["tags"]["#EXTINF"]["ns"]
+
+
+def test_custom_tag_handlers_only_see_matching_lines():
+    content = "\n".join(
+        [
+            "#EXTM3U",
+            "#EXT-X-TARGETDURATION:8",
+            "#EXT-X-VENDOR-AD:id=1",
+            "#EXT-X-VENDOR-ADVANCED:2",
+            "#EXTINF:8,",
+            "a.ts",
+            "#EXT-X-VENDOR-CHAPTER:intro",
+            "#EXT-X-VENDOR-AD",
+            "#EXTINF:8,",
+            "b.ts",
+        ]
+    )
+
+    def results(parser):
+        seen = []
+
+        def ad(line, lineno, data, state):
+            seen.append((lineno, line))
+            data.setdefault("ads", []).append(line.partition(":")[2])
+            return True
+
+        def chapter(line, lineno, data, state):
+            seen.append((lineno, line))
+            state["segment"] = {"chapter": line.split(":", 1)[1]}
+            return True
+
+        data = parser.parse(
+            content,
+            custom_tag_handlers={
+                "#EXT-X-VENDOR-AD": ad,
+                "#EXT-X-VENDOR-CHAPTER": chapter,
+            },
+        )
+        return data, seen
+
+    c_data, c_seen = results(c_parser)
+    py_data, py_seen = results(py_parser)
+    assert c_data == py_data
+    assert c_seen == py_seen
+    # Handlers claim their tag only, not longer tags sharing its prefix
+    assert c_seen == [
+        (3, "#EXT-X-VENDOR-AD:id=1"),
+        (7, "#EXT-X-VENDOR-CHAPTER:intro"),
+        (8, "#EXT-X-VENDOR-AD"),
+    ]
+    assert c_data["ads"] == ["id=1", ""]
+    assert c_data["segments"][1]["chapter"] == "intro"
+
+
+def test_custom_tag_handlers_fall_through_and_validate():
+    content = "#EXTM3U\n#EXT-X-TARGETDURATION:8\n#EXTINF:8,\na.ts\n"
+    handlers = {"#EXT-X-TARGETDURATION": lambda *args: False}
+    assert c_parser.parse(content, custom_tag_handlers=handlers) == py_parser.parse(
+        content, custom_tag_handlers=handlers
+    )
+    assert c_parser.parse(content, custom_tag_handlers=handlers)["targetduration"] == 8
+
+    for parser in (c_parser, py_parser):
+        with pytest.raises(TypeError):
+            parser.parse(content, custom_tag_handlers={"#EXT-X-FOO": None})
+        with pytest.raises(TypeError):
+            parser.parse(content, custom_tag_handlers={1: lambda *args: True})
+
+
+def test_custom_tag_schema_matches_python():
+    from openm3u8.parser import (
+        ATTR_BANDWIDTH,
+        ATTR_FLOAT,
+        ATTR_INT,
+        ATTR_QUOTED_STRING,
+        ATTR_STRING,
+        CustomTagSchema,
+    )
+
+    for name in ("STRING", "INT", "FLOAT", "QUOTED_STRING", "BANDWIDTH"):
+        assert getattr(c_parser, "ATTR_" + name) == locals()["ATTR_" + name]
+
+    content = "\n".join(
+        [
+            "#EXTM3U",
+            "#EXT-X-TARGETDURATION:8",
+            '#EXT-X-VENDOR-INFO:CHANNEL="news",REGION=eu',
+            '#EXT-X-AD:ID="a1",DURATION=15.5,SLOT=2,RATE="1e6",MODE=live,X=y',
+            "#EXT-X-AD:ID=\"a2\",DURATION=bad,SLOT='3'",
+            "#EXTINF:8,",
+            "a.ts",
+            "#EXT-X-AD-MARKER",
+            "#EXT-X-ADVANCED:SLOT=4",
+            "#EXTINF:8,",
+            "b.ts",
+        ]
+    )
+    handlers = {
+        "#EXT-X-VENDOR-INFO": CustomTagSchema(
+            {"CHANNEL": ATTR_QUOTED_STRING}, destination="playlist", name="vendor"
+        ),
+        "#EXT-X-AD": CustomTagSchema(
+            {
+                "ID": ATTR_QUOTED_STRING,
+                "DURATION": ATTR_FLOAT,
+                "SLOT": ATTR_INT,
+                "RATE": ATTR_BANDWIDTH,
+                "MODE": ATTR_STRING,
+            },
+            multiple=True,
+        ),
+    }
+    c_data = c_parser.parse(content, custom_tag_handlers=handlers)
+    py_data = py_parser.parse(content, custom_tag_handlers=handlers)
+    assert c_data == py_data
+
+    assert c_data["vendor"] == {"channel": "news", "region": "eu"}
+    assert c_data["segments"][0]["custom_parser_values"]["ext_x_ad"] == [
+        {
+            "id": "a1",
+            "duration": 15.5,
+            "slot": 2,
+            "rate": 1000000,
+            "mode": "live",
+            "x": "y",
+        },
+        {"id": "a2", "duration": "bad", "slot": 3},
+    ]
+    # The #EXT-X-AD schema does not capture longer tags sharing its prefix
+    assert "custom_parser_values" not in c_data["segments"][1]
+
+
+@pytest.mark.parametrize(
+    "value", ["nan", "inf", "-Infinity", "1e400", "  2.5", "2.5  ", '" 2.5 "', "1_0"]
+)
+def test_custom_tag_schema_numeric_edge_values_match_python(value):
+    from openm3u8.parser import ATTR_BANDWIDTH, ATTR_FLOAT, ATTR_INT, CustomTagSchema
+
+    schema = CustomTagSchema(
+        {"A": ATTR_INT, "B": ATTR_FLOAT, "C": ATTR_BANDWIDTH}, destination="playlist"
+    )
+    content = f"#EXTM3U\n#EXT-X-T:A={value},B={value},C={value}\n"
+    handlers = {"#EXT-X-T": schema}
+    c_data = c_parser.parse(content, custom_tag_handlers=handlers)["ext_x_t"]
+    py_data = py_parser.parse(content, custom_tag_handlers=handlers)["ext_x_t"]
+    assert c_data == py_data
+    # Non-finite values are kept as written rather than raising
+    for number in c_data.values():
+        assert isinstance(number, str) or math.isfinite(number)
+
+
+def test_concurrent_parses_share_stats_consistently():
+    import threading
+
+    content = "#EXTM3U\n#EXT-X-TARGETDURATION:8\n#EXTINF:8,\na.ts\n"
+    expected = c_parser.parse(content)
+    results = []
+
+    def worker():
+        for _ in range(200):
+            results.append(c_parser.parse(content) == expected)
+
+    c_parser.reset_stats()
+    previous = c_parser.set_stats_enabled(True)
+    try:
+        threads = [threading.Thread(target=worker) for _ in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        stats = c_parser.get_stats()
+    finally:
+        c_parser.set_stats_enabled(previous)
+        c_parser.reset_stats()
+
+    assert results == [True] * 800
+    assert stats["parse"]["calls"] == 800
+    assert stats["tags"]["#EXTINF"]["calls"] == 800
+
+
+def test_parse_in_isolated_subinterpreter():
+    import os
+
+    _interpreters = pytest.importorskip("_interpreters")
+    root = os.path.dirname(os.path.dirname(os.path.abspath(c_parser.__file__)))
+    code = "\n".join(
+        [
+            "import sys",
+            f"sys.path.insert(0, {root!r})",
+            "import openm3u8._m3u8_parser as p",
+            "data = p.parse('#EXTM3U\\n#EXTINF:1,\\na.ts')",
+            "assert data['segments'][0]['uri'] == 'a.ts'",
+            "try:",
+            "    p.parse('#EXTM3U\\n#EXT-X-BOGUS', strict=True)",
+            "except p.ParseError:",
+            "    pass",
+            "else:",
+            "    raise AssertionError('ParseError not raised')",
+        ]
+    )
+    # Own GIL: fails to import if the module is not per-interpreter safe
+    interp = _interpreters.create(_interpreters.new_config("isolated"))
+    try:
+        run = getattr(_interpreters, "exec", None) or _interpreters.run_string
+        assert run(interp, code) is None
+    finally:
+        _interpreters.destroy(interp)
+
+
+def test_field_projection_matches_full_parse():
+    import playlists
+
+    def project(data, field):
+        if field.startswith("segments."):
+            key = field.split(".", 1)[1]
+            return [s.get(key) for s in data["segments"] if "uri" in s]
+        return data.get(field)
+
+    contents = [
+        value
+        for name, value in vars(playlists).items()
+        if name.isupper() and isinstance(value, str) and "#EXTM3U" in value
+    ]
+    for content in contents:
+        try:
+            full = py_parser.parse(content)
+        except ValueError:
+            continue
+        if c_parser.parse(content) != full:
+            continue  # covered by the known-divergence tests
+        for field in py_parser.PROJECTION_FIELDS:
+            c_data = c_parser.parse(content, fields=[field])
+            assert c_data == py_parser.parse(content, fields=[field]), field
+            assert project(c_data, field) == project(full, field), field
+            assert len(c_data["segments"]) == len(full["segments"]), field
+
+    with pytest.raises(ValueError):
+        c_parser.parse("#EXTM3U", fields=["segments.nope"])
+    with pytest.raises(TypeError):
+        c_parser.parse("#EXTM3U", fields="segments")
+
+
+def test_parse_until_matches_python():
+    import playlists
+
+    for name, content in vars(playlists).items():
+        if not (name.isupper() and isinstance(content, str) and "#EXTM3U" in content):
+            continue
+        try:
+            if c_parser.parse(content) != py_parser.parse(content):
+                continue  # covered by the known-divergence tests
+        except ValueError:
+            continue
+        for until in ("header", "first_segment"):
+            expected = py_parser.parse(content, until=until)
+            assert c_parser.parse(content, until=until) == expected, (name, until)
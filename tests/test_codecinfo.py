@@ -0,0 +1,73 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+import playlists
+import pytest
+
+import openm3u8 as m3u8
+from openm3u8.codecinfo import parse_codec
+
+
+@pytest.mark.parametrize(
+    "codec,expected",
+    [
+        ("avc1.64001f", ("avc", "video", 100, "High", 3.1, None, None)),
+        ("avc1.66.30", ("avc", "video", 66, "Baseline", 3.0, None, None)),
+        ("hvc1.2.4.L123.B0", ("hevc", "video", 2, "Main 10", 4.1, "Main", None)),
+        ("hev1.A1.60.H153.90", ("hevc", "video", 1, "Main", 5.1, "High", None)),
+        ("dvh1.05.06", ("dolby-vision", "video", 5, "Profile 5", 6, None, None)),
+        ("av01.0.13M.10", ("av1", "video", 0, "Main", 5.1, "Main", 10)),
+        ("vp09.02.31.10", ("vp9", "video", 2, "Profile 2", 3.1, None, 10)),
+        ("mp4a.40.2", ("aac", "audio", 2, "AAC-LC", None, None, None)),
+        ("mp4a.40.34", ("mp3", "audio", 34, "MP3", None, None, None)),
+        ("mp4a.A6", ("ec-3", "audio", None, None, None, None, None)),
+        ("ec-3", ("ec-3", "audio", None, None, None, None, None)),
+        ("stpp.ttml.im1t", ("ttml", "subtitles", None, None, None, None, None)),
+        ("xyz1.1", ("xyz1", None, None, None, None, None, None)),
+        ("avc1.zz", ("avc", "video", None, None, None, None, None)),
+    ],
+)
+def test_parse_codec(codec, expected):
+    parsed = parse_codec(codec)
+    assert parsed.codec == codec
+    assert (
+        parsed.family,
+        parsed.kind,
+        parsed.profile,
+        parsed.profile_name,
+        parsed.level,
+        parsed.tier,
+        parsed.bit_depth,
+    ) == expected
+
+
+def test_parse_codecs_splits_and_memoizes():
+    codecs = m3u8.parse_codecs('"avc1.4d001f, mp4a.40.29"')
+    assert [codec.sample_entry for codec in codecs] == ["avc1", "mp4a"]
+    assert codecs[1].channels == 2
+    assert m3u8.parse_codecs('"avc1.4d001f, mp4a.40.29"') is codecs
+    assert m3u8.parse_codecs(None) == ()
+
+
+def test_parse_channels():
+    assert m3u8.parse_channels("2") == (2, (), ())
+    assert m3u8.parse_channels("16/JOC") == (16, ("JOC",), ())
+    assert m3u8.parse_channels("6/-/BINAURAL,DOWNMIX").rendering == (
+        "BINAURAL",
+        "DOWNMIX",
+    )
+    assert m3u8.parse_channels(None) is None
+
+
+def test_model_exposes_parsed_codecs_and_channels():
+    obj = m3u8.loads(playlists.VARIANT_PLAYLIST_WITH_IFRAME_PLAYLISTS)
+    codecs = obj.playlists[0].stream_info.parsed_codecs
+    assert [(codec.family, codec.profile_name) for codec in codecs] == [
+        ("avc", "Main"),
+        ("aac", "HE-AAC"),
+    ]
+    assert obj.iframe_playlists[0].iframe_stream_info.parsed_codecs[0].family == "avc"
+
+    media = m3u8.Media(type="AUDIO", group_id="a", name="Atmos", channels="16/JOC")
+    assert media.parsed_channels.count == 16
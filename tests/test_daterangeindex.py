@@ -0,0 +1,116 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+import random
+from datetime import datetime, timedelta, timezone
+
+import playlists
+
+import openm3u8 as m3u8
+
+EPOCH = datetime(2026, 1, 1, tzinfo=timezone.utc)
+
+
+def _playlist(*tags):
+    lines = ["#EXTM3U", "#EXT-X-TARGETDURATION:10"]
+    for tag in tags:
+        lines += ["#EXT-X-DATERANGE:" + tag, "#EXTINF:10,", "seg.ts"]
+    return m3u8.loads("\n".join(lines))
+
+
+def _ids(dateranges):
+    return [daterange.id for daterange in dateranges]
+
+
+def test_active_and_overlapping_queries():
+    obj = _playlist(
+        'ID="a",CLASS="chapter",START-DATE="2026-01-01T00:00:00Z",DURATION=60',
+        'ID="b",CLASS="ad",START-DATE="2026-01-01T00:00:30Z",'
+        'END-DATE="2026-01-01T00:01:30Z"',
+        'ID="c",CLASS="chapter",START-DATE="2026-01-01T00:01:00Z",END-ON-NEXT=YES',
+        'ID="d",CLASS="chapter",START-DATE="2026-01-01T00:02:00Z"',
+        'ID="e",START-DATE="2026-01-01T00:00:45Z",DURATION=0',
+    )
+    index = obj.daterange_index
+    assert obj.daterange_index is index
+    assert len(index) == 5
+
+    assert _ids(index.active_at("2026-01-01T00:00:45Z")) == ["a", "b", "e"]
+    assert _ids(index.active_at(EPOCH + timedelta(seconds=60))) == ["b", "c"]
+    assert _ids(index.active_at(EPOCH + timedelta(hours=1))) == ["d"]
+    assert index.active_at(EPOCH - timedelta(seconds=1)) == []
+
+    # c ends where d, the next chapter, starts; d is open-ended
+    assert _ids(index.active_at(EPOCH + timedelta(seconds=119))) == ["c"]
+    assert _ids(index.active_at(EPOCH + timedelta(seconds=90), "chapter")) == ["c"]
+    assert _ids(index.by_class("chapter")) == ["a", "c", "d"]
+    assert index.by_class("missing") == []
+
+    start, end = EPOCH + timedelta(seconds=40), EPOCH + timedelta(seconds=61)
+    assert _ids(index.overlapping(start, end)) == ["a", "b", "e", "c"]
+    assert _ids(index.overlapping(start, end, class_="ad")) == ["b"]
+    assert index.overlapping(EPOCH - timedelta(seconds=10), EPOCH) == []
+
+
+def test_tags_sharing_an_id_merge_across_reloads():
+    obj = m3u8.loads(playlists.DATERANGE_SCTE35_OUT_AND_IN_PLAYLIST)
+    index = obj.daterange_index
+    (daterange,) = index
+    assert daterange.start_date == "2014-03-05T11:15:00Z"
+    assert (daterange.planned_duration, daterange.duration) == (59.993, 59.993)
+    assert daterange.scte35_out and daterange.scte35_in
+    assert "splice-6FFFFFF0" in index
+    assert _ids(index.active_at("2014-03-05T11:15:59Z")) == ["splice-6FFFFFF0"]
+    assert index.active_at("2014-03-05T11:16:00Z") == []
+
+    reload = _playlist(
+        'ID="splice-6FFFFFF0",END-DATE="2014-03-05T11:16:30Z"',
+        'ID="next",START-DATE="2014-03-05T11:16:30Z",DURATION=10',
+    )
+    index.update(reload)
+    assert len(index) == 2
+    assert index.by_id("splice-6FFFFFF0").end_date == "2014-03-05T11:16:30Z"
+    assert _ids(index.active_at("2014-03-05T11:16:00Z")) == ["splice-6FFFFFF0"]
+    # The playlist's own objects are left as parsed
+    assert obj.segments[0].dateranges[0].end_date is None
+
+
+def test_dateranges_in_partial_segments_are_indexed():
+    obj = m3u8.loads(playlists.DATERANGE_IN_PART_PLAYLIST)
+    assert _ids(obj.daterange_index.active_at("2020-03-10T07:49:00Z")) == ["test_id"]
+    assert m3u8.loads(playlists.SIMPLE_PLAYLIST).daterange_index.active_at(EPOCH) == []
+
+
+def test_queries_match_a_linear_scan():
+    rng = random.Random(7)
+    tags = []
+    spans = {}
+    for number in range(300):
+        start = rng.randrange(0, 3600)
+        duration = rng.choice([0, 5, 30, 600])
+        tags.append(
+            f'ID="{number}",START-DATE="{(EPOCH + timedelta(seconds=start)).isoformat()}",'
+            f"DURATION={duration}"
+        )
+        spans[str(number)] = (start, start + duration)
+    index = _playlist(*tags).daterange_index
+
+    for _ in range(200):
+        first = rng.randrange(-10, 3700)
+        last = first + rng.randrange(1, 120)
+        expected = {
+            daterange_id
+            for daterange_id, (start, end) in spans.items()
+            if start < last and (end > first or start == end >= first)
+        }
+        found = index.overlapping(
+            EPOCH + timedelta(seconds=first), EPOCH + timedelta(seconds=last)
+        )
+        assert set(_ids(found)) == expected
+        active = {
+            daterange_id
+            for daterange_id, (start, end) in spans.items()
+            if start <= first < end or start == end == first
+        }
+        assert set(_ids(index.active_at(EPOCH + timedelta(seconds=first)))) == active
@@ -0,0 +1,67 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+import pytest
+
+import openm3u8 as m3u8
+from openm3u8 import delta
+
+
+def _playlist(media_sequence, uris, targetduration=6):
+    lines = [
+        "#EXTM3U",
+        f"#EXT-X-TARGETDURATION:{targetduration}",
+        f"#EXT-X-MEDIA-SEQUENCE:{media_sequence}",
+    ]
+    for uri in uris:
+        lines += ["#EXTINF:6,", uri]
+    return "\n".join(lines)
+
+
+def test_diff_aligns_segments_by_media_sequence():
+    old = m3u8.parse(_playlist(10, ["10.ts", "11.ts", "12.ts"]))
+    new = m3u8.parse(_playlist(11, ["11.ts", "12-fixed.ts", "13.ts", "14.ts"], 8))
+
+    result = m3u8.diff(old, new)
+    assert [s["uri"] for s in result["removed"]] == ["10.ts"]
+    assert [s["uri"] for s in result["added"]] == ["13.ts", "14.ts"]
+    assert [(c["media_sequence"], c["fields"]) for c in result["changed"]] == [
+        (12, ("uri",))
+    ]
+    assert result["header"] == {"media_sequence": (10, 11), "targetduration": (6, 8)}
+
+
+def test_diff_accepts_models_and_reports_no_changes():
+    playlist = m3u8.loads(_playlist(5, ["5.ts", "6.ts"]))
+    result = m3u8.diff(playlist, m3u8.loads(_playlist(5, ["5.ts", "6.ts"])))
+    assert result == {"removed": [], "added": [], "changed": [], "header": {}}
+
+
+@pytest.mark.parametrize("old_msn,new_msn", [(0, 0), (3, 5), (5, 3), (0, 100)])
+def test_native_segment_diff_matches_python(old_msn, new_msn):
+    old = [{"uri": f"{i}.ts"} for i in range(old_msn, old_msn + 6)]
+    new = [{"uri": f"{i}.ts"} for i in range(new_msn, new_msn + 6)]
+    new[len(new) // 2]["uri"] = "patched.ts"
+    expected = delta._diff_segments(old, new, old_msn, new_msn)
+    assert delta.diff_segments(old, new, old_msn, new_msn) == expected
+
+
+def test_diff_numbers_delta_update_segments_past_skipped_ones():
+    old = m3u8.parse(_playlist(10, [f"{i}.ts" for i in range(10, 16)]))
+    new = m3u8.parse(
+        _playlist(10, ["14.ts", "15.ts", "16.ts"]).replace(
+            "#EXTINF", "#EXT-X-SKIP:SKIPPED-SEGMENTS=4\n#EXTINF", 1
+        )
+    )
+
+    result = m3u8.diff(old, new)
+    assert result["removed"] == []
+    assert [s["uri"] for s in result["added"]] == ["16.ts"]
+    assert result["changed"] == []
+
+    new["media_sequence"] = 12
+    new["skip"]["skipped_segments"] = 2
+    result = m3u8.diff(old, new)
+    assert [s["uri"] for s in result["removed"]] == ["10.ts", "11.ts"]
+    assert [s["uri"] for s in result["added"]] == ["16.ts"]
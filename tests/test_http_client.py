@@ -1,9 +1,10 @@
 import gzip
+import io
 import unittest
 from http.client import HTTPResponse
 from unittest.mock import Mock, patch
 
-from openm3u8.httpclient import DefaultHTTPClient
+from openm3u8.httpclient import DefaultHTTPClient, _gunzip
 
 
 class MockHeaders:
@@ -61,3 +62,41 @@ class TestDefaultHTTPClient(unittest.TestCase):
 
         self.assertEqual(content, "playlist proxied content")
         self.assertEqual(base_uri, "http://example.com/")
+
+    @patch("urllib.request.OpenerDirector.open")
+    def test_stream_gzipped_content_in_chunks(self, mock_open):
+        client = DefaultHTTPClient()
+        original_content = "#EXTM3U\n" + "#EXTINF:4,\nsegment-é.ts\n" * 2000
+        body = io.BytesIO(gzip.compress(original_content.encode("utf-8")))
+        mock_response = Mock(spec=HTTPResponse)
+        mock_response.read.side_effect = body.read
+        mock_response.info.return_value = {"Content-Encoding": "gzip"}
+        mock_response.geturl.return_value = "http://example.com/index.m3u8"
+        mock_response.headers = MockHeaders("utf-8")
+        mock_open.return_value = mock_response
+
+        chunks, base_uri = client.stream(
+            "http://example.com/index.m3u8", chunk_size=256
+        )
+        chunks = list(chunks)
+
+        self.assertEqual("".join(chunks), original_content)
+        self.assertTrue(all(len(chunk) <= 256 for chunk in chunks))
+        self.assertEqual(base_uri, "http://example.com/")
+        mock_response.close.assert_called_once()
+
+    def test_stream_rejects_truncated_gzip(self):
+        body = gzip.compress(b"#EXTM3U\n" * 1000)[:-12]
+        with self.assertRaises(EOFError):
+            list(_gunzip([body[:50], body[50:]]))
+
+    def test_gunzip_raises_like_gzip_decompress(self):
+        body = gzip.compress(b"#EXTM3U\n" * 1000)
+        with self.assertRaisesRegex(gzip.BadGzipFile, "Not a gzipped file"):
+            list(_gunzip([body[:50], body[50:] + b"garbage"]))
+        with self.assertRaisesRegex(gzip.BadGzipFile, "CRC check failed"):
+            list(_gunzip([body[:-8] + bytes(4) + body[-4:]]))
+        # Zero padding after a member is allowed
+        self.assertEqual(
+            b"".join(_gunzip([body, bytes(8)])), gzip.decompress(body + bytes(8))
+        )
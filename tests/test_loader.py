@@ -122,6 +122,43 @@ def test_load_should_create_object_from_uri_with_relative_segments():
     assert expected_ts6_abspath == obj.segments[5].absolute_uri
 
 
+def test_loads_reuses_previous_object_when_content_is_unchanged():
+    first = m3u8.loads(playlists.SIMPLE_PLAYLIST)
+    assert first.fingerprint == m3u8.fingerprint(playlists.SIMPLE_PLAYLIST)
+    second = m3u8.loads(playlists.SIMPLE_PLAYLIST + "\n\n", previous=first)
+    assert second is first
+
+    changed = m3u8.loads(playlists.SIMPLE_PLAYLIST_MESSY, previous=second)
+    assert changed is not second
+    moved = m3u8.loads(
+        playlists.SIMPLE_PLAYLIST, uri="http://example.com/a/", previous=second
+    )
+    assert moved is not second
+
+    # Different parse options parse again
+    projected = m3u8.loads(
+        playlists.SIMPLE_PLAYLIST, fields=["segments.uri"], previous=first
+    )
+    assert projected is not first
+    assert (
+        m3u8.loads(
+            playlists.SIMPLE_PLAYLIST, fields=("segments.uri",), previous=projected
+        )
+        is projected
+    )
+    handled = m3u8.loads(
+        playlists.SIMPLE_PLAYLIST,
+        custom_tag_handlers={"#EXT-X-AD": lambda *args: True},
+        previous=first,
+    )
+    assert handled is not first
+
+
+def test_load_from_file_reuses_previous_object():
+    first = m3u8.load(playlists.SIMPLE_PLAYLIST_FILENAME)
+    assert m3u8.load(playlists.SIMPLE_PLAYLIST_FILENAME, previous=first) is first
+
+
 def test_there_should_not_be_absolute_uris_with_loads():
     with open(playlists.RELATIVE_PLAYLIST_FILENAME) as f:
         content = f.read()
@@ -136,6 +173,72 @@ def test_absolute_uri_should_handle_empty_base_uri_path():
     assert "http://example.com/key.bin" == key.absolute_uri
 
 
+@pytest.mark.parametrize(
+    "uri",
+    ["seg.ts", "a/b.ts?x=1#t", "../up.ts", "a//b.ts", "x;p", "q?", "/abs", "//h/p"],
+)
+@pytest.mark.parametrize(
+    "base_uri",
+    ["http://example.com", "http://example.com/a/b/index.m3u8?t=1", "/tmp/dir/"],
+)
+def test_absolute_uri_matches_urljoin(base_uri, uri):
+    segment = m3u8.Segment(uri=uri, base_uri=base_uri)
+    assert segment.absolute_uri == urllib.parse.urljoin(base_uri, uri)
+
+
+def test_absolute_uris_are_resolved_in_bulk_and_follow_changes():
+    obj = m3u8.loads(
+        playlists.PLAYLIST_WITH_ENCRYPTED_SEGMENTS_AND_IV,
+        uri="https://cdn.example.com/live/index.m3u8",
+    )
+    resolved = {id(item): uri for item, uri in obj.absolute_uris()}
+    assert [resolved[id(segment)] for segment in obj.segments] == [
+        segment.absolute_uri for segment in obj.segments
+    ]
+    assert resolved[id(obj.keys[0])] == obj.keys[0].absolute_uri
+
+    segment = obj.segments[0]
+    assert (
+        obj.segments.absolute_uris()[0]
+        == "https://cdn.example.com/hls/streamNum82400.ts"
+    )
+    segment.uri = "renamed.ts"
+    assert segment.absolute_uri == "https://cdn.example.com/live/renamed.ts"
+    obj.base_uri = "https://other.example.com/"
+    assert obj.segments.absolute_uris()[0] == "https://other.example.com/renamed.ts"
+
+
+def test_load_can_parse_while_streaming():
+    class StreamingClient:
+        def stream(self, uri, timeout=None, headers={}, verify_ssl=True):
+            content = playlists.PLAYLIST_WITH_ENCRYPTED_SEGMENTS_AND_IV
+            chunks = (content[i : i + 10] for i in range(0, len(content), 10))
+            return chunks, "https://cdn.example.com/live/"
+
+    uri = "https://cdn.example.com/live/index.m3u8"
+    obj = m3u8.load(uri, http_client=StreamingClient(), stream=True)
+    expected = m3u8.loads(playlists.PLAYLIST_WITH_ENCRYPTED_SEGMENTS_AND_IV, uri=uri)
+    assert obj.dumps() == expected.dumps()
+    assert obj.segments[0].absolute_uri == expected.segments[0].absolute_uri
+
+    with pytest.raises(ValueError):
+        m3u8.load(uri, http_client=StreamingClient(), stream=True, previous=obj)
+
+
+def test_load_streams_files_and_warns_when_client_cannot_stream():
+    obj = m3u8.load(playlists.SIMPLE_PLAYLIST_FILENAME, stream=True)
+    assert obj.dumps() == m3u8.load(playlists.SIMPLE_PLAYLIST_FILENAME).dumps()
+
+    class DownloadingClient:
+        def download(self, uri, timeout=None, headers={}, verify_ssl=True):
+            return playlists.SIMPLE_PLAYLIST, "https://cdn.example.com/live/"
+
+    uri = "https://cdn.example.com/live/index.m3u8"
+    with pytest.warns(RuntimeWarning, match="no stream method"):
+        obj = m3u8.load(uri, http_client=DownloadingClient(), stream=True)
+    assert obj.dumps() == m3u8.loads(playlists.SIMPLE_PLAYLIST).dumps()
+
+
 def test_presence_of_base_uri_if_provided_when_loading_from_string():
     with open(playlists.RELATIVE_PLAYLIST_FILENAME) as f:
         content = f.read()
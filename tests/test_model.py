@@ -23,6 +23,7 @@ from openm3u8.model import (
     PreloadHint,
     RenditionReport,
     Segment,
+    SegmentList,
     SessionData,
     denormalize_attribute,
     find_key,
@@ -297,6 +298,77 @@ def test_segment_cue_out_no_duration():
     assert obj.segments[2].cue_in is True
 
 
+def test_ad_breaks_from_cue_tags():
+    obj = m3u8.M3U8(playlists.CUE_OUT_ELEMENTAL_PLAYLIST)
+    (ad_break,) = obj.ad_breaks
+    assert ad_break.source == "cue"
+    assert (ad_break.start_segment, ad_break.end_segment) == (3, 8)
+    assert ad_break.segments == obj.segments[3:9]
+    assert ad_break.planned_duration == 50.0
+    assert ad_break.duration == pytest.approx(50.0)
+    assert ad_break.complete
+    assert ad_break.asset_metadata["caid"] == "12345678"
+    assert ad_break.scte35_section.duration == 50.0
+
+    # Joined mid-break: still open, with the time already spent in it
+    obj = m3u8.M3U8(
+        "#EXTM3U\n#EXT-X-TARGETDURATION:6\n"
+        "#EXT-X-CUE-OUT-CONT:ElapsedTime=12,Duration=30\n#EXTINF:6,\na.ts\n"
+        "#EXT-X-CUE-OUT-CONT:ElapsedTime=18,Duration=30\n#EXTINF:6,\nb.ts\n"
+    )
+    (ad_break,) = obj.ad_breaks
+    assert (ad_break.start_segment, ad_break.end_segment) == (0, 1)
+    assert (ad_break.elapsed_time, ad_break.planned_duration) == (12.0, 30.0)
+    assert ad_break.duration == 12.0
+    assert not ad_break.complete
+
+
+def test_ad_breaks_from_dateranges():
+    obj = m3u8.M3U8(playlists.DATERANGE_SCTE35_OUT_AND_IN_PLAYLIST)
+    (ad_break,) = obj.ad_breaks
+    assert (ad_break.source, ad_break.id) == ("daterange", "splice-6FFFFFF0")
+    assert (ad_break.start_segment, ad_break.end_segment) == (0, 5)
+    assert ad_break.planned_duration == 59.993
+    assert ad_break.program_date_time == obj.segments[0].current_program_date_time
+    assert ad_break.scte35_in.startswith("0xFC002A")
+    assert ad_break.complete
+
+    assert m3u8.M3U8(playlists.SIMPLE_PLAYLIST).ad_breaks == []
+
+
+def test_ad_breaks_from_repeated_and_combined_dateranges():
+    def playlist(tags):
+        lines = ["#EXTM3U", "#EXT-X-TARGETDURATION:6"]
+        for index in range(6):
+            lines += tags.get(index, [])
+            lines += ["#EXTINF:6,", f"{index}.ts"]
+        return "\n".join(lines)
+
+    # A later tag repeats SCTE35-OUT and adds SCTE35-IN
+    out = 'ID="ad1",START-DATE="2026-01-01T00:00:06Z",SCTE35-OUT=0xFC01'
+    obj = m3u8.M3U8(
+        playlist(
+            {
+                1: ["#EXT-X-DATERANGE:" + out],
+                3: ["#EXT-X-DATERANGE:" + out + ",DURATION=12,SCTE35-IN=0xFC02"],
+            }
+        )
+    )
+    (ad_break,) = obj.ad_breaks
+    assert (ad_break.start_segment, ad_break.end_segment) == (1, 2)
+    assert (ad_break.duration, ad_break.scte35_in) == (12.0, "0xFC02")
+    assert ad_break.complete
+
+    # One tag carrying both
+    obj = m3u8.M3U8(
+        playlist({2: ["#EXT-X-DATERANGE:" + out + ",DURATION=6,SCTE35-IN=0xFC02"]})
+    )
+    (ad_break,) = obj.ad_breaks
+    assert (ad_break.start_segment, ad_break.end_segment) == (2, 2)
+    assert (ad_break.planned_duration, ad_break.duration) == (6.0, 6.0)
+    assert ad_break.complete
+
+
 def test_segment_asset_metadata_dumps():
     obj = m3u8.M3U8(playlists.CUE_OUT_ELEMENTAL_PLAYLIST)
     result = obj.dumps()
@@ -1230,6 +1302,40 @@ def test_m3u8_should_propagate_base_uri_to_session_key():
     assert "/any/key.bin" == obj.session_keys[0].absolute_uri
 
 
+def test_m3u8_rebase_reaches_added_objects_and_keeps_own_overrides():
+    obj = m3u8.M3U8("#EXTM3U\n#EXTINF:6,\na.ts\n#EXTINF:6,\nold/b.ts\n")
+    added = Segment(uri="added.ts", duration=1, base_uri="http://old/")
+    obj.segments.append(added)
+    part = PartialSegment(None, "part.ts", 0.5)
+    obj.segments[0].add_part(part)
+    obj.preload_hint = PreloadHint("PART", None, "hint.ts")
+
+    obj.base_uri = "http://cdn.example.com/"
+    assert added.absolute_uri == "http://cdn.example.com/added.ts"
+    assert part.base_uri == "http://cdn.example.com/"
+    assert obj.preload_hint.base_uri == "http://cdn.example.com/"
+
+    # A base URI set on one object holds until the playlist is re-based
+    obj.segments[1].base_uri = "http://other.example.com/"
+    assert obj.segments[1].absolute_uri == "http://other.example.com/old/b.ts"
+    obj.base_path = "videos"
+    assert [segment.uri for segment in obj.segments] == [
+        "videos/a.ts",
+        "videos/b.ts",
+        "videos/added.ts",
+    ]
+    assert part.uri == "videos/part.ts"
+    assert obj.segments[1].absolute_uri == "http://other.example.com/videos/b.ts"
+    obj.base_uri = "http://next.example.com/"
+    assert obj.segments[1].absolute_uri == "http://next.example.com/videos/b.ts"
+
+    obj.segments = SegmentList([Segment(uri="new.ts", duration=1)])
+    obj.base_path = "moved"
+    assert obj.segments[0].uri == "moved/new.ts"
+    obj.base_uri = "http://last.example.com/"
+    assert obj.segments[0].absolute_uri == "http://last.example.com/moved/new.ts"
+
+
 def test_base_path_with_optional_uri_should_do_nothing():
     media = Media(type="AUDIO", group_id="audio-group", name="English")
     assert media.uri is None
@@ -1489,6 +1595,26 @@ def test_partial_segment_base_path_update():
     assert obj.segments[2].parts[0].base_uri == "http://localhost/base_uri"
 
 
+def test_appended_parts_and_segments_follow_base_path_update():
+    obj = m3u8.M3U8(playlists.LOW_LATENCY_DELTA_UPDATE_PLAYLIST)
+    obj.segments[2].parts.append(
+        m3u8.PartialSegment(base_uri=None, uri="p.ts", duration=1)
+    )
+    parts = obj.segments[1].parts
+    parts += [m3u8.PartialSegment(base_uri=None, uri="q.ts", duration=1)]
+    other = m3u8.M3U8(playlists.SIMPLE_PLAYLIST)
+    other.segments += [m3u8.Segment(uri="s.ts", duration=4)]
+
+    for playlist in (obj, other):
+        playlist.base_uri = "http://x/y/"
+        playlist.base_path = "newpath"
+
+    appended = (obj.segments[2].parts[-1], parts[-1], other.segments[-1])
+    for item in appended:
+        assert item.uri.startswith("newpath/")
+        assert item.base_uri == "http://x/y/"
+
+
 def test_add_preload_hint():
     obj = PreloadHint("PART", "", "filePart273.4.ts", 0)
 
@@ -1788,3 +1914,30 @@ def mock_parser_data(m3u8_obj, data):
     data.setdefault("segments", [])
     m3u8_obj.data = data
     m3u8_obj._initialize_attributes()
+
+
+def test_segment_list_time_and_media_sequence_lookups():
+    obj = m3u8.M3U8(playlists.DISCONTINUITY_PLAYLIST_WITH_PROGRAM_DATE_TIME)
+    segments = obj.segments
+
+    assert segments.at_time(0).uri == "g_50116.ts"
+    assert segments.at_time(16.5).uri == "g_50121.ts"
+    assert segments.at_time(24) is None
+    assert segments.by_media_sequence(50120).uri == "g_50120.ts"
+    assert segments.by_media_sequence(1) is None
+    assert [s.uri for s in segments.between(5, 9)] == ["g_50117.ts", "g_50118.ts"]
+
+    utc = datetime.timezone.utc
+    at = segments.at_program_date_time
+    assert (
+        at(datetime.datetime(2014, 8, 13, 13, 36, 40, tzinfo=utc)).uri == "g_50118.ts"
+    )
+    # The discontinuity leaves a wall-clock gap between 13:36:48 and 13:36:55
+    assert at(datetime.datetime(2014, 8, 13, 13, 36, 50, tzinfo=utc)) is None
+    assert (
+        at(datetime.datetime(2014, 8, 13, 13, 36, 56, tzinfo=utc)).uri == "g_50121.ts"
+    )
+
+    # Mutating the list rebuilds the index
+    del segments[0]
+    assert segments.at_time(0).uri == "g_50117.ts"
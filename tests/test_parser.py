@@ -938,3 +938,157 @@ def test_media_with_stable_rendition_id():
 def test_req_video_layout():
     data = m3u8.parse(playlists.VARIANT_PLAYLIST_WITH_REQ_VIDEO_LAYOUT)
     assert data["playlists"][0]["stream_info"]["req_video_layout"] == '"CH-STEREO"'
+
+
+def test_simple_playlist_with_custom_tag_handlers():
+    def get_movie(line, lineno, data, state):
+        data["movie"] = line.split(":", 1)[1].strip()
+        return True
+
+    data = m3u8.parse(
+        playlists.SIMPLE_PLAYLIST_WITH_CUSTOM_TAGS,
+        custom_tag_handlers={"#EXT-X-MOVIE": get_movie},
+    )
+    assert data["movie"] == "million dollar baby"
+    assert 5220 == data["targetduration"]
+    assert [5220] == [c["duration"] for c in data["segments"]]
+
+
+def test_custom_tag_schema_stores_typed_attributes():
+    content = "\n".join(
+        [
+            "#EXTM3U",
+            "#EXT-X-TARGETDURATION:8",
+            '#EXT-X-ASSET-INFO:ID="movie-1",YEAR=2004,RATING=8.1',
+            "#EXTINF:8,",
+            "a.ts",
+        ]
+    )
+    schema = m3u8.CustomTagSchema(
+        {
+            "ID": m3u8.ATTR_QUOTED_STRING,
+            "YEAR": m3u8.ATTR_INT,
+            "RATING": m3u8.ATTR_FLOAT,
+        },
+        destination="playlist",
+        name="asset",
+    )
+    data = m3u8.parse(content, custom_tag_handlers={"#EXT-X-ASSET-INFO": schema})
+    assert data["asset"] == {"id": "movie-1", "year": 2004, "rating": 8.1}
+    assert [8] == [c["duration"] for c in data["segments"]]
+
+    with pytest.raises(ValueError):
+        m3u8.CustomTagSchema({"ID": m3u8.ATTR_INT}, destination="nowhere")
+
+
+def test_attribute_name_cache_is_bounded(monkeypatch):
+    from openm3u8 import parser
+
+    monkeypatch.setattr(parser, "_NORMALIZED_ATTRIBUTES", {})
+    monkeypatch.setattr(parser, "_NORMALIZED_ATTRIBUTES_MAX", 4)
+    attributes = ",".join(f"X-ATTR-{i}={i}" for i in range(10))
+    data = parser.parse(f"#EXTM3U\n#EXT-X-START:{attributes}\n")
+    assert data["start"]["x_attr_9"] == "9"
+    assert len(parser._NORMALIZED_ATTRIBUTES) <= 4
+
+
+def test_field_projection_skips_unrequested_tags():
+    content = playlists.CUE_OUT_PLAYLIST
+    data = m3u8.parse(
+        content, fields={"segments.uri", "segments.duration", "media_sequence"}
+    )
+    full = m3u8.parse(content)
+    assert data["media_sequence"] == full["media_sequence"]
+    assert [s["uri"] for s in data["segments"]] == [s["uri"] for s in full["segments"]]
+    assert any(s["cue_out"] for s in full["segments"])
+    assert not any(s["cue_out"] for s in data["segments"])
+    assert "targetduration" not in data
+
+    # A group name selects every field below it
+    data = m3u8.parse(content, fields=["segments"])
+    assert data["segments"] == full["segments"]
+
+    obj = m3u8.loads(content, fields=["segments.uri"])
+    assert len(obj.segments) == len(full["segments"])
+
+    with pytest.raises(ValueError):
+        m3u8.parse(content, fields=["segment.uri"])
+
+
+def test_field_projection_keeps_trailing_partial_segment():
+    content = playlists.LOW_LATENCY_PART_PLAYLIST
+    full = m3u8.parse(content)
+    assert "uri" not in full["segments"][-1]
+
+    data = m3u8.parse(content, fields={"segments.uri"})
+    assert len(data["segments"]) == len(full["segments"])
+    assert data["segments"][-1] == {}
+
+
+def test_parse_until_stops_at_first_segment():
+    content = playlists.SIMPLE_PLAYLIST_WITH_VERY_SHORT_DURATION
+    full = m3u8.parse(content)
+
+    header = m3u8.parse_header(content)
+    assert header["segments"] == []
+    assert header["targetduration"] == full["targetduration"]
+    assert header["is_variant"] is False
+
+    first = m3u8.parse(content, until="first_segment")
+    assert first["segments"] == full["segments"][:1]
+
+    # Variant URIs do not end the header
+    master = m3u8.parse_header(playlists.VARIANT_PLAYLIST)
+    assert master == m3u8.parse(playlists.VARIANT_PLAYLIST)
+
+    with pytest.raises(ValueError):
+        m3u8.parse(content, until="footer")
+
+
+@pytest.mark.parametrize("size", [1, 5, 64])
+def test_playlist_parser_matches_parse_for_any_chunking(size):
+    content = "\n\n" + playlists.PLAYLIST_WITH_ENCRYPTED_SEGMENTS_AND_IV.replace(
+        "\n", "\r\n"
+    )
+    parser = m3u8.PlaylistParser()
+    for start in range(0, len(content), size):
+        parser.feed(content[start : start + size])
+    assert parser.close() == m3u8.parse(content)
+
+    parser = m3u8.PlaylistParser(until="header")
+    done = [parser.feed(content[start : start + size]) for start in range(0, 400, size)]
+    assert done[-1] is True
+    assert parser.close() == m3u8.parse_header(content)
+
+
+def test_playlist_parser_reports_line_numbers_across_chunks():
+    parser = m3u8.PlaylistParser(strict=True)
+    parser.feed("\n#EXTM3U\n#EXTINF:10,\nseg.ts\n#EXT-X-")
+    parser.feed("UNKNOWN\n")
+    with pytest.raises(ParseError) as e:
+        parser.close()
+    assert e.value.lineno == 4
+
+    parser = m3u8.PlaylistParser()
+    parser.feed("#EXTM3U\n#EXTINF:10,\nfir")
+    assert parser.data["segments"] == []
+    parser.feed("st.ts\n#EXTINF:10,\nsecond.ts")
+    assert [s["uri"] for s in parser.data["segments"]] == ["first.ts"]
+    assert [s["uri"] for s in parser.close()["segments"]] == ["first.ts", "second.ts"]
+
+
+def test_fingerprint_ignores_layout_and_listed_lines():
+    content = playlists.SIMPLE_PLAYLIST_WITH_PROGRAM_DATE_TIME
+    reformatted = "\r\n".join("  " + line for line in content.splitlines()) + "\n\n"
+    assert m3u8.fingerprint(reformatted) == m3u8.fingerprint(content)
+
+    shifted = content.replace("2014-08-13T13:36:33", "2014-08-13T13:36:34")
+    assert m3u8.fingerprint(shifted) != m3u8.fingerprint(content)
+    ignore = ["#EXT-X-PROGRAM-DATE-TIME"]
+    assert m3u8.fingerprint(shifted, ignore) == m3u8.fingerprint(content, ignore)
+
+    previous = m3u8.parse_if_changed(content)
+    assert m3u8.parse_if_changed(reformatted, previous) is previous
+    fingerprint, data = m3u8.parse_if_changed(shifted, previous)
+    assert data is not previous[1]
+    assert fingerprint == m3u8.fingerprint(shifted)
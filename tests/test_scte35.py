@@ -0,0 +1,157 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+import random
+
+import playlists
+import pytest
+
+import openm3u8 as m3u8
+from openm3u8 import scte35
+
+# SCTE 35 sample messages: time_signal with a placement opportunity
+# segmentation descriptor, and splice_insert out with an avail descriptor
+TIME_SIGNAL = (
+    "/DA0AAAAAAAA///wBQb+cr0AUAAeAhxDVUVJSAAAjn/PAAGlmbAICAAAAAAsoKGKNAIAmsnRfg=="
+)
+SPLICE_INSERT = "/DAvAAAAAAAA///wFAVIAACPf+/+c2nALv4AUsz1AAAAAAAKAAhDVUVJAAABNWLbowo="
+
+
+def test_decode_time_signal_with_segmentation_descriptor():
+    section = m3u8.decode_scte35(TIME_SIGNAL, verify_crc=True)
+    assert section.crc_valid
+    assert section.splice_command == scte35.TimeSignal(pts_time=0x072BD0050)
+    assert section.pts_time == 0x072BD0050
+    assert section.duration == 307.0
+
+    (descriptor,) = section.segmentation_descriptors
+    assert descriptor.segmentation_event_id == 0x4800008E
+    assert descriptor.segmentation_type == "Provider Placement Opportunity Start"
+    assert not descriptor.delivery_not_restricted_flag
+    assert descriptor.device_restrictions == 3
+    assert descriptor.segmentation_upid_type == 0x08
+    assert descriptor.upid == "000000002ca0a18a"
+    assert (descriptor.segment_num, descriptor.segments_expected) == (2, 0)
+
+
+def test_decode_splice_insert():
+    section = m3u8.decode_scte35(SPLICE_INSERT)
+    command = section.splice_command
+    assert isinstance(command, scte35.SpliceInsert)
+    assert command.splice_event_id == 0x4800008F
+    assert command.out_of_network_indicator and command.auto_return
+    assert command.break_duration == 0x0052CCF5
+    assert section.splice_time == pytest.approx(0x07369C02E / 90000)
+    assert section.descriptors == [scte35.AvailDescriptor(provider_avail_id=0x135)]
+
+
+def test_encode_round_trips_and_builds_sections():
+    for payload in (TIME_SIGNAL, SPLICE_INSERT):
+        section = m3u8.decode_scte35(payload)
+        assert section.to_base64() == payload
+        assert m3u8.decode_scte35(section.to_hex()) == section
+
+    section = m3u8.SpliceInfoSection(
+        splice_command=scte35.TimeSignal(pts_time=900000),
+        descriptors=[
+            scte35.SegmentationDescriptor(
+                segmentation_event_id=1,
+                segmentation_duration_flag=True,
+                segmentation_duration=30 * 90000,
+                segmentation_upid_type=0x0D,
+                segmentation_upid=b"\x03\x04ABCD\x0e\x02xy",
+                segmentation_type_id=0x36,
+                sub_segment_num=1,
+                sub_segments_expected=2,
+            ),
+            scte35.SpliceDescriptor(tag=0xF0, identifier=1, data=b"private"),
+        ],
+    )
+    decoded = m3u8.decode_scte35(m3u8.encode_scte35(section), verify_crc=True)
+    assert decoded.splice_command_type == scte35.TIME_SIGNAL
+    assert decoded.descriptors == section.descriptors
+    assert decoded.duration == 30.0
+    assert decoded.descriptors[0].upid == [(0x03, "ABCD"), (0x0E, "xy")]
+
+
+@pytest.mark.parametrize(
+    "payload,message",
+    [
+        ("/DA0AAAAAAAA", "truncated"),
+        ("0xFD0011", "table_id 0xFD"),
+        ("not base64!", "not a base64 or hex"),
+        (TIME_SIGNAL[:-4] + "AAA=", "CRC-32"),
+    ],
+)
+def test_decode_rejects_malformed_payloads(payload, message):
+    with pytest.raises(ValueError, match=message):
+        m3u8.decode_scte35(payload, verify_crc=True)
+
+
+def test_c_and_python_decoders_agree():
+    payloads = [TIME_SIGNAL, SPLICE_INSERT]
+    payloads += [payload[:length] for payload in payloads for length in (20, 40)]
+    for payload in payloads:
+        data = scte35.to_bytes(payload)
+        results = []
+        for decode in (scte35._decode_section, scte35.decode_section):
+            try:
+                results.append(decode(data))
+            except ValueError as error:
+                results.append(str(error))
+        assert results[0] == results[1]
+
+
+def test_c_and_python_decoders_agree_on_mutated_payloads():
+    # Flip, overwrite, drop and insert bytes of the samples, seeded so that
+    # a failure reproduces
+    rng = random.Random(35)
+    samples = [scte35.to_bytes(payload) for payload in (TIME_SIGNAL, SPLICE_INSERT)]
+    for _ in range(5000):
+        data = bytearray(rng.choice(samples))
+        for _ in range(rng.randint(1, 4)):
+            position = rng.randrange(len(data))
+            mutation = rng.randrange(4)
+            if mutation == 0:
+                data[position] ^= 1 << rng.randrange(8)
+            elif mutation == 1:
+                data[position] = rng.randrange(256)
+            elif mutation == 2:
+                del data[max(position, 1) :]
+            else:
+                data.insert(position, rng.randrange(256))
+        data = bytes(data)
+        results = []
+        for decode in (scte35._decode_section, scte35.decode_section):
+            try:
+                results.append(decode(data))
+            except ValueError as error:
+                results.append(str(error))
+        assert results[0] == results[1], data.hex()
+
+
+def test_segments_and_dateranges_decode_lazily():
+    obj = m3u8.loads(playlists.CUE_OUT_ELEMENTAL_PLAYLIST)
+    segment = obj.segments[4]
+    section = segment.scte35_section
+    assert segment.scte35_section is section
+    assert section.duration == 50.0
+    assert segment.oatcls_scte35_section == section
+    assert obj.segments[0].scte35_section is None
+
+    section.splice_command.break_duration = 60 * 90000
+    segment.scte35_section = section
+    assert m3u8.decode_scte35(segment.scte35).duration == 60.0
+
+    obj = m3u8.loads(playlists.DATERANGE_SCTE35_OUT_AND_IN_PLAYLIST)
+    daterange = obj.segments[0].dateranges[0]
+    # The RFC 8216 example sections are a byte short of their section_length
+    with pytest.raises(ValueError, match="truncated"):
+        daterange.scte35_out_section
+
+    daterange.scte35_out_section = m3u8.decode_scte35(SPLICE_INSERT)
+    assert daterange.scte35_out.startswith("0xFC302F")
+    assert daterange.scte35_out_section.splice_command.splice_event_id == 0x4800008F
+    assert "SCTE35-OUT=0xFC302F" in daterange.dumps()
+    assert daterange.scte35_cmd_section is None
@@ -0,0 +1,126 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+import multiprocessing
+import os
+import threading
+
+import playlists
+import pytest
+
+import openm3u8 as m3u8
+from openm3u8 import sharedcache
+from openm3u8.snapshot import SegmentTable
+
+
+@pytest.fixture
+def cache():
+    writer = m3u8.SharedPlaylistCache(f"om3u8_test_{os.getpid()}", create=True)
+    yield writer
+    writer.unlink()
+    writer.close()
+
+
+def _read_first_uri(name, queue):
+    with m3u8.SharedPlaylistCache(name) as reader:
+        view = reader.get("live")
+        queue.put((view["targetduration"], view.segments[0]["uri"]))
+
+
+def test_shared_cache_views_published_playlists(cache):
+    playlist = m3u8.loads(
+        playlists.PLAYLIST_WITH_ENCRYPTED_SEGMENTS_AND_IV,
+        uri="https://cdn.example.com/live/index.m3u8",
+    )
+    assert cache.put("live", playlist) == 1
+
+    with m3u8.SharedPlaylistCache(cache.name) as reader:
+        view = reader.get("live")
+        assert reader.get("live") is view
+        assert reader.get("vod") is None
+        assert "live" in reader
+        assert reader.keys() == ["live"]
+
+        assert view["targetduration"] == playlist.target_duration
+        assert isinstance(view.segments, SegmentTable)
+        assert view.segments[1]["uri"] == playlist.segments[1].uri
+        restored = view.m3u8()
+        assert restored.dumps() == playlist.dumps()
+        assert restored.base_uri == "https://cdn.example.com/live/"
+
+
+def test_shared_cache_replaces_entries_atomically(cache):
+    cache.put("live", m3u8.parse(playlists.SIMPLE_PLAYLIST))
+    with m3u8.SharedPlaylistCache(cache.name) as reader:
+        old = reader.get("live")
+        assert cache.put("live", m3u8.parse(playlists.SLIDING_WINDOW_PLAYLIST)) == 2
+
+        new = reader.get("live")
+        assert new.generation == 2
+        assert len(new.segments) == 3
+        # The replaced block stays mapped while a view of it is alive
+        assert old.segments[0]["uri"] == "http://media.example.com/entire.ts"
+
+        cache.delete("live")
+        assert reader.get("live") is None
+        assert reader.keys() == []
+
+
+def test_shared_cache_is_read_from_other_processes(cache):
+    cache.put("live", m3u8.parse(playlists.SLIDING_WINDOW_PLAYLIST))
+    context = multiprocessing.get_context("spawn")
+    queue = context.Queue()
+    process = context.Process(target=_read_first_uri, args=(cache.name, queue))
+    process.start()
+    assert queue.get(timeout=30) == (
+        8,
+        "https://priv.example.com/fileSequence2680.ts",
+    )
+    process.join()
+
+
+def test_shared_cache_has_a_single_writer(cache):
+    with m3u8.SharedPlaylistCache(cache.name) as reader:
+        with pytest.raises(PermissionError):
+            reader.put("live", m3u8.parse(playlists.SIMPLE_PLAYLIST))
+    with pytest.raises(ValueError):
+        cache.put("x" * 300, m3u8.parse(playlists.SIMPLE_PLAYLIST))
+
+
+def test_shared_cache_readers_wait_for_writes_in_progress(cache, monkeypatch):
+    cache.put("live", m3u8.parse(playlists.SIMPLE_PLAYLIST))
+    header = cache._blocks["live"].buf
+    # Hide the block header, as if the writer's stores were not visible yet
+    header[:8] = bytes(8)
+
+    with m3u8.SharedPlaylistCache(cache.name) as reader:
+        monkeypatch.setattr(sharedcache, "_RETRY_TIMEOUT", 0.05)
+        with pytest.raises(TimeoutError):
+            reader.get("live")
+
+        monkeypatch.setattr(sharedcache, "_RETRY_TIMEOUT", 5.0)
+        finish = threading.Timer(0.05, header.__setitem__, (0, 1))
+        finish.start()
+        try:
+            assert reader.get("live").generation == 1
+        finally:
+            finish.join()
+
+
+def test_shared_cache_views_unmap_their_block_when_released(cache):
+    cache.put("live", m3u8.parse(playlists.SIMPLE_PLAYLIST))
+    with m3u8.SharedPlaylistCache(cache.name) as reader:
+        view = reader.get("live")
+        segments = view.segments
+        cache.put("live", m3u8.parse(playlists.SLIDING_WINDOW_PLAYLIST))
+        assert reader.get("live").generation == 2
+
+        # The table still reads the block, which is closed once it goes
+        del view
+        assert segments[0]["uri"] == "http://media.example.com/entire.ts"
+        del segments
+        latest = reader.get("live")
+        latest.release()
+        assert sharedcache._unclosed == []
+        assert reader.get("live") is not latest
@@ -0,0 +1,87 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+import datetime
+
+import playlists
+import pytest
+
+import openm3u8 as m3u8
+from openm3u8.snapshot import SegmentTable
+
+SNAPSHOT_PLAYLISTS = [
+    playlists.SIMPLE_PLAYLIST,
+    playlists.VARIANT_PLAYLIST_WITH_IFRAME_PLAYLISTS,
+    playlists.PLAYLIST_WITH_ENCRYPTED_SEGMENTS_AND_IV,
+    playlists.DISCONTINUITY_PLAYLIST_WITH_PROGRAM_DATE_TIME,
+    playlists.LOW_LATENCY_WITH_PRELOAD_AND_BYTERANGES_PLAYLIST,
+    playlists.DATERANGE_SCTE35_OUT_AND_IN_PLAYLIST,
+]
+
+
+@pytest.mark.parametrize("content", SNAPSHOT_PLAYLISTS)
+def test_snapshot_round_trips_parse_result(content):
+    data = m3u8.parse(content)
+    snapshot = m3u8.dumpb(data)
+
+    assert m3u8.loadb(snapshot) == data
+    assert list(m3u8.loadb(snapshot)) == list(data)
+    lazy = m3u8.loadb(memoryview(snapshot), lazy=True)
+    assert list(lazy["segments"]) == data["segments"]
+
+
+def test_snapshot_shares_repeated_values_and_keeps_timezones():
+    data = m3u8.parse(playlists.PLAYLIST_WITH_ENCRYPTED_SEGMENTS_AND_IV)
+    restored = m3u8.loadb(m3u8.dumpb(data))
+    segments = restored["segments"]
+    assert segments[0]["key"] is segments[1]["key"]
+    assert segments[0] is not segments[1]
+
+    data = m3u8.parse(playlists.DISCONTINUITY_PLAYLIST_WITH_PROGRAM_DATE_TIME)
+    restored = m3u8.loadb(m3u8.dumpb(data))
+    first = restored["segments"][0]["program_date_time"]
+    assert first == data["segments"][0]["program_date_time"]
+    assert first.utcoffset() == datetime.timedelta(0)
+
+
+def test_lazy_snapshot_decodes_segments_on_access():
+    data = m3u8.parse(playlists.SLIDING_WINDOW_PLAYLIST)
+    restored = m3u8.loadb(m3u8.dumpb(data), lazy=True)
+    segments = restored["segments"]
+
+    assert isinstance(segments, SegmentTable)
+    assert len(segments) == len(data["segments"])
+    assert segments[-1] == data["segments"][-1]
+    assert segments[1:] == data["segments"][1:]
+    assert segments.tolist() == data["segments"]
+    with pytest.raises(IndexError):
+        segments[len(segments)]
+
+
+def test_snapshot_restores_m3u8_with_base_uri_and_fingerprint():
+    with open(playlists.RELATIVE_PLAYLIST_FILENAME) as f:
+        content = f.read()
+    playlist = m3u8.loads(content, uri="http://example.com/path/index.m3u8")
+    restored = m3u8.loadb(m3u8.dumpb(playlist))
+
+    assert isinstance(restored, m3u8.M3U8)
+    assert restored.dumps() == playlist.dumps()
+    assert restored.base_uri == "http://example.com/path/"
+    assert restored.fingerprint == playlist.fingerprint
+    assert restored.segments[1].absolute_uri == playlist.segments[1].absolute_uri
+
+
+def test_loadb_rejects_other_data():
+    snapshot = m3u8.dumpb(m3u8.parse(playlists.SIMPLE_PLAYLIST))
+    with pytest.raises(m3u8.SnapshotError):
+        m3u8.loadb(b"#EXTM3U\n")
+    with pytest.raises(m3u8.SnapshotError):
+        m3u8.loadb(snapshot[:40])
+
+
+def test_dumpb_rejects_unsupported_values():
+    data = m3u8.parse(playlists.SIMPLE_PLAYLIST)
+    data["segments"][0]["custom"] = object()
+    with pytest.raises(TypeError):
+        m3u8.dumpb(data)
@@ -0,0 +1,153 @@
+# Copyright (c) 2026 Wurl.
+# Use of this source code is governed by a MIT License
+# license that can be found in the LICENSE file.
+
+import playlists
+import pytest
+
+import openm3u8 as m3u8
+import openm3u8.tail
+
+
+def _uri_segments(data):
+    return [s for s in data["segments"] if "uri" in s]
+
+
+@pytest.mark.parametrize(
+    "content",
+    [
+        playlists.SIMPLE_PLAYLIST_WITH_PROGRAM_DATE_TIME,
+        playlists.DISCONTINUITY_PLAYLIST_WITH_PROGRAM_DATE_TIME,
+        playlists.PLAYLIST_WITH_ENCRYPTED_SEGMENTS_AND_IV,
+        playlists.CUE_OUT_ELEMENTAL_PLAYLIST,
+        playlists.LOW_LATENCY_PART_PLAYLIST,
+        playlists.MAP_URI_PLAYLIST_WITH_BYTERANGE,
+    ],
+)
+def test_parse_tail_matches_end_of_full_parse(content):
+    full = m3u8.parse(content)
+    count = len(_uri_segments(full))
+    for n in (1, 2):
+        tail = m3u8.parse_tail(content, n)
+        assert tail["segments"] == full["segments"][count - n :]
+        assert tail["media_sequence"] == full["media_sequence"] + count - n
+        assert tail["targetduration"] == full["targetduration"]
+        assert tail.get("program_date_time") == full.get("program_date_time")
+        assert tail["is_endlist"] == full["is_endlist"]
+
+
+def test_parse_tail_keeps_inherited_key_and_state():
+    content = "\n".join(
+        [
+            "#EXTM3U",
+            "#EXT-X-TARGETDURATION:6",
+            "#EXT-X-MEDIA-SEQUENCE:100",
+            "#EXT-X-DISCONTINUITY-SEQUENCE:7",
+            '#EXT-X-KEY:METHOD=AES-128,URI="k1"',
+            "#EXTINF:6,",
+            "a.ts",
+            "#EXT-X-DISCONTINUITY",
+            '#EXT-X-KEY:METHOD=AES-128,URI="k2"',
+            "#EXTINF:6,",
+            "b.ts",
+            "#EXTINF:6,",
+            "c.ts",
+            "JUNK",
+            "#EXTINF:6,",
+            "d.ts",
+        ]
+    )
+    tail = m3u8.parse_tail(content, 2)
+    assert [s["uri"] for s in tail["segments"]] == ["c.ts", "d.ts"]
+    assert tail["segments"][0]["key"]["uri"] == "k2"
+    assert tail["media_sequence"] == 102
+    assert tail["discontinuity_sequence"] == 8
+
+    assert m3u8.parse_tail(content, 10) == m3u8.parse(content)
+    assert m3u8.parse_tail(playlists.VARIANT_PLAYLIST, 1) == m3u8.parse(
+        playlists.VARIANT_PLAYLIST
+    )
+    with pytest.raises(ValueError):
+        m3u8.parse_tail(content, 0)
+
+
+def test_parse_tail_renumbers_ad_breaks():
+    content = playlists.CUE_OUT_ELEMENTAL_PLAYLIST
+    (ad_break,) = m3u8.parse(content)["ad_breaks"]
+    assert (ad_break["start_segment"], ad_break["end_segment"]) == (3, 8)
+
+    (ad_break,) = m3u8.parse_tail(content, 4)["ad_breaks"]
+    assert (ad_break["start_segment"], ad_break["end_segment"]) == (0, 1)
+    assert ad_break["duration"] == pytest.approx(50.0)
+    assert ad_break["complete"]
+    assert m3u8.parse_tail(content, 2)["ad_breaks"] == []
+
+
+def test_parse_tail_only_parses_the_tail(monkeypatch):
+    lines = [
+        "#EXTM3U",
+        "#EXT-X-TARGETDURATION:6",
+        "#EXT-X-PROGRAM-DATE-TIME:2026-01-01T00:00:00Z",
+        "#EXT-X-CUE-OUT:DURATION=3600",
+    ]
+    for i in range(2000):
+        lines += ["#EXTINF:6.006,", f"s{i}.ts"]
+    content = "\n".join(lines)
+    full = m3u8.parse(content)
+
+    parsed = []
+    parse = openm3u8.tail.parse
+
+    def counting_parse(text, *args):
+        parsed.append(sum(1 for line in text.splitlines() if line))
+        return parse(text, *args)
+
+    monkeypatch.setattr(openm3u8.tail, "parse", counting_parse)
+    tail = m3u8.parse_tail(content, 3)
+    assert max(parsed) < 20
+
+    assert tail["segments"] == full["segments"][-3:]
+    (ad_break,) = tail["ad_breaks"]
+    (expected,) = full["ad_breaks"]
+    assert (ad_break["start_segment"], ad_break["end_segment"]) == (0, 2)
+    assert ad_break["duration"] == expected["duration"]
+    assert ad_break["program_date_time"] == expected["program_date_time"]
+    assert ad_break["planned_duration"] == 3600
+
+
+def test_parse_tail_counts_discontinuities_without_sequence_tag():
+    content = "\n".join(
+        [
+            "#EXTM3U",
+            "#EXT-X-TARGETDURATION:6",
+            "#EXTINF:6,",
+            "a.ts",
+            "#EXT-X-DISCONTINUITY",
+            "#EXTINF:6,",
+            "b.ts",
+            "#EXTINF:6,",
+            "c.ts",
+        ]
+    )
+    assert "discontinuity_sequence" not in m3u8.parse(content)
+    assert m3u8.parse_tail(content, 1)["discontinuity_sequence"] == 1
+    assert "discontinuity_sequence" not in m3u8.parse_tail(content, 2)
+
+
+def test_parse_tail_reports_playlist_line_numbers():
+    content = playlists.CUE_OUT_ELEMENTAL_PLAYLIST
+
+    def recorder(seen):
+        def parser(line, lineno, data, state):
+            seen.append((lineno, line))
+            return False
+
+        return parser
+
+    full = []
+    m3u8.parse(content, custom_tags_parser=recorder(full))
+    tail = []
+    m3u8.parse_tail(content, 2, custom_tags_parser=recorder(tail))
+    assert tail
+    assert set(tail) <= set(full)
+    assert tail[-1] == full[-1]
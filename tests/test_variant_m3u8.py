@@ -449,3 +449,66 @@ CODECS="jpeg",URI="thumbnails-sd.m3u8"
 CODECS="jpeg",URI="thumbnails-hd.m3u8"
 """
     assert expected_content == variant_m3u8.dumps()
+
+
+ABR_LADDER_PLAYLIST = """#EXTM3U
+#EXT-X-STREAM-INF:BANDWIDTH=6000000,AVERAGE-BANDWIDTH=5000000,RESOLUTION=1920x1080,\
+FRAME-RATE=60,CODECS="hvc1.2.4.L123,mp4a.40.2",VIDEO-RANGE=PQ,HDCP-LEVEL=TYPE-1
+hevc-1080p.m3u8
+#EXT-X-STREAM-INF:BANDWIDTH=5000000,AVERAGE-BANDWIDTH=4200000,RESOLUTION=1920x1080,\
+FRAME-RATE=30,CODECS="avc1.640028,mp4a.40.2",HDCP-LEVEL=TYPE-0
+avc-1080p.m3u8
+#EXT-X-STREAM-INF:BANDWIDTH=800000,RESOLUTION=640x360,CODECS="avc1.4d401e,mp4a.40.2"
+avc-360p.m3u8
+#EXT-X-STREAM-INF:BANDWIDTH=2500000,AVERAGE-BANDWIDTH=2000000,RESOLUTION=1280x720,\
+FRAME-RATE=30,CODECS="avc1.4d401f,mp4a.40.2"
+avc-720p.m3u8
+#EXT-X-STREAM-INF:BANDWIDTH=2400000,RESOLUTION=1280x720,CODECS="avc1.4d401f,mp4a.40.2",\
+PATHWAY-ID="CDN-B"
+backup-720p.m3u8
+"""
+
+
+def test_variant_selection_respects_bandwidth_and_constraints():
+    variants = m3u8.loads(ABR_LADDER_PLAYLIST).playlists
+
+    assert variants.select().uri == "hevc-1080p.m3u8"
+    assert variants.select(max_bandwidth=5500000).uri == "avc-1080p.m3u8"
+    assert variants.select(max_bandwidth=2450000).uri == "backup-720p.m3u8"
+    assert variants.select(max_bandwidth=100000) is None
+
+    assert variants.select(codecs={"avc1", "mp4a"}).uri == "avc-1080p.m3u8"
+    assert variants.select(max_resolution=(1280, 720)).uri == "avc-720p.m3u8"
+    assert variants.select(max_frame_rate=30).uri == "avc-1080p.m3u8"
+    assert variants.select(video_range="SDR").uri == "avc-1080p.m3u8"
+    assert variants.select(hdcp_level="NONE").uri == "avc-720p.m3u8"
+    assert variants.select(pathway_id="CDN-B").uri == "backup-720p.m3u8"
+    assert (
+        variants.select(max_bandwidth=2200000, pathway_id=m3u8.DEFAULT_PATHWAY_ID).uri
+        == "avc-360p.m3u8"
+    )
+    assert variants.select(max_bandwidth=2200000, average=True).uri == "avc-720p.m3u8"
+
+
+def test_variant_ladder_and_index_follow_list_changes():
+    variant_m3u8 = m3u8.loads(ABR_LADDER_PLAYLIST)
+    variants = variant_m3u8.playlists
+
+    assert [p.uri for p in variants.ladder(hdcp_level="TYPE-0", codecs="avc1")] == []
+    assert [p.uri for p in variants.ladder(pathway_id=".", video_range="SDR")] == [
+        "avc-360p.m3u8",
+        "avc-720p.m3u8",
+        "avc-1080p.m3u8",
+    ]
+
+    variant_m3u8.add_playlist(
+        m3u8.Playlist(
+            "avc-480p.m3u8",
+            stream_info={"bandwidth": 1200000, "resolution": "854x480"},
+            media=[],
+            base_uri=None,
+        )
+    )
+    assert variants.select(max_bandwidth=2000000).uri == "avc-480p.m3u8"
+    del variants[-1]
+    assert variants.select(max_bandwidth=2000000).uri == "avc-360p.m3u8"